@@ -44,6 +44,7 @@
 
 #include "pppClient.h"
 #include "pppUtils.h"
+#include "pppSatCache.h"
 #include "bncephuser.h"
 #include "bncutils.h"
 
@@ -383,12 +384,13 @@ void t_pppClient::putEphemeris(const t_eph* eph) {
 t_irc t_pppClient::getSatPos(const bncTime& tt, const QString& prn,
                               ColumnVector& xc, ColumnVector& vv) {
 
+  t_pppSatCache* satCache = t_pppSatCache::instance();
   t_eph* eLast = _ephUser->ephLast(prn);
   t_eph* ePrev = _ephUser->ephPrev(prn);
-  if      (eLast && eLast->getCrd(tt, xc, vv, _opt->useOrbClkCorr()) == success) {
+  if      (eLast && satCache->getCrd(eLast, tt, _opt->useOrbClkCorr(), xc, vv) == success) {
     return success;
   }
-  else if (ePrev && ePrev->getCrd(tt, xc, vv, _opt->useOrbClkCorr()) == success) {
+  else if (ePrev && satCache->getCrd(ePrev, tt, _opt->useOrbClkCorr(), xc, vv) == success) {
     return success;
   }
   return failure;
@@ -40,6 +40,7 @@
 
 #include <iomanip>
 #include <cmath>
+#include <cstring>
 #include <sstream>
 #include <newmatio.h>
 #include <newmatap.h>
@@ -163,8 +164,9 @@ double t_pppParam::partial(t_satData* satData, bool phase) {
 ////////////////////////////////////////////////////////////////////////////
 t_pppFilter::t_pppFilter(t_pppClient* pppClient) {
 
-  _pppClient = pppClient;
-  _tides     = new t_tides();
+  _pppClient   = pppClient;
+  _tides       = new t_tides();
+  _numStatePar = 0;
 
   // Antenna Name, ANTEX File
   // ------------------------
@@ -262,6 +264,75 @@ void t_pppFilter::reset() {
       _QQ(iPar,iPar) = 1000.0 * 1000.0;
     }
   }
+
+  indexParams();
+}
+
+// Parameter Indices, Ambiguity Lookup Table
+////////////////////////////////////////////////////////////////////////////
+void t_pppFilter::indexParams() {
+
+  _numStatePar = 0;
+  _ambParams.clear();
+  for (int iPar = 1; iPar <= _params.size(); iPar++) {
+    t_pppParam* par = _params[iPar-1];
+    par->index     = iPar;
+    par->index_old = iPar;
+    if (par->type == t_pppParam::AMB_L3) {
+      _ambParams[par->prn] = par;
+    }
+    else {
+      ++_numStatePar;
+    }
+  }
+}
+
+// Remove Rows/Columns of deleted Parameters, append new Ambiguities
+////////////////////////////////////////////////////////////////////////////
+void t_pppFilter::reshuffleQQ() {
+
+  Tracer tracer("t_pppFilter::reshuffleQQ");
+
+  // Retained parameters keep their order, new ones are appended
+  // -----------------------------------------------------------
+  int  nPar     = _params.size();
+  int  nKeep    = 0;
+  bool prefixOK = true;
+  while (nKeep < nPar && _params[nKeep]->index_old != 0) {
+    if (_params[nKeep]->index_old != nKeep+1) {
+      prefixOK = false;
+    }
+    ++nKeep;
+  }
+
+  // Copy the packed lower triangle (row-wise storage)
+  // -------------------------------------------------
+  SymmetricMatrix QQ(nPar);
+  const double*   oldStore = _QQ.data();
+  double*         newStore = QQ.data();
+  if (prefixOK) {
+    memcpy(newStore, oldStore, (nKeep * (nKeep+1) / 2) * sizeof(double));
+  }
+  else {
+    double* dst = newStore;
+    for (int i1 = 0; i1 < nKeep; i1++) {
+      int io1 = _params[i1]->index_old;
+      const double* rowOld = oldStore + (io1-1) * io1 / 2;
+      for (int i2 = 0; i2 <= i1; i2++) {
+        *dst++ = rowOld[_params[i2]->index_old - 1];
+      }
+    }
+  }
+
+  // New ambiguities are uncorrelated
+  // --------------------------------
+  for (int i1 = nKeep; i1 < nPar; i1++) {
+    double* row = newStore + i1 * (i1+1) / 2;
+    memset(row, 0, i1 * sizeof(double));
+    row[i1] = OPT->_aprSigAmb * OPT->_aprSigAmb;
+  }
+
+  _QQ.swap(QQ);
 }
 
 // Bancroft Solution
@@ -546,32 +617,18 @@ void t_pppFilter::predict(int iPhase, t_epoData* epoData) {
   if (OPT->ambLCs('G').size() || OPT->ambLCs('R').size() ||
       OPT->ambLCs('E').size() || OPT->ambLCs('C').size()) {
 
-    // Make a copy of QQ and xx, set parameter indices
-    // -----------------------------------------------
-    SymmetricMatrix QQ_old = _QQ;
-
-    for (int iPar = 1; iPar <= _params.size(); iPar++) {
-      _params[iPar-1]->index_old = _params[iPar-1]->index;
-      _params[iPar-1]->index     = 0;
-    }
-
     // Remove Ambiguity Parameters without observations
     // ------------------------------------------------
-    int iPar = 0;
+    bool changed = false;
     QMutableVectorIterator<t_pppParam*> im(_params);
     while (im.hasNext()) {
       t_pppParam* par = im.next();
-      bool removed = false;
-      if (par->type == t_pppParam::AMB_L3) {
-        if (epoData->satData.find(par->prn) == epoData->satData.end()) {
-          removed = true;
-          delete par;
-          im.remove();
-        }
-      }
-      if (! removed) {
-        ++iPar;
-        par->index = iPar;
+      if (par->type == t_pppParam::AMB_L3 &&
+          epoData->satData.find(par->prn) == epoData->satData.end()) {
+        _ambParams.remove(par->prn);
+        delete par;
+        im.remove();
+        changed = true;
       }
     }
 
@@ -581,30 +638,16 @@ void t_pppFilter::predict(int iPhase, t_epoData* epoData) {
     while (it.hasNext()) {
       it.next();
       t_satData* satData = it.value();
-      addAmb(satData);
-    }
-
-    int nPar = _params.size();
-    _QQ.ReSize(nPar); _QQ = 0.0;
-    for (int i1 = 1; i1 <= nPar; i1++) {
-      t_pppParam* p1 = _params[i1-1];
-      if (p1->index_old != 0) {
-        _QQ(p1->index, p1->index) = QQ_old(p1->index_old, p1->index_old);
-        for (int i2 = 1; i2 <= nPar; i2++) {
-          t_pppParam* p2 = _params[i2-1];
-          if (p2->index_old != 0) {
-            _QQ(p1->index, p2->index) = QQ_old(p1->index_old, p2->index_old);
-          }
-        }
+      if (addAmb(satData)) {
+        changed = true;
       }
     }
 
-    for (int ii = 1; ii <= nPar; ii++) {
-      t_pppParam* par = _params[ii-1];
-      if (par->index_old == 0) {
-        _QQ(par->index, par->index) = OPT->_aprSigAmb * OPT->_aprSigAmb;
-      }
-      par->index_old = par->index;
+    // Variance-covariance matrix is touched only if the set changed
+    // -------------------------------------------------------------
+    if (changed) {
+      reshuffleQQ();
+      indexParams();
     }
   }
 }
@@ -874,25 +917,20 @@ void t_pppFilter::cmpEle(t_satData* satData) {
 
 //
 ///////////////////////////////////////////////////////////////////////////
-void t_pppFilter::addAmb(t_satData* satData) {
+bool t_pppFilter::addAmb(t_satData* satData) {
   Tracer tracer("t_pppFilter::addAmb");
   if (!OPT->ambLCs(satData->system()).size()){
-    return;
+    return false;
   }
-  bool    found = false;
-  for (int iPar = 1; iPar <= _params.size(); iPar++) {
-    if (_params[iPar-1]->type == t_pppParam::AMB_L3 &&
-        _params[iPar-1]->prn == satData->prn) {
-      found = true;
-      break;
-    }
-  }
-  if (!found) {
-    t_pppParam* par = new t_pppParam(t_pppParam::AMB_L3,
-                                 _params.size()+1, satData->prn);
-    _params.push_back(par);
-    par->xx = satData->L3 - cmpValue(satData, true);
+  if (ambParam(satData->prn)) {
+    return false;
   }
+  t_pppParam* par = new t_pppParam(t_pppParam::AMB_L3,
+                               _params.size()+1, satData->prn);
+  _params.push_back(par);
+  _ambParams[satData->prn] = par;
+  par->xx = satData->L3 - cmpValue(satData, true);
+  return true;
 }
 
 //
@@ -927,13 +965,15 @@ void t_pppFilter::addObs(int iPhase, unsigned& iObs, t_satData* satData,
       sigL3 *= BDS_WEIGHT_FACTOR;
     }
     PP(iObs,iObs) = 1.0 / (sigL3 * sigL3) / (ellWgtCoef * ellWgtCoef);
-    for (int iPar = 1; iPar <= _params.size(); iPar++) {
-      if (_params[iPar-1]->type == t_pppParam::AMB_L3 &&
-          _params[iPar-1]->prn  == satData->prn) {
-        ll(iObs) -= _params[iPar-1]->xx;
-      }
+    AA.Row(iObs) = 0.0;
+    for (int iPar = 1; iPar <= _numStatePar; iPar++) {
       AA(iObs, iPar) = _params[iPar-1]->partial(satData, true);
     }
+    t_pppParam* amb = ambParam(satData->prn);
+    if (amb) {
+      ll(iObs) -= amb->xx;
+      AA(iObs, amb->index) = 1.0;
+    }
   }
 
   // Code Observations
@@ -942,7 +982,8 @@ void t_pppFilter::addObs(int iPhase, unsigned& iObs, t_satData* satData,
     double sigP3 = 2.98 * OPT->_sigmaC1;
     ll(iObs)      = satData->P3 - cmpValue(satData, false);
     PP(iObs,iObs) = 1.0 / (sigP3 * sigP3) / (ellWgtCoef * ellWgtCoef);
-    for (int iPar = 1; iPar <= _params.size(); iPar++) {
+    AA.Row(iObs) = 0.0;
+    for (int iPar = 1; iPar <= _numStatePar; iPar++) {
       AA(iObs, iPar) = _params[iPar-1]->partial(satData, false);
     }
   }
@@ -1201,6 +1242,7 @@ void t_pppFilter::restoreState(t_epoData* epoData) {
     t_pppParam* par = itSav.next();
     _params.push_back(new t_pppParam(*par));
   }
+  indexParams();
 
   epoData->deepCopy(_epoData_sav);
 }
@@ -26,6 +26,7 @@
 #define PPPFILTER_H
 
 #include <QByteArray>
+#include <QHash>
 #include <QMap>
 #include <QStringList>
 #include <QVector>
@@ -221,7 +222,7 @@ class t_pppFilter {
   void   reset();
   t_irc  cmpBancroft(t_epoData* epoData);
   void   cmpEle(t_satData* satData);
-  void   addAmb(t_satData* satData);
+  bool   addAmb(t_satData* satData);
   void   addObs(int iPhase, unsigned& iObs, t_satData* satData,
                 Matrix& AA, ColumnVector& ll, DiagonalMatrix& PP);
   QByteArray printRes(int iPhase, const ColumnVector& vv,
@@ -233,6 +234,11 @@ class t_pppFilter {
   double cmpValue(t_satData* satData, bool phase);
   double delay_saast(double Ele);
   void   predict(int iPhase, t_epoData* epoData);
+  void   indexParams();
+  void   reshuffleQQ();
+  t_pppParam* ambParam(const QString& prn) const {
+    return _ambParams.value(prn, 0);
+  }
   t_irc  update_p(t_epoData* epoData);
   QString outlierDetection(int iPhase, const ColumnVector& vv,
                            QMap<QString, t_satData*>& satData);
@@ -255,7 +261,9 @@ class t_pppFilter {
   t_pppClient*          _pppClient;
   bncTime               _time;
   bncTime               _lastTimeOK;
-  QVector<t_pppParam*>  _params;
+  QVector<t_pppParam*>  _params;       // state block first, then ambiguities
+  int                   _numStatePar;  // number of non-ambiguity parameters
+  QHash<QString, t_pppParam*> _ambParams;
   SymmetricMatrix       _QQ;
   QVector<t_pppParam*>  _params_sav;
   SymmetricMatrix       _QQ_sav;
@@ -0,0 +1,200 @@
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      t_pppSatCache
+ *
+ * Purpose:    Satellite positions, velocities and clocks (broadcast plus
+ *             SSR corrections) computed once per epoch and shared
+ *             read-only between all PPP clients
+ *
+ * Author:     BKG
+ *
+ * Created:    18-Oct-2026
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include <cmath>
+
+#include "pppSatCache.h"
+#include "ephemeris.h"
+#include "satObs.h"
+
+using namespace BNC_PPP;
+using namespace std;
+
+// Key Constructor
+////////////////////////////////////////////////////////////////////////////
+t_pppSatCache::t_key::t_key(const t_eph* eph, const bncTime& tt, bool useCorr) {
+  _prn         = eph->prn().toInt();
+  _flags       = eph->prn().flags();
+  _ttNs        = nanoSec(tt);
+  _tocNs       = nanoSec(eph->TOC());
+  _iod         = eph->IOD();
+  _useCorr     = useCorr;
+  _orbNs       = 0;
+  _orbIod      = 0;
+  _orbXr[0]    = 0.0;
+  _orbXr[1]    = 0.0;
+  _orbXr[2]    = 0.0;
+  _orbDotXr[0] = 0.0;
+  _orbDotXr[1] = 0.0;
+  _orbDotXr[2] = 0.0;
+  _clkNs       = 0;
+  _dClk        = 0.0;
+  _dotDClk     = 0.0;
+  _dotDotDClk  = 0.0;
+  if (useCorr) {
+    const t_orbCorr* orbCorr = eph->orbCorr();
+    const t_clkCorr* clkCorr = eph->clkCorr();
+    if (orbCorr) {
+      _orbNs       = nanoSec(orbCorr->_time);
+      _orbIod      = orbCorr->_iod;
+      _orbXr[0]    = orbCorr->_xr[0];
+      _orbXr[1]    = orbCorr->_xr[1];
+      _orbXr[2]    = orbCorr->_xr[2];
+      _orbDotXr[0] = orbCorr->_dotXr[0];
+      _orbDotXr[1] = orbCorr->_dotXr[1];
+      _orbDotXr[2] = orbCorr->_dotXr[2];
+    }
+    if (clkCorr) {
+      _clkNs       = nanoSec(clkCorr->_time);
+      _dClk        = clkCorr->_dClk;
+      _dotDClk     = clkCorr->_dotDClk;
+      _dotDotDClk  = clkCorr->_dotDotDClk;
+    }
+  }
+}
+
+// Key Comparison
+////////////////////////////////////////////////////////////////////////////
+bool t_pppSatCache::t_key::operator==(const t_key& key2) const {
+  return _ttNs        == key2._ttNs        && _prn         == key2._prn         &&
+         _flags       == key2._flags       && _tocNs       == key2._tocNs       &&
+         _iod         == key2._iod         && _useCorr     == key2._useCorr     &&
+         _orbNs       == key2._orbNs       && _orbIod      == key2._orbIod      &&
+         _orbXr[0]    == key2._orbXr[0]    && _orbXr[1]    == key2._orbXr[1]    &&
+         _orbXr[2]    == key2._orbXr[2]    && _orbDotXr[0] == key2._orbDotXr[0] &&
+         _orbDotXr[1] == key2._orbDotXr[1] && _orbDotXr[2] == key2._orbDotXr[2] &&
+         _clkNs       == key2._clkNs       && _dClk        == key2._dClk        &&
+         _dotDClk     == key2._dotDClk     && _dotDotDClk  == key2._dotDotDClk;
+}
+
+// Key Hash
+////////////////////////////////////////////////////////////////////////////
+uint BNC_PPP::qHash(const t_pppSatCache::t_key& key) {
+  uint hash = ::qHash(key._ttNs) ^ (::qHash(key._prn) << 8) ^ ::qHash(key._tocNs) ^ key._iod;
+  if (key._useCorr) {
+    hash ^= ::qHash(key._orbNs) ^ (::qHash(key._clkNs) << 1) ^ (key._orbIod << 16);
+  }
+  return hash;
+}
+
+// Shared Instance
+////////////////////////////////////////////////////////////////////////////
+t_pppSatCache* t_pppSatCache::instance() {
+  static t_pppSatCache _pppSatCache;
+  return &_pppSatCache;
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+t_pppSatCache::t_pppSatCache() {
+  _numHits   = 0;
+  _numMisses = 0;
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+t_pppSatCache::~t_pppSatCache() {
+}
+
+// Time in Nanoseconds
+////////////////////////////////////////////////////////////////////////////
+qint64 t_pppSatCache::nanoSec(const bncTime& tt) {
+  return qint64(tt.mjd()) * 86400000000000LL + qint64(llround(tt.daysec() * 1.e9));
+}
+
+// Satellite Position, Velocity and Clock
+////////////////////////////////////////////////////////////////////////////
+t_irc t_pppSatCache::getCrd(const t_eph* eph, const bncTime& tt, bool useCorr,
+                            ColumnVector& xc, ColumnVector& vv) {
+
+  if (eph->checkState() == t_eph::bad) {
+    return failure;
+  }
+
+  t_key  key(eph, tt, useCorr);
+  qint64 bucket = key._ttNs / 1000000000LL;
+
+  // Look for an already computed value
+  // ----------------------------------
+  {
+    QReadLocker locker(&_lock);
+    QMap<qint64, QHash<t_key, t_entry> >::const_iterator itB = _buckets.constFind(bucket);
+    if (itB != _buckets.constEnd()) {
+      QHash<t_key, t_entry>::const_iterator it = itB.value().constFind(key);
+      if (it != itB.value().constEnd()) {
+        ++_numHits;
+        const t_entry& entry = it.value();
+        if (entry._irc == success) {
+          xc.ReSize(4);
+          vv.ReSize(3);
+          for (int ii = 0; ii < 4; ii++) xc[ii] = entry._xc[ii];
+          for (int ii = 0; ii < 3; ii++) vv[ii] = entry._vv[ii];
+        }
+        return entry._irc;
+      }
+    }
+  }
+
+  // Compute and store
+  // -----------------
+  ++_numMisses;
+  t_entry entry;
+  entry._irc = eph->getCrd(tt, xc, vv, useCorr);
+  if (entry._irc == success) {
+    for (int ii = 0; ii < 4; ii++) entry._xc[ii] = xc[ii];
+    for (int ii = 0; ii < 3; ii++) entry._vv[ii] = vv[ii];
+  }
+
+  QWriteLocker locker(&_lock);
+  bool newBucket = !_buckets.contains(bucket);
+  _buckets[bucket].insert(key, entry);
+
+  // Remove buckets too far away from the current one
+  // ------------------------------------------------
+  if (newBucket) {
+    QMutableMapIterator<qint64, QHash<t_key, t_entry> > itB(_buckets);
+    while (itB.hasNext()) {
+      itB.next();
+      if (itB.key() < bucket - _maxAge || itB.key() > bucket + _maxAge) {
+        itB.remove();
+      }
+    }
+  }
+
+  return entry._irc;
+}
+
+// Remove all Entries
+////////////////////////////////////////////////////////////////////////////
+void t_pppSatCache::clear() {
+  QWriteLocker locker(&_lock);
+  _buckets.clear();
+  _numHits   = 0;
+  _numMisses = 0;
+}
+
+// Hit Rate
+////////////////////////////////////////////////////////////////////////////
+double t_pppSatCache::hitRate() const {
+  quint64 numHits   = _numHits;
+  quint64 numLookup = numHits + _numMisses;
+  if (numLookup == 0) {
+    return 0.0;
+  }
+  return double(numHits) / double(numLookup);
+}
@@ -0,0 +1,76 @@
+#ifndef PPPSATCACHE_H
+#define PPPSATCACHE_H
+
+#include <atomic>
+#include <QtCore>
+#include <newmat.h>
+
+#include "bncconst.h"
+#include "bnctime.h"
+
+class t_eph;
+
+namespace BNC_PPP {
+
+// Satellite position, velocity and clock cache shared by all PPP clients.
+// Entries are keyed by PRN, nanosecond-quantized time and the identity of
+// the broadcast ephemeris and SSR corrections used to compute them.
+////////////////////////////////////////////////////////////////////////////
+class t_pppSatCache {
+ public:
+  class t_key {
+   public:
+    t_key(const t_eph* eph, const bncTime& tt, bool useCorr);
+    bool operator==(const t_key& key2) const;
+    int      _prn;
+    int      _flags;
+    qint64   _ttNs;
+    qint64   _tocNs;
+    unsigned _iod;
+    bool     _useCorr;
+    qint64   _orbNs;
+    unsigned _orbIod;
+    double   _orbXr[3];
+    double   _orbDotXr[3];
+    qint64   _clkNs;
+    double   _dClk;
+    double   _dotDClk;
+    double   _dotDotDClk;
+  };
+
+  static t_pppSatCache* instance();
+
+  t_irc getCrd(const t_eph* eph, const bncTime& tt, bool useCorr,
+               ColumnVector& xc, ColumnVector& vv);
+  void  clear();
+
+  quint64 numHits() const {return _numHits;}
+  quint64 numMisses() const {return _numMisses;}
+  double  hitRate() const;
+
+  static qint64 nanoSec(const bncTime& tt);
+
+ private:
+  class t_entry {
+   public:
+    t_irc  _irc;
+    double _xc[4];
+    double _vv[3];
+  };
+
+  t_pppSatCache();
+  ~t_pppSatCache();
+
+  static const qint64 _maxAge = 60; // buckets [s] kept around the newest one
+
+  QReadWriteLock                         _lock;
+  QMap<qint64, QHash<t_key, t_entry> >   _buckets;
+  std::atomic<quint64>                   _numHits;
+  std::atomic<quint64>                   _numMisses;
+};
+
+uint qHash(const t_pppSatCache::t_key& key);
+
+}
+
+#endif
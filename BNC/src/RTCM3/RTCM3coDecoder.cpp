@@ -47,6 +47,7 @@
 #include "bnccore.h"
 #include "bncsettings.h"
 #include "bnctime.h"
+#include "rinex/corrbinary.h"
 
 using namespace std;
 
@@ -67,7 +68,8 @@ RTCM3coDecoder::RTCM3coDecoder(const QString& staID) {
     }
     _fileNameSkl = path + staID;
   }
-  _out = 0;
+  _out    = 0;
+  _binary = (settings.value("corrFormat").toString() == "Binary");
 
   connect(this, SIGNAL(newOrbCorrections(QList<t_orbCorr>)),
           BNC_CORE, SLOT(slotNewOrbCorrections(QList<t_orbCorr>)));
@@ -134,7 +136,7 @@ void RTCM3coDecoder::reopen() {
 
     QString fileNameHlp = _fileNameSkl
       + QString("%1").arg(datTim.date().dayOfYear(), 3, 10, QChar('0'))
-      + hlpStr + datTim.toString(".yyC");
+      + hlpStr + datTim.toString(_binary ? ".yyB" : ".yyC");
 
     if (_fileName == fileNameHlp) {
       return;
@@ -144,11 +146,20 @@ void RTCM3coDecoder::reopen() {
     }
 
     delete _out;
-    if ( Qt::CheckState(settings.value("rnxAppend").toInt()) == Qt::Checked) {
-      _out = new ofstream( _fileName.toLatin1().data(), ios_base::out | ios_base::app );
+    ios_base::openmode mode = ios_base::out;
+    if (_binary) {
+      mode |= ios_base::binary;
+    }
+    bool append = Qt::CheckState(settings.value("rnxAppend").toInt()) == Qt::Checked &&
+                  QFileInfo(_fileName).size() > 0;
+    if (append) {
+      _out = new ofstream( _fileName.toLatin1().data(), mode | ios_base::app );
     }
     else {
-      _out = new ofstream( _fileName.toLatin1().data() );
+      _out = new ofstream( _fileName.toLatin1().data(), mode );
+    }
+    if (_binary && !append) {
+      t_corrBinary::writeFileHead(_out);
     }
   }
 }
@@ -490,7 +501,12 @@ void RTCM3coDecoder::sendResults() {
     itOrb.next();
     if (itOrb.key() < _lastTime) {
       emit newOrbCorrections(itOrb.value());
-      t_orbCorr::writeEpoch(_out, itOrb.value());
+      if (_binary) {
+        t_corrBinary::writeEpoch(_out, itOrb.value());
+      }
+      else {
+        t_orbCorr::writeEpoch(_out, itOrb.value());
+      }
       itOrb.remove();
     }
   }
@@ -499,7 +515,12 @@ void RTCM3coDecoder::sendResults() {
     itClk.next();
     if (itClk.key() < _lastTime) {
       emit newClkCorrections(itClk.value());
-      t_clkCorr::writeEpoch(_out, itClk.value());
+      if (_binary) {
+        t_corrBinary::writeEpoch(_out, itClk.value());
+      }
+      else {
+        t_clkCorr::writeEpoch(_out, itClk.value());
+      }
       itClk.remove();
     }
   }
@@ -508,7 +529,12 @@ void RTCM3coDecoder::sendResults() {
     itCB.next();
     if (itCB.key() < _lastTime) {
       emit newCodeBiases(itCB.value());
-      t_satCodeBias::writeEpoch(_out, itCB.value());
+      if (_binary) {
+        t_corrBinary::writeEpoch(_out, itCB.value());
+      }
+      else {
+        t_satCodeBias::writeEpoch(_out, itCB.value());
+      }
       itCB.remove();
     }
   }
@@ -517,7 +543,12 @@ void RTCM3coDecoder::sendResults() {
     itPB.next();
     if (itPB.key() < _lastTime) {
       emit newPhaseBiases(itPB.value());
-      t_satPhaseBias::writeEpoch(_out, itPB.value());
+      if (_binary) {
+        t_corrBinary::writeEpoch(_out, itPB.value());
+      }
+      else {
+        t_satPhaseBias::writeEpoch(_out, itPB.value());
+      }
       itPB.remove();
     }
   }
@@ -526,10 +557,18 @@ void RTCM3coDecoder::sendResults() {
     itTec.next();
     if (itTec.key() < _lastTime) {
       emit newTec(itTec.value());
-      t_vTec::write(_out, itTec.value());
+      if (_binary) {
+        t_corrBinary::writeEpoch(_out, itTec.value());
+      }
+      else {
+        t_vTec::write(_out, itTec.value());
+      }
       itTec.remove();
     }
   }
+  if (_binary && _out) {
+    _out->flush();
+  }
 }
 
 //
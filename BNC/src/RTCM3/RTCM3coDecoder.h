@@ -63,6 +63,7 @@ Q_OBJECT
   std::string codeTypeToRnxType(char system, CodeType type) const;
 
   std::ofstream*                        _out;
+  bool                                  _binary;   // t_corrBinary file format
   QString                               _staID;
   QString                               _fileNameSkl;
   QString                               _fileName;
@@ -0,0 +1,166 @@
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      bncAlertService
+ *
+ * Purpose:    Batched, non-blocking calls of the advisory script
+ *
+ * Author:     BKG
+ *
+ * Created:    18-Oct-2026
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include <QElapsedTimer>
+#include <QMap>
+#include <QProcess>
+#include <QStringList>
+
+#include "bncalertservice.h"
+#include "bnccore.h"
+
+// Shared Instance
+////////////////////////////////////////////////////////////////////////////
+bncAlertService* bncAlertService::instance() {
+  static bncAlertService _bncAlertService;
+  return &_bncAlertService;
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncAlertService::bncAlertService() {
+  _numDropped   = 0;
+  _numCancelled = 0;
+  _stop         = false;
+  connect(this, SIGNAL(newMessage(QByteArray,bool)),
+          BNC_CORE, SLOT(slotMessage(const QByteArray,bool)));
+  start();
+}
+
+// Destructor (pending events are still passed on)
+////////////////////////////////////////////////////////////////////////////
+bncAlertService::~bncAlertService() {
+  _mutex.lock();
+  _stop = true;
+  _waitCond.wakeAll();
+  _mutex.unlock();
+  wait();
+}
+
+// Queue an Event (does not block)
+////////////////////////////////////////////////////////////////////////////
+void bncAlertService::post(const QString& script, const QByteArray& staID,
+                           const QByteArray& comment) {
+  t_alert alert;
+  alert._script  = script;
+  alert._staID   = staID;
+  alert._comment = comment;
+
+  QByteArray event = alert.event();
+  QByteArray other;
+  if      (event.startsWith("Begin_")) {
+    other = "End_" + event.mid(6);
+  }
+  else if (event.startsWith("End_")) {
+    other = "Begin_" + event.mid(4);
+  }
+
+  QMutexLocker locker(&_mutex);
+
+  // Flapping: the opposite event of the same stream is still pending
+  // ----------------------------------------------------------------
+  for (int ii = _queue.size() - 1; ii >= 0; ii--) {
+    const t_alert& pending = _queue[ii];
+    if (pending._staID == staID && pending._script == script) {
+      if (!other.isEmpty() && pending.event() == other) {
+        _queue.removeAt(ii);
+        _numCancelled += 2;
+        return;
+      }
+      break;
+    }
+  }
+
+  if (_queue.size() >= _maxQueue) {
+    _queue.removeFirst();
+    ++_numDropped;
+  }
+  _queue.append(alert);
+  _waitCond.wakeOne();
+}
+
+// Thread: wait for events, collect them for a while, call the script
+////////////////////////////////////////////////////////////////////////////
+void bncAlertService::run() {
+
+  QMutexLocker locker(&_mutex);
+
+  while (true) {
+    while (_queue.isEmpty() && !_stop) {
+      _waitCond.wait(&_mutex);
+    }
+    if (_queue.isEmpty()) {
+      break;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    while (!_stop && timer.elapsed() < _batchDelay) {
+      _waitCond.wait(&_mutex, _batchDelay - timer.elapsed());
+    }
+
+    QList<t_alert> alerts = _queue;
+    int numDropped   = _numDropped;
+    int numCancelled = _numCancelled;
+    _queue.clear();
+    _numDropped   = 0;
+    _numCancelled = 0;
+
+    locker.unlock();
+    if (numDropped > 0) {
+      emit newMessage(QString("Advisory script: %1 event(s) dropped, queue full")
+                      .arg(numDropped).toLatin1(), true);
+    }
+    if (numCancelled > 0) {
+      emit newMessage(QString("Advisory script: %1 flapping event(s) not reported")
+                      .arg(numCancelled).toLatin1(), false);
+    }
+    dispatch(alerts);
+    locker.relock();
+  }
+}
+
+// Call the script(s); each call gets pairs of mountpoint and comment
+////////////////////////////////////////////////////////////////////////////
+void bncAlertService::dispatch(const QList<t_alert>& alerts) {
+
+  QMap<QString, QStringList> args;
+  QMap<QString, int>         numPairs;
+  for (int ii = 0; ii < alerts.size(); ii++) {
+    const t_alert& alert = alerts[ii];
+    args[alert._script] << alert._staID << alert._comment;
+    ++numPairs[alert._script];
+
+    bool last = true;
+    for (int jj = ii + 1; jj < alerts.size(); jj++) {
+      if (alerts[jj]._script == alert._script) {
+        last = false;
+        break;
+      }
+    }
+    if (!last && numPairs[alert._script] < _maxBatch) {
+      continue;
+    }
+
+#ifdef WIN32
+    QProcess::startDetached(alert._script, args[alert._script]);
+#else
+    QProcess::startDetached("nohup", QStringList() << alert._script << args[alert._script]);
+#endif
+    args.remove(alert._script);
+    numPairs.remove(alert._script);
+  }
+}
@@ -0,0 +1,52 @@
+#ifndef BNCALERTSERVICE_H
+#define BNCALERTSERVICE_H
+
+#include <QByteArray>
+#include <QList>
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+
+// Singleton Class
+// ---------------
+// Calls the advisory script in its own thread. Events are collected for a
+// short while: a begin and end of the same event of one stream cancel each
+// other, and the remaining events of all streams go to one script call.
+class bncAlertService : public QThread {
+ Q_OBJECT
+ public:
+  static bncAlertService* instance();
+  void post(const QString& script, const QByteArray& staID, const QByteArray& comment);
+
+ signals:
+  void newMessage(QByteArray msg, bool showOnScreen);
+
+ protected:
+  virtual void run();
+
+ private:
+  class t_alert {
+   public:
+    QString    _script;
+    QByteArray _staID;
+    QByteArray _comment;
+    QByteArray event() const {return _comment.left(_comment.indexOf(' '));}
+  };
+
+  bncAlertService();
+  ~bncAlertService();
+  void dispatch(const QList<t_alert>& alerts);
+
+  static const int _maxQueue   = 1000;
+  static const int _batchDelay = 5000; // [ms]
+  static const int _maxBatch   = 50;   // streams per script call
+
+  QMutex         _mutex;
+  QWaitCondition _waitCond;
+  QList<t_alert> _queue;
+  int            _numDropped;
+  int            _numCancelled;
+  bool           _stop;
+};
+
+#endif
@@ -126,6 +126,13 @@ bncCaster::~bncCaster() {
 
   QMutexLocker locker(&_mutex);
 
+  QMapIterator<QByteArray, QPair<QSharedPointer<bncRawBuffer>, int> > itMisc(_miscReaders);
+  while (itMisc.hasNext()) {
+    itMisc.next();
+    itMisc.value().first->removeReader(itMisc.value().second);
+  }
+  _miscReaders.clear();
+
   QListIterator<bncGetThread*> it(_threads);
   while(it.hasNext()){
     bncGetThread* thread = it.next();
@@ -253,8 +260,10 @@ void bncCaster::addGetThread(bncGetThread* getThread, bool noNewThread) {
   connect(getThread, SIGNAL(newObs(QByteArray, QList<t_satObs>)),
           this,      SIGNAL(newObs(QByteArray, QList<t_satObs>)));
 
-  connect(getThread, SIGNAL(newRawData(QByteArray, QByteArray)),
-          this,      SLOT(slotNewRawData(QByteArray, QByteArray)));
+  if (_miscSockets && (_miscMount == "ALL" || _miscMount == getThread->staID())) {
+    QSharedPointer<bncRawBuffer> rawBuffer = getThread->rawBuffer();
+    _miscReaders[getThread->staID()] = qMakePair(rawBuffer, rawBuffer->addReader(this));
+  }
 
   connect(getThread, SIGNAL(getThreadFinished(QByteArray)),
           this, SLOT(slotGetThreadFinished(QByteArray)));
@@ -283,6 +292,11 @@ void bncCaster::slotGetThreadFinished(QByteArray staID) {
     }
   }
 
+  if (_miscReaders.contains(staID)) {
+    QPair<QSharedPointer<bncRawBuffer>, int> reader = _miscReaders.take(staID);
+    reader.first->removeReader(reader.second);
+  }
+
   _staIDs.removeAll(staID);
   emit( newMessage(
            QString("Decoding %1 stream(s)").arg(_staIDs.size()).toLatin1(), true) );
@@ -531,17 +545,45 @@ void bncCaster::reopenOutFile() {
   }
 }
 
+// Raw data of a stream available (called in the thread of the stream)
+////////////////////////////////////////////////////////////////////////////
+void bncCaster::rawDataAvailable(const QByteArray& staID) {
+  QMetaObject::invokeMethod(this, "slotNewRawData", Qt::QueuedConnection,
+                            Q_ARG(QByteArray, staID));
+}
+
 // Output into the Miscellaneous socket
 ////////////////////////////////////////////////////////////////////////////
-void bncCaster::slotNewRawData(QByteArray staID, QByteArray data) {
-  if (_miscSockets && (_miscMount == "ALL" || _miscMount == staID)) {
+void bncCaster::slotNewRawData(QByteArray staID) {
+  if (_miscSockets && _miscReaders.contains(staID)) {
+    QPair<QSharedPointer<bncRawBuffer>, int> reader = _miscReaders.value(staID);
+    QList<bncRawBuffer::t_chunk> chunks;
+    qint64 lost = reader.first->read(reader.second, chunks);
+    if (lost > 0) {
+      emit newMessage(staID + ": Miscellaneous output too slow, "
+                      + QByteArray::number(lost) + " bytes skipped", true);
+    }
     QMutableListIterator<QTcpSocket*> is(*_miscSockets);
     while (is.hasNext()) {
       QTcpSocket* sock = is.next();
       if (sock->state() == QAbstractSocket::ConnectedState) {
-        sock->write(data);
+        // slow client: skip data rather than buffer without limit
+        if (sock->bytesToWrite() > _maxMiscBacklog) {
+          if (!_slowMiscSockets.contains(sock)) {
+            _slowMiscSockets.insert(sock);
+            emit newMessage(QString("Miscellaneous Output Port: client %1 too slow, "
+                                    "data skipped").arg(sock->peerAddress().toString())
+                            .toLatin1(), true);
+          }
+          continue;
+        }
+        _slowMiscSockets.remove(sock);
+        for (int ii = 0; ii < chunks.size(); ii++) {
+          sock->write(chunks[ii]._data);
+        }
       }
       else if (sock->state() != QAbstractSocket::ConnectingState) {
+        _slowMiscSockets.remove(sock);
         delete sock;
         is.remove();
       }
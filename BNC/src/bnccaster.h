@@ -27,14 +27,16 @@
 
 #include <QFile>
 #include <QMultiMap>
+#include <QSharedPointer>
 #include <QTcpServer>
 #include <QTcpSocket>
 
 #include "satObs.h"
+#include "bncrawbuffer.h"
 
 class bncGetThread;
 
-class bncCaster : public QObject {
+class bncCaster : public QObject, public bncRawReader {
  Q_OBJECT
 
  public:
@@ -43,10 +45,11 @@ class bncCaster : public QObject {
    void addGetThread(bncGetThread* getThread, bool noNewThread = false);
    int  numStations() const {return _staIDs.size();}
    void readMountPoints();
+   virtual void rawDataAvailable(const QByteArray& staID);
 
  public slots:
    void slotNewObs(QByteArray staID, QList<t_satObs> obsList);
-   void slotNewRawData(QByteArray staID, QByteArray data);
+   void slotNewRawData(QByteArray staID);
    void slotNewMiscConnection();
 
  signals:
@@ -66,6 +69,8 @@ class bncCaster : public QObject {
    static int myWrite(QTcpSocket* sock, const char* buf, int bufLen);
    void reopenOutFile();
 
+   static const qint64 _maxMiscBacklog = 4 * 1024 * 1024; // [bytes] per client
+
    QFile*                          _outFile;
    QTextStream*                    _out;
    QMap<bncTime, QList<t_satObs> > _epochs;
@@ -76,6 +81,8 @@ class bncCaster : public QObject {
    QList<QTcpSocket*>*             _uSockets;
    QList<QByteArray>               _staIDs;
    QList<bncGetThread*>            _threads;
+   QMap<QByteArray, QPair<QSharedPointer<bncRawBuffer>, int> > _miscReaders;
+   QSet<QTcpSocket*>               _slowMiscSockets;  // skipping data
    int                             _samplingRate;
    double                          _outWait;
    QMutex                          _mutex;
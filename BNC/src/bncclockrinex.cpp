@@ -42,6 +42,8 @@ bncClockRinex::~bncClockRinex() {
 t_irc bncClockRinex::write(int GPSweek, double GPSweeks, const QString& prn,
                            double sp3Clk) {
 
+  QMutexLocker locker(&_mutex);
+
   if (reopen(GPSweek, GPSweeks) == success) {
 
       QDateTime datTim = dateAndTimeFromGPSweek(GPSweek, GPSweeks);
@@ -50,7 +52,7 @@ t_irc bncClockRinex::write(int GPSweek, double GPSweeks, const QString& prn,
       _out << "AS " << prn.toLatin1().data()
            << datTim.toString("  yyyy MM dd hh mm").toLatin1().data()
            << fixed      << setw(10) << setprecision(6)  << sec
-           << "  1   "   << fortranFormat(sp3Clk, 19, 12).toLatin1().data() << endl;
+           << "  1   "   << fortranFormat(sp3Clk, 19, 12).toLatin1().data() << '\n';
 
     return success;
   }
@@ -42,6 +42,11 @@
 #include <sstream>
 #include <QMessageBox>
 #include <cmath>
+#ifdef WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 #include "bnccore.h"
 #include "bncutils.h"
@@ -85,6 +90,12 @@ t_bncCore::t_bncCore() : _ephUser(false) {
   _ephStreamGalileo = 0;
   _ephFileSBAS      = 0;
   _ephStreamSBAS    = 0;
+  _ephCommitTime    = 0;
+  _ephFsync         = false;
+  _ephPending       = false;
+
+  _ephCommitTimer = new QTimer(this);
+  connect(_ephCommitTimer, SIGNAL(timeout()), this, SLOT(slotCommitEph()));
 
   _portEph    = 0;
   _serverEph  = 0;
@@ -201,6 +212,18 @@ void t_bncCore::messagePrivate(const QByteArray& msg) {
 ////////////////////////////////////////////////////////////////////////////
 t_irc t_bncCore::checkPrintEph(t_eph* eph) {
   QMutexLocker locker(&_mutex);
+
+  // Same ephemeris already received from another stream
+  // ---------------------------------------------------
+  QString prn(eph->prn().toInternalString().c_str());
+  QList<t_ephSeen>& seen = _ephSeen[prn];
+  for (int ii = seen.size() - 1; ii >= 0; ii--) {
+    if (seen[ii]._IOD == eph->IOD() && seen[ii]._TOC == eph->TOC()) {
+      eph->setCheckState(seen[ii]._checkState);
+      return success;
+    }
+  }
+
   t_irc ircPut = _ephUser.putNewEph(eph, true);
   if      (eph->checkState() == t_eph::bad) {
     messagePrivate("WRONG EPHEMERIS\n" + eph->toString(3.0).toLatin1());
@@ -213,6 +236,16 @@ t_irc t_bncCore::checkPrintEph(t_eph* eph) {
   else if (eph->checkState() == t_eph::unhealthy) {
     messagePrivate("UNHEALTHY EPHEMERIS\n" + eph->toString(3.0).toLatin1());
   }
+  if (ircPut == success) {
+    t_ephSeen hlp;
+    hlp._IOD        = eph->IOD();
+    hlp._TOC        = eph->TOC();
+    hlp._checkState = eph->checkState();
+    seen.append(hlp);
+    if (seen.size() > _maxEphSeen) {
+      seen.removeFirst();
+    }
+  }
   printEphHeader();
   printEph(*eph, (ircPut == success));
   return success;
@@ -296,6 +329,18 @@ void t_bncCore::printEphHeader() {
       }
       expandEnvVar(_ephPath);
     }
+
+    // Ephemerides are committed like the other output files
+    // -----------------------------------------------------
+    _ephCommitTime = settings.value("outCommit").toInt();
+    if (_ephCommitTime < 0) {
+      _ephCommitTime = 0;
+    }
+    _ephFsync = (settings.value("outFsync").toString() == "commit");
+    if (_ephCommitTime > 0) {
+      QMetaObject::invokeMethod(_ephCommitTimer, "start", Qt::QueuedConnection,
+                                Q_ARG(int, _ephCommitTime));
+    }
   }
 
   // (Re-)Open output File(s)
@@ -468,35 +513,48 @@ void t_bncCore::printEphHeader() {
 ////////////////////////////////////////////////////////////////////////////
 void t_bncCore::printEph(const t_eph& eph, bool printFile) {
 
-  QString strV2 = eph.toString(defaultRnxNavVersion2);
-  QString strV3 = eph.toString(defaultRnxObsVersion3);
-
-  if     (_rinexVers == 2 && eph.type() == t_eph::GLONASS) {
-    printOutputEph(printFile, _ephStreamGlonass, strV2, strV3);
+  QTextStream* stream = 0;
+  if      (_rinexVers == 2 && eph.type() == t_eph::GLONASS) {
+    stream = _ephStreamGlonass;
   }
-  else if(_rinexVers == 2 && eph.type() == t_eph::GPS)  {
-    printOutputEph(printFile, _ephStreamGPS, strV2, strV3);
+  else if (_rinexVers == 2 && eph.type() == t_eph::GPS) {
+    stream = _ephStreamGPS;
   }
   else if (_rinexVers == 3) {
-    printOutputEph(printFile, _ephStreamGPS, strV2, strV3);
+    stream = _ephStreamGPS;
   }
+  else {
+    return;
+  }
+
+  // Only the versions needed, each formatted once
+  // ---------------------------------------------
+  bool toFile    = printFile && stream;
+  bool toSockets = _socketsEph && !_socketsEph->isEmpty();
+
+  QByteArray strV3;
+  if (toSockets || (toFile && _rinexVers == 3)) {
+    strV3 = eph.toString(defaultRnxObsVersion3).toLatin1();
+  }
+  QByteArray strFile;
+  if (toFile) {
+    strFile = (_rinexVers == 2) ? eph.toString(defaultRnxNavVersion2).toLatin1() : strV3;
+  }
+
+  printOutputEph(toFile ? stream : 0, strFile, strV3);
 }
 
 // Output
 ////////////////////////////////////////////////////////////////////////////
-void t_bncCore::printOutputEph(bool printFile, QTextStream* stream,
-                               const QString& strV2, const QString& strV3) {
+void t_bncCore::printOutputEph(QTextStream* stream, const QByteArray& strFile,
+                               const QByteArray& strV3) {
 
   // Output into file
   // ----------------
-  if (printFile && stream) {
-    if (_rinexVers == 2) {
-      *stream << strV2.toLatin1();
-    }
-    else {
-      *stream << strV3.toLatin1();
-    }
-    stream->flush();
+  if (stream) {
+    *stream << strFile;
+    _ephPending = true;
+    commitEph(false);
   }
 
   // Output into the socket
@@ -506,7 +564,7 @@ void t_bncCore::printOutputEph(bool printFile, QTextStream* stream,
     while (is.hasNext()) {
       QTcpSocket* sock = is.next();
       if (sock->state() == QAbstractSocket::ConnectedState) {
-        if (sock->write(strV3.toLatin1()) == -1) {
+        if (sock->write(strV3) == -1) {
           delete sock;
           is.remove();
         }
@@ -519,6 +577,45 @@ void t_bncCore::printOutputEph(bool printFile, QTextStream* stream,
   }
 }
 
+// Pass the buffered Ephemerides to the System (if forced or the time is due)
+////////////////////////////////////////////////////////////////////////////
+void t_bncCore::commitEph(bool force) {
+  if (!_ephPending) {
+    return;
+  }
+  if (!force && _ephCommitTime > 0 && _ephLastCommit.isValid() &&
+      _ephLastCommit.elapsed() < _ephCommitTime) {
+    return;
+  }
+  QList<QFile*> files;
+  if (_ephStreamGPS) {
+    _ephStreamGPS->flush();
+    files << _ephFileGPS;
+  }
+  if (_ephStreamGlonass && _ephStreamGlonass != _ephStreamGPS) {
+    _ephStreamGlonass->flush();
+    files << _ephFileGlonass;
+  }
+  if (_ephFsync) {
+    for (int ii = 0; ii < files.size(); ii++) {
+#ifdef WIN32
+      _commit(files[ii]->handle());
+#else
+      fsync(files[ii]->handle());
+#endif
+    }
+  }
+  _ephPending = false;
+  _ephLastCommit.start();
+}
+
+// Commit Ephemerides still pending (timer)
+////////////////////////////////////////////////////////////////////////////
+void t_bncCore::slotCommitEph() {
+  QMutexLocker locker(&_mutex);
+  commitEph(false);
+}
+
 // Set Port Number
 ////////////////////////////////////////////////////////////////////////////
 void t_bncCore::setPortEph(int port) {
@@ -570,128 +667,86 @@ void t_bncCore::slotQuit() {
   qApp->quit();
 }
 
-//
+// New Orbit Corrections. The correction slots are called through queued
+// connections and run in the thread of t_bncCore, like the sockets; the
+// lists are implicitly shared, consumers get them without copying.
 ////////////////////////////////////////////////////////////////////////////
 void t_bncCore::slotNewOrbCorrections(QList<t_orbCorr> orbCorrections) {
-  QMutexLocker locker(&_mutex);
   emit newOrbCorrections(orbCorrections);
-  if (_socketsCorr) {
+  if (corrClients()) {
     ostringstream out;
     t_orbCorr::writeEpoch(&out, orbCorrections);
-    QMutableListIterator<QTcpSocket*> is(*_socketsCorr);
-    while (is.hasNext()) {
-      QTcpSocket* sock = is.next();
-      if (sock->state() == QAbstractSocket::ConnectedState) {
-        if (sock->write(out.str().c_str()) == -1) {
-          delete sock;
-          is.remove();
-        }
-      }
-      else if (sock->state() != QAbstractSocket::ConnectingState) {
-        delete sock;
-        is.remove();
-      }
-    }
+    printOutputCorr(out.str());
   }
 }
 
 //
 ////////////////////////////////////////////////////////////////////////////
 void t_bncCore::slotNewClkCorrections(QList<t_clkCorr> clkCorrections) {
-  QMutexLocker locker(&_mutex);
   emit newClkCorrections(clkCorrections);
-  if (_socketsCorr) {
+  if (corrClients()) {
     ostringstream out;
     t_clkCorr::writeEpoch(&out, clkCorrections);
-    QMutableListIterator<QTcpSocket*> is(*_socketsCorr);
-    while (is.hasNext()) {
-      QTcpSocket* sock = is.next();
-      if (sock->state() == QAbstractSocket::ConnectedState) {
-        if (sock->write(out.str().c_str()) == -1) {
-          delete sock;
-          is.remove();
-        }
-      }
-      else if (sock->state() != QAbstractSocket::ConnectingState) {
-        delete sock;
-        is.remove();
-      }
-    }
+    printOutputCorr(out.str());
   }
 }
 
 //
 ////////////////////////////////////////////////////////////////////////////
 void t_bncCore::slotNewCodeBiases(QList<t_satCodeBias> codeBiases) {
-  QMutexLocker locker(&_mutex);
   emit newCodeBiases(codeBiases);
-  if (_socketsCorr) {
+  if (corrClients()) {
     ostringstream out;
     t_satCodeBias::writeEpoch(&out, codeBiases);
-    QMutableListIterator<QTcpSocket*> is(*_socketsCorr);
-    while (is.hasNext()) {
-      QTcpSocket* sock = is.next();
-      if (sock->state() == QAbstractSocket::ConnectedState) {
-        if (sock->write(out.str().c_str()) == -1) {
-          delete sock;
-          is.remove();
-        }
-      }
-      else if (sock->state() != QAbstractSocket::ConnectingState) {
-        delete sock;
-        is.remove();
-      }
-    }
+    printOutputCorr(out.str());
   }
 }
 
 //
 ////////////////////////////////////////////////////////////////////////////
 void t_bncCore::slotNewPhaseBiases(QList<t_satPhaseBias> phaseBiases) {
-  QMutexLocker locker(&_mutex);
   emit newPhaseBiases(phaseBiases);
-  if (_socketsCorr) {
+  if (corrClients()) {
     ostringstream out;
     t_satPhaseBias::writeEpoch(&out, phaseBiases);
-    QMutableListIterator<QTcpSocket*> is(*_socketsCorr);
-    while (is.hasNext()) {
-      QTcpSocket* sock = is.next();
-      if (sock->state() == QAbstractSocket::ConnectedState) {
-        if (sock->write(out.str().c_str()) == -1) {
-          delete sock;
-          is.remove();
-        }
-      }
-      else if (sock->state() != QAbstractSocket::ConnectingState) {
-        delete sock;
-        is.remove();
-      }
-    }
+    printOutputCorr(out.str());
   }
 }
 
 //
 ////////////////////////////////////////////////////////////////////////////
 void t_bncCore::slotNewTec(t_vTec vTec) {
-  QMutexLocker locker(&_mutex);
   emit newTec(vTec);
-  if (_socketsCorr) {
+  if (corrClients()) {
     ostringstream out;
     t_vTec::write(&out, vTec);
-    QMutableListIterator<QTcpSocket*> is(*_socketsCorr);
-    while (is.hasNext()) {
-      QTcpSocket* sock = is.next();
-      if (sock->state() == QAbstractSocket::ConnectedState) {
-        if (sock->write(out.str().c_str()) == -1) {
-          delete sock;
-          is.remove();
-        }
-      }
-      else if (sock->state() != QAbstractSocket::ConnectingState) {
+    printOutputCorr(out.str());
+  }
+}
+
+// Any Client on the Corrections Port
+////////////////////////////////////////////////////////////////////////////
+bool t_bncCore::corrClients() const {
+  return _socketsCorr && !_socketsCorr->isEmpty();
+}
+
+// Output of Corrections into the Sockets
+////////////////////////////////////////////////////////////////////////////
+void t_bncCore::printOutputCorr(const string& str) {
+  QByteArray data(str.data(), str.size());
+  QMutableListIterator<QTcpSocket*> is(*_socketsCorr);
+  while (is.hasNext()) {
+    QTcpSocket* sock = is.next();
+    if (sock->state() == QAbstractSocket::ConnectedState) {
+      if (sock->write(data) == -1) {
         delete sock;
         is.remove();
       }
     }
+    else if (sock->state() != QAbstractSocket::ConnectingState) {
+      delete sock;
+      is.remove();
+    }
   }
 }
 
@@ -113,15 +113,28 @@ friend class bncSettings;
  private slots:
   void slotNewConnectionEph();
   void slotNewConnectionCorr();
+  void slotCommitEph();
 
  private:
+  class t_ephSeen {
+   public:
+    unsigned int        _IOD;
+    bncTime             _TOC;
+    t_eph::e_checkState _checkState;
+  };
+
   t_irc checkPrintEph(t_eph* eph);
   void  printEphHeader();
   void  printEph(const t_eph& eph, bool printFile);
-  void  printOutputEph(bool printFile, QTextStream* stream,
-                       const QString& strV2, const QString& strV3);
+  void  printOutputEph(QTextStream* stream, const QByteArray& strFile,
+                       const QByteArray& strV3);
+  void  commitEph(bool force);
+  bool  corrClients() const;
+  void  printOutputCorr(const std::string& str);
   void  messagePrivate(const QByteArray& msg);
 
+  static const int _maxEphSeen = 4; // accepted ephemerides per satellite
+
   QSettings::SettingsMap _settings;
   QFile*                 _logFile;
   QTextStream*           _logStream;
@@ -139,6 +152,11 @@ friend class bncSettings;
   QTextStream*           _ephStreamGalileo;
   QFile*                 _ephFileSBAS;
   QTextStream*           _ephStreamSBAS;
+  int                    _ephCommitTime;   // [ms], 0 = each ephemeris
+  bool                   _ephFsync;
+  bool                   _ephPending;
+  QElapsedTimer          _ephLastCommit;
+  QTimer*                _ephCommitTimer;
   QString                _userName;
   QString                _pgmName;
   int                    _portEph;
@@ -159,6 +177,7 @@ friend class bncSettings;
   mutable QMutex         _mutexDateAndTimeGPS;
   BNC_PPP::t_pppMain*    _pppMain;
   bncEphUser             _ephUser;
+  QHash<QString, QList<t_ephSeen> > _ephSeen;
   qint64                 _pid;
   EWconn*                _earthworm;
   QString                _ewConfig;
@@ -48,6 +48,7 @@
 
 #include "bncfigure.h"
 #include "bncsettings.h"
+#include "bncstreamstats.h"
 
 using namespace std;
 
@@ -76,8 +77,6 @@ bncFigure::~bncFigure() {
 //
 ////////////////////////////////////////////////////////////////////////////
 void bncFigure::updateMountPoints() {
-  QMutexLocker locker(&_mutex);
-
   _counter = 0;
   _maxRate = 0;
 
@@ -95,25 +94,16 @@ void bncFigure::updateMountPoints() {
     if (hlp.size() <= 1) continue;
     QUrl        url(hlp[0]);
     QByteArray  staID = url.path().mid(1).toLatin1();
-    _bytes[staID] = new sumAndMean();
-  }
-}
-
-//
-////////////////////////////////////////////////////////////////////////////
-void bncFigure::slotNewData(const QByteArray staID, double nbyte) {
-  QMutexLocker locker(&_mutex);
-  QMap<QByteArray, sumAndMean*>::const_iterator it = _bytes.find(staID);
-  if (it != _bytes.end()) {
-    it.value()->_sum += nbyte*8.;
+    sumAndMean* sm = new sumAndMean();
+    sm->_counters  = bncStreamStats::instance()->counters(staID);
+    sm->_lastBytes = sm->_counters->bytes();
+    _bytes[staID] = sm;
   }
 }
 
 //
 ////////////////////////////////////////////////////////////////////////////
 void bncFigure::slotNextAnimationFrame() {
-  QMutexLocker locker(&_mutex);
-
   const static int MAXCOUNTER = 10;
 
   ++_counter;
@@ -125,8 +115,10 @@ void bncFigure::slotNextAnimationFrame() {
     QMapIterator<QByteArray, sumAndMean*> it(_bytes);
     while (it.hasNext()) {
       it.next();
-      it.value()->_mean = it.value()->_sum / _counter;
-      it.value()->_sum  = 0.0;
+      sumAndMean* sm = it.value();
+      quint64     nb = sm->_counters->bytes();
+      sm->_mean      = (nb - sm->_lastBytes) * 8.0 / _counter;
+      sm->_lastBytes = nb;
       if (it.value()->_mean > _maxRate) {
         _maxRate = it.value()->_mean;
       }
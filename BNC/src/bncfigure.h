@@ -27,17 +27,16 @@
 
 #include <QByteArray>
 #include <QMap>
-#include <QMutex>
 #include <QWidget>
 
+class bncStreamCounters;
+
 class bncFigure : public QWidget {
   Q_OBJECT
  public:
   bncFigure(QWidget *parent);
   ~bncFigure();
   void updateMountPoints();
- public slots:
-  void slotNewData(const QByteArray staID, double nbyte);
  protected:
   void paintEvent(QPaintEvent *event);
  private slots:
@@ -45,13 +44,13 @@ class bncFigure : public QWidget {
  private:
   class sumAndMean {
    public:
-    sumAndMean() {_mean = 0.0; _sum = 0.0;}
+    sumAndMean() {_mean = 0.0; _lastBytes = 0; _counters = 0;}
     ~sumAndMean() {}
-    double _mean;
-    double _sum;
+    double             _mean;
+    quint64            _lastBytes;
+    bncStreamCounters* _counters;
   };
   QMap<QByteArray, sumAndMean*> _bytes;
-  QMutex                        _mutex;
   int                           _counter;
   double                        _maxRate;
   int                           _ran[3][1001];
@@ -49,6 +49,7 @@
 
 #include "bncfigurelate.h" 
 #include "bncsettings.h"
+#include "bncstreamstats.h"
 
 using namespace std;
 
@@ -72,8 +73,6 @@ bncFigureLate::~bncFigureLate() {
 // 
 ////////////////////////////////////////////////////////////////////////////
 void bncFigureLate::updateMountPoints() {
-  QMutexLocker locker(&_mutex);
-
   _latency.clear();
 
   bncSettings settings;
@@ -83,23 +82,44 @@ void bncFigureLate::updateMountPoints() {
     if (hlp.size() <= 1) continue;
     QUrl        url(hlp[0]);
     QByteArray  staID = url.path().mid(1).toLatin1();
-    _latency[staID] = 0.0;
+    latency& lat = _latency[staID];
+    lat._counters = bncStreamStats::instance()->counters(staID);
+    lat._counters->latencyHistogram(lat._lastHist);
   }
 }
 
 // 
 ////////////////////////////////////////////////////////////////////////////
-void bncFigureLate::slotNewLatency(const QByteArray staID, double clate) {
-  QMutexLocker locker(&_mutex);
-  if (_latency.find(staID) != _latency.end()) {
-    _latency[staID] = fabs(clate)*1000.0;
+void bncFigureLate::slotNextAnimationFrame() {
+
+  // Sample the latest latency and the 95% limit of the latencies since the
+  // last frame (upper bound of the histogram bin)
+  // -----------------------------------------------------------------------
+  QMutableMapIterator<QByteArray, latency> it(_latency);
+  while (it.hasNext()) {
+    latency& lat = it.next().value();
+    lat._current = qMax(lat._counters->latency(), 0.0) * 1000.0;
+
+    QVector<quint64> hist;
+    lat._counters->latencyHistogram(hist);
+    quint64 numLat = 0;
+    for (int iBin = 0; iBin < hist.size(); iBin++) {
+      numLat += hist[iBin] - lat._lastHist[iBin];
+    }
+    if (numLat > 0) {
+      quint64 sum = 0;
+      for (int iBin = 0; iBin < hist.size(); iBin++) {
+        sum += hist[iBin] - lat._lastHist[iBin];
+        if (sum >= 0.95 * numLat) {
+          int limit = bncStreamCounters::binLimit(iBin);
+          lat._p95  = (limit > 0) ? qMax(double(limit), lat._current) : lat._current;
+          break;
+        }
+      }
+    }
+    lat._lastHist = hist;
   }
-}
 
-// 
-////////////////////////////////////////////////////////////////////////////
-void bncFigureLate::slotNextAnimationFrame() {
-  QMutexLocker locker(&_mutex);
   update();
   QTimer::singleShot(1000, this, SLOT(slotNextAnimationFrame()));
 }
@@ -126,11 +146,11 @@ void bncFigureLate::paintEvent(QPaintEvent *) {
   painter.drawLine(xMin+60, int((yMax-yMin)*xLine), xMin+60, yMin+10);
 
   double maxLate = 0.0;
-  QMapIterator<QByteArray, double> it1(_latency);
+  QMapIterator<QByteArray, latency> it1(_latency);
   while (it1.hasNext()) {
     it1.next();
-    if (it1.value() > maxLate) {
-      maxLate = it1.value();
+    if (it1.value()._current > maxLate) {
+      maxLate = it1.value()._current;
     }
   }
 
@@ -161,7 +181,7 @@ void bncFigureLate::paintEvent(QPaintEvent *) {
   painter.drawLine(xMin+60, int((yMax-yMin)*xLine), xMax*3, int((yMax-yMin)*xLine));
 
   int anchor = 0;
-  QMapIterator<QByteArray, double> it(_latency);
+  QMapIterator<QByteArray, latency> it(_latency);
   while (it.hasNext()) {
     it.next();
     QByteArray staID = it.key();
@@ -169,12 +189,16 @@ void bncFigureLate::paintEvent(QPaintEvent *) {
     int xx = xMin+80+anchor*12;
 
     if(maxLate > 0.0) {
-      int yy = int(yLength * (it.value() / maxLateRounded));
+      int yy = int(yLength * (it.value()._current / maxLateRounded));
       QColor color = QColor::fromHsv(180,200,120+_ran[2][anchor]);
       painter.fillRect(xx-13, int((yMax-yMin)*xLine)-yy, 9, yy, 
                        QBrush(color,Qt::SolidPattern));
       painter.setPen(Qt::black);
-      if(it.value()<=0) {
+      if (it.value()._p95 > it.value()._current) {
+        int y95 = qMin(yLength, int(yLength * (it.value()._p95 / maxLateRounded)));
+        painter.drawLine(xx-13, int((yMax-yMin)*xLine)-y95, xx-5, int((yMax-yMin)*xLine)-y95);
+      }
+      if(it.value()._current<=0) {
         painter.setPen(Qt::red);
       }
     }
@@ -27,24 +27,31 @@
 
 #include <QByteArray>
 #include <QMap>
-#include <QMutex>
+#include <QVector>
 #include <QWidget>
 
+class bncStreamCounters;
+
 class bncFigureLate : public QWidget {
   Q_OBJECT
  public:
   bncFigureLate(QWidget *parent);
   ~bncFigureLate();
   void updateMountPoints();
- public slots:
-  void slotNewLatency(const QByteArray staID, double clate);
  protected:
   void paintEvent(QPaintEvent *event);
  private slots:
   void slotNextAnimationFrame();
  private:
-  QMap<QByteArray, double> _latency;
-  QMutex                   _mutex;
+  class latency {
+   public:
+    latency() {_current = 0.0; _p95 = 0.0; _counters = 0;}
+    double             _current;   // [ms]
+    double             _p95;       // [ms], from the histogram since the last frame
+    QVector<quint64>   _lastHist;
+    bncStreamCounters* _counters;
+  };
+  QMap<QByteArray, latency> _latency;
   int                      _ran[3][1001];
 };
 
@@ -58,12 +58,15 @@
 #include "bnczerodecoder.h"
 #include "bncnetqueryv0.h"
 #include "bncnetqueryv1.h"
+#include "bncnettransport.h"
+#include "bncrawwriter.h"
 #include "bncnetqueryv2.h"
 #include "bncnetqueryrtp.h"
 #include "bncnetqueryudp.h"
 #include "bncnetqueryudp0.h"
 #include "bncnetquerys.h"
 #include "bncsettings.h"
+#include "bncstreamstats.h"
 #include "latencychecker.h"
 #include "upload/bncrtnetdecoder.h"
 #include "RTCM/RTCM2Decoder.h"
@@ -130,7 +133,9 @@ void bncGetThread::initialize() {
   _isToBeDeleted = false;
   _query = 0;
   _nextSleep = 0;
+  _reportConnect = false;
   _miscMount = settings.value("miscMount").toString();
+  _counters = bncStreamStats::instance()->counters(_staID);
   _decoder = 0;
 
   // NMEA Port
@@ -289,6 +294,15 @@ void bncGetThread::initialize() {
     }
   }
 
+  // Raw data sinks, written in a thread of their own (the serial port
+  // is written by this thread which also reads it)
+  // ------------------------------------------------------------------
+  _rawBuffer   = QSharedPointer<bncRawBuffer>(new bncRawBuffer(_staID));
+  _rawFileSink = -1;
+  if (_rawOutput) {
+    _rawFileSink = bncRawWriter::instance()->addFileSink(_rawBuffer);
+  }
+
   if (!_staID.isEmpty() && _latencycheck) {
     _latencyChecker = new latencyChecker(_staID);
     obs = false;
@@ -380,6 +394,9 @@ bncGetThread::~bncGetThread() {
   } else {
     delete _decoder;
   }
+  if (_rawFileSink != -1) {
+    bncRawWriter::instance()->removeSink(_rawFileSink);
+  }
   delete _rawFile;
   delete _serialOutFile;
   delete _serialPort;
@@ -426,6 +443,15 @@ void bncGetThread::run() {
   while (true) {
     try {
       if (_isToBeDeleted) {
+
+        // The query uses the network manager of this thread, which is
+        // deleted together with its replies when the thread finishes
+        // -----------------------------------------------------------
+        if (_query) {
+          _query->stop();
+          delete _query;
+          _query = 0;
+        }
         QThread::exit(0);
         this->deleteLater();
         return;
@@ -483,15 +509,16 @@ void bncGetThread::run() {
         msleep(10000); //sleep 10 sec, G. Weber
         continue;
       } else {
-        emit newBytes(_staID, nBytes);
-        emit newRawData(_staID, data);
+        if (_reportConnect) {
+          _reportConnect = false;
+          bncNetTransport::instance()->reportConnected(_mountPoint);
+        }
+        _counters->addChunk(nBytes);
       }
 
-      // Output Data
-      // -----------
-      if (_rawOutput) {
-        BNC_CORE->writeRawData(data, _staID, _format);
-      }
+      // Output Data (raw file, miscellaneous port, serial port)
+      // -------------------------------------------------------
+      _rawBuffer->append(data, _format);
 
       if (_serialPort) {
         slotSerialReadyRead();
@@ -593,7 +620,7 @@ void bncGetThread::run() {
         if (_ssrEpoch != -1) {
           _oldSsrEpoch = _ssrEpoch;
         }
-        emit newLatency(_staID, _latencyChecker->currentLatency());
+        _counters->setLatency(_latencyChecker->currentLatency());
       }
       miscScanRTCM();
 
@@ -690,7 +717,8 @@ t_irc bncGetThread::tryReconnect() {
   // -----------------
   if (!_rawFile) {
 
-    sleep(_nextSleep);
+    bncNetTransport::instance()->waitForReconnect(_mountPoint, _nextSleep);
+    _reportConnect = true;
     if (_nextSleep == 0) {
       _nextSleep = 1;
     } else {
@@ -28,6 +28,7 @@
 #include <QThread>
 #include <QDateTime>
 #include <QFile>
+#include <QSharedPointer>
 #include <QTcpServer>
 #include <QUrl>
 
@@ -35,12 +36,14 @@
 #include "bncnetquery.h"
 #include "bnctime.h"
 #include "bncrawfile.h"
+#include "bncrawbuffer.h"
 #include "satObs.h"
 #include "rinex/rnxobsfile.h"
 
 class GPSDecoder;
 class QextSerialPort;
 class latencyChecker;
+class bncStreamCounters;
 
 class bncGetThread : public QThread {
  Q_OBJECT
@@ -74,11 +77,9 @@ class bncGetThread : public QThread {
    QByteArray latitude() const {return _latitude;}
    QByteArray longitude() const {return _longitude;}
    QByteArray ntripVersion() const {return _ntripVersion;}
+   QSharedPointer<bncRawBuffer> rawBuffer() const {return _rawBuffer;}
 
  signals:
-   void newBytes(QByteArray staID, double nbyte);
-   void newRawData(QByteArray staID, QByteArray data);
-   void newLatency(QByteArray staID, double clate);
    void newObs(QByteArray staID, QList<t_satObs> obsList);
    void newAntCrd(QByteArray staID, double xx, double yy, double zz,
                   double hh, QByteArray antType);
@@ -126,6 +127,7 @@ class bncGetThread : public QThread {
    bncRawFile*                _rawFile;
    QextSerialPort*            _serialPort;
    bool                       _isToBeDeleted;
+   bool                       _reportConnect;
    bool obs;
    bool ssrOrb, ssrClk, ssrOrbClk;
    bool ssrCbi, ssrPbi;
@@ -133,6 +135,9 @@ class bncGetThread : public QThread {
    bool ssrUra;
    bool ssrHr;
    latencyChecker*            _latencyChecker;
+   bncStreamCounters*         _counters;
+   QSharedPointer<bncRawBuffer> _rawBuffer;
+   int                        _rawFileSink;
    QString                    _miscMount;
    QFile*                     _serialOutFile;
    t_serialNMEA               _serialNMEA;
@@ -98,6 +98,8 @@ int main(int argc, char* argv[]) {
       "   onTheFlyInterval {Configuration reload interval [character string: no|1 day|1 hour|5 min|1 min]}\n"
       "   autoStart        {Auto start [integer number: 0=no,2=yes]}\n"
       "   rawOutFile       {Raw output file, full path [character string]}\n"
+      "   outCommit        {Output files, longest time between flushes, 0=each epoch [integer number of milliseconds]}\n"
+      "   outFsync         {Output files, force to disk [character string: none|close|commit]}\n"
       "\n"
       "RINEX Observations Panel keys:\n"
       "   rnxPath        {Directory [character string]}\n"
@@ -106,6 +108,7 @@ int main(int argc, char* argv[]) {
       "   rnxSkel        {RINEX skeleton file extension [character string]}\n"
       "   rnxOnlyWithSKL {Using RINEX skeleton file is mandatory [integer number: 0=no,2=yes]}\n"
       "   rnxScript      {File upload script, full path [character string]}\n"
+      "   rnxScriptThreads {File upload script, maximum number of calls running at a time [integer number]}\n"
       "   rnxV2Priority  {Priority of signal attributes [character string, list separated by blank character, example: G:12&PWCSLXYN G:5&IQX C:IQX]}\n"
       "   rnxV3          {Produce version 3 file contents [integer number: 0=no,2=yes]}\n"
       "   rnxV3filenames {Produce version 3 filenames [integer number: 0=no,2=yes]}\n"
@@ -160,6 +163,7 @@ int main(int argc, char* argv[]) {
       "Broadcast Corrections Panel keys:\n"
       "   corrPath {Directory for saving files in ASCII format [character string]}\n"
       "   corrIntr {File interval [character string: 1 min|2 min|5 min|10 min|15 min|30 min|1 hour|1 day]}\n"
+      "   corrFormat {File format, binary files are faster to read in PPP post processing [character string: ASCII|Binary]}\n"
       "   corrPort {Output port [integer number]}\n"
       "\n"
       "Feed Engine Panel keys:\n"
@@ -250,6 +254,9 @@ int main(int argc, char* argv[]) {
       "   cmbMaxres       {Clock outlier residuum threshold in meters [floating-point number]\n"
       "   cmbSampl        {Clock sampling rate [integer number of seconds: 10|20|30|40|50|60]}\n"
       "   cmbUseGlonass   {Use GLONASS in combination [integer number: 0=no,2=yes]\n"
+      "   cmbUseGalileo   {Use Galileo in combination [integer number: 0=no,2=yes]\n"
+      "   cmbUseBDS       {Use BDS in combination [integer number: 0=no,2=yes]\n"
+      "   cmbUseQZSS      {Use QZSS in combination [integer number: 0=no,2=yes]\n"
       "\n"
       "Upload Corrections Panel keys:\n"
       "   uploadMountpointsOut   {Upload corrections table [character string, semicolon separated list, each element in quotation marks, example:\n"
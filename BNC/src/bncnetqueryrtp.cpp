@@ -76,20 +76,32 @@ void bncNetQueryRtp::waitForRequestResult(const QUrl&, QByteArray&) {
 ////////////////////////////////////////////////////////////////////////////
 void bncNetQueryRtp::waitForReadyRead(QByteArray& outData) {
 
-  // Wait Loop
-  // ---------
-  if (!_udpSocket->hasPendingDatagrams()) {
-    _eventLoop->exec();
-  }
+  // Wait until in-order data are available; packets held back behind a gap
+  // are released after bncRtpBuffer::maxDelay at the latest
+  // -----------------------------------------------------------------------
+  int oldSize = outData.size();
+  while (_status == running) {
+    if (!_udpSocket->hasPendingDatagrams()) {
+      if (_rtpBuffer.waiting()) {
+        QTimer::singleShot(bncRtpBuffer::maxDelay, _eventLoop, SLOT(quit()));
+      }
+      _eventLoop->exec();
+    }
 
-  // Append Data
-  // -----------
-  QByteArray datagram;
-  datagram.resize(_udpSocket->pendingDatagramSize());
-  _udpSocket->readDatagram(datagram.data(), datagram.size());
+    // Append Data (all pending datagrams)
+    // -----------------------------------
+    _rtpBuffer.readDatagrams(_udpSocket, outData);
+    if (outData.size() > oldSize) {
+      break;
+    }
+  }
 
-  if (datagram.size() > 12) {
-    outData.append(datagram.mid(12));
+  QByteArray stat;
+  if (_rtpBuffer.resynced(stat)) {
+    emit newMessage(_url.path().toLatin1().replace(0,1,"") + ": " + stat, true);
+  }
+  if (_rtpBuffer.report(stat)) {
+    emit newMessage(_url.path().toLatin1().replace(0,1,"") + ": " + stat, false);
   }
 }
 
@@ -139,6 +151,7 @@ void bncNetQueryRtp::startRequest(const QUrl& url, const QByteArray& gga) {
     delete _udpSocket;
     _udpSocket = new QUdpSocket();
     _udpSocket->bind(0);
+    _rtpBuffer.reset();
     connect(_udpSocket, SIGNAL(readyRead()), _eventLoop, SLOT(quit()));
     QByteArray clientPort = QString("%1").arg(_udpSocket->localPort()).toLatin1();
 
@@ -4,6 +4,7 @@
 #include <QUdpSocket>
 
 #include "bncnetquery.h"
+#include "bncrtpbuffer.h"
 
 class bncNetQueryRtp : public bncNetQuery {
  Q_OBJECT
@@ -21,11 +22,12 @@ class bncNetQueryRtp : public bncNetQuery {
   void slotKeepAlive();
 
  private:
-  QTcpSocket* _socket;
-  QUdpSocket* _udpSocket;
-  QEventLoop* _eventLoop;
-  QByteArray  _session;
-  int         _CSeq;
+  QTcpSocket*  _socket;
+  QUdpSocket*  _udpSocket;
+  QEventLoop*  _eventLoop;
+  QByteArray   _session;
+  int          _CSeq;
+  bncRtpBuffer _rtpBuffer;
 };
 
 #endif
@@ -5,6 +5,7 @@
 #include <QUdpSocket>
 
 #include "bncnetquery.h"
+#include "bncrtpbuffer.h"
 
 class bncNetQueryUdp : public bncNetQuery {
  Q_OBJECT
@@ -28,6 +29,7 @@ class bncNetQueryUdp : public bncNetQuery {
   int          _port;
   char         _keepAlive[12];
   unsigned     _session;
+  bncRtpBuffer _rtpBuffer;
 };
 
 #endif
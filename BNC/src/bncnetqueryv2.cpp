@@ -19,18 +19,13 @@
 #include "bncnetqueryv2.h"
 #include "bncsettings.h"
 #include "bncversion.h"
-#include "bncsslconfig.h"
-#include "bncsettings.h"
+#include "bncnettransport.h"
 
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
 bncNetQueryV2::bncNetQueryV2(bool secure) {
   _secure    = secure;
-  _manager   = new QNetworkAccessManager(this);
-  connect(_manager, SIGNAL(proxyAuthenticationRequired(const QNetworkProxy&,
-                                                       QAuthenticator*)),
-          this, SLOT(slotProxyAuthenticationRequired(const QNetworkProxy&,
-                                                     QAuthenticator*)));
+  _manager   = bncNetTransport::instance()->manager();
   _reply     = 0;
   _eventLoop = new QEventLoop(this);
   _firstData = true;
@@ -52,9 +47,8 @@ bncNetQueryV2::~bncNetQueryV2() {
   delete _eventLoop;
   if (_reply) {
     _reply->abort();
-    delete _reply;
+    _reply->deleteLater();
   }
-  delete _manager;
 }
 
 // Stop (quit event loop)
@@ -62,7 +56,7 @@ bncNetQueryV2::~bncNetQueryV2() {
 void bncNetQueryV2::stop() {
   if (_reply) {
     _reply->abort();
-    delete _reply;
+    _reply->deleteLater();
     _reply = 0;
   }
   _eventLoop->quit();
@@ -75,6 +69,10 @@ void bncNetQueryV2::slotFinished() {
   _eventLoop->quit();
   if (_reply && _reply->error() != QNetworkReply::NoError) {
     _status = error;
+    if (_reply->error() == QNetworkReply::ProxyAuthenticationRequiredError) {
+      emit newMessage(_url.path().toLatin1().replace(0,1,"") +
+                      ": NetQueryV2: proxy authentication required", true);
+    }
     emit newMessage(_url.path().toLatin1().replace(0,1,"")  +
                     ": NetQueryV2: server replied: " +
                     _reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toByteArray(),
@@ -85,13 +83,6 @@ void bncNetQueryV2::slotFinished() {
   }
 }
 
-//
-////////////////////////////////////////////////////////////////////////////
-void bncNetQueryV2::slotProxyAuthenticationRequired(const QNetworkProxy&,
-                                                    QAuthenticator*) {
-  emit newMessage("slotProxyAuthenticationRequired", true);
-}
-
 // Start request, block till the next read
 ////////////////////////////////////////////////////////////////////////////
 void bncNetQueryV2::startRequest(const QUrl& url, const QByteArray& gga) {
@@ -126,22 +117,16 @@ void bncNetQueryV2::startRequestPrivate(const QUrl& url, const QByteArray& gga,
     _url.setPath("/");
   }
 
-  // Proxy Settings
-  // --------------
-  bncSettings settings;
-  QString proxyHost = settings.value("proxyHost").toString();
-  int     proxyPort = settings.value("proxyPort").toInt();
+  // Proxy Settings (always set, the manager is shared and may still have
+  // a proxy that is no longer configured)
+  // ---------------------------------------------------------------------
+  _manager->setProxy(bncNetTransport::instance()->proxy());
 
-  if (!proxyHost.isEmpty()) {
-    QNetworkProxy proxy(QNetworkProxy::HttpProxy, proxyHost, proxyPort);
-    _manager->setProxy(proxy);
-  }
-
-  // Network Request
-  // ---------------
+  // Network Request (the connection is kept open for further requests
+  // of this thread, TLS sessions of the caster are resumed)
+  // -----------------------------------------------------------------
   QNetworkRequest request;
-  bncSslConfig sslConfig;
-  request.setSslConfiguration(sslConfig);
+  request.setSslConfiguration(bncNetTransport::instance()->sslConfiguration(_url));
   request.setUrl(_url);
   request.setRawHeader("Host"         , _url.host().toLatin1());
   request.setRawHeader("Ntrip-Version", "Ntrip/2.0");
@@ -155,7 +140,6 @@ void bncNetQueryV2::startRequestPrivate(const QUrl& url, const QByteArray& gga,
   if (!gga.isEmpty()) {
     request.setRawHeader("Ntrip-GGA", gga);
   }
-  request.setRawHeader("Connection"   , "close");
 
   if (_reply) {
     delete _reply;
@@ -169,6 +153,9 @@ void bncNetQueryV2::startRequestPrivate(const QUrl& url, const QByteArray& gga,
   connect(_reply, SIGNAL(finished()), _eventLoop, SLOT(quit()));
   connect(_reply, SIGNAL(sslErrors(QList<QSslError>)),
           this, SLOT(slotSslErrors(QList<QSslError>)));
+#if QT_VERSION >= 0x050100
+  connect(_reply, SIGNAL(encrypted()), this, SLOT(slotEncrypted()));
+#endif
   if (!full) {
     connect(_reply, SIGNAL(readyRead()), _eventLoop, SLOT(quit()));
   }
@@ -216,6 +203,14 @@ void bncNetQueryV2::waitForReadyRead(QByteArray& outData) {
   }
 }
 
+// TLS session established
+////////////////////////////////////////////////////////////////////////////
+void bncNetQueryV2::slotEncrypted() {
+  if (_reply) {
+    bncNetTransport::instance()->saveSslSession(_url, _reply->sslConfiguration());
+  }
+}
+
 // TSL/SSL
 ////////////////////////////////////////////////////////////////////////////
 void bncNetQueryV2::slotSslErrors(QList<QSslError> errors) {
@@ -5,6 +5,7 @@
 #include <QNetworkAccessManager>
 #include <QNetworkProxy>
 #include <QNetworkReply>
+#include <QPointer>
 #include <QSslError>
 
 #include "bncnetquery.h"
@@ -24,18 +25,18 @@ class bncNetQueryV2 : public bncNetQuery {
 
  private slots:
   void slotFinished();
-  void slotProxyAuthenticationRequired(const QNetworkProxy&, QAuthenticator*);
   void slotSslErrors(QList<QSslError>);
+  void slotEncrypted();
 
  private:
   void startRequestPrivate(const QUrl& url, const QByteArray& gga, bool full);
 
-  QNetworkAccessManager* _manager;
-  QNetworkReply*         _reply;
-  QEventLoop*            _eventLoop;
-  bool                   _firstData;
-  bool                   _secure;
-  bool                   _sslIgnoreErrors;
+  QNetworkAccessManager*  _manager; // shared by all queries of the thread
+  QPointer<QNetworkReply> _reply;   // owned by the manager
+  QEventLoop*             _eventLoop;
+  bool                    _firstData;
+  bool                    _secure;
+  bool                    _sslIgnoreErrors;
 };
 
 #endif
@@ -0,0 +1,200 @@
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      bncNetTransport
+ *
+ * Purpose:    Network resources shared by all NTRIP connections
+ *
+ * Author:     BKG
+ *
+ * Created:    18-Oct-2026
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QThread>
+
+#include "bncnettransport.h"
+#include "bncsettings.h"
+#include "bncsslconfig.h"
+
+// Shared Instance
+////////////////////////////////////////////////////////////////////////////
+bncNetTransport* bncNetTransport::instance() {
+  static bncNetTransport _bncNetTransport;
+  return &_bncNetTransport;
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncNetTransport::bncNetTransport() {
+  _configRead  = false;
+  _mainManager = 0;
+  _random      = quint64(QDateTime::currentMSecsSinceEpoch());
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+bncNetTransport::~bncNetTransport() {
+  QMapIterator<QString, t_caster*> it(_casters);
+  while (it.hasNext()) {
+    delete it.next().value();
+  }
+}
+
+// Network Access Manager of the calling Thread
+////////////////////////////////////////////////////////////////////////////
+QNetworkAccessManager* bncNetTransport::manager() {
+
+  // The managers of other threads are deleted when the thread finishes
+  // ------------------------------------------------------------------
+  if (QCoreApplication::instance() &&
+      QThread::currentThread() == QCoreApplication::instance()->thread()) {
+    QMutexLocker locker(&_mutex);
+    if (!_mainManager) {
+      _mainManager = new QNetworkAccessManager(QCoreApplication::instance());
+    }
+    return _mainManager;
+  }
+  if (!_managers.hasLocalData()) {
+    _managers.setLocalData(new QNetworkAccessManager());
+  }
+  return _managers.localData();
+}
+
+// Proxy
+////////////////////////////////////////////////////////////////////////////
+QNetworkProxy bncNetTransport::proxy() {
+  QMutexLocker locker(&_mutex);
+  readConfig();
+  return _proxy;
+}
+
+// SSL Configuration (incl. the last TLS session ticket of the caster)
+////////////////////////////////////////////////////////////////////////////
+QSslConfiguration bncNetTransport::sslConfiguration(const QUrl& url) {
+  QMutexLocker locker(&_mutex);
+  readConfig();
+  QSslConfiguration sslConfig = _sslConfig;
+#if QT_VERSION >= 0x050400
+  const QByteArray& ticket = caster(url)->sessionTicket;
+  if (!ticket.isEmpty()) {
+    sslConfig.setSessionTicket(ticket);
+  }
+#else
+  Q_UNUSED(url);
+#endif
+  return sslConfig;
+}
+
+// Remember the TLS session ticket for the next connection to the caster
+////////////////////////////////////////////////////////////////////////////
+void bncNetTransport::saveSslSession(const QUrl& url, const QSslConfiguration& sslConfig) {
+#if QT_VERSION >= 0x050400
+  QByteArray ticket = sslConfig.sessionTicket();
+  if (!ticket.isEmpty()) {
+    QMutexLocker locker(&_mutex);
+    caster(url)->sessionTicket = ticket;
+  }
+#else
+  Q_UNUSED(url);
+  Q_UNUSED(sslConfig);
+#endif
+}
+
+// Read the SSL and Proxy Options again (after they have been changed)
+////////////////////////////////////////////////////////////////////////////
+void bncNetTransport::resetConfig() {
+  QMutexLocker locker(&_mutex);
+  _configRead = false;
+}
+
+// Sleep before re-connecting to a caster
+////////////////////////////////////////////////////////////////////////////
+void bncNetTransport::waitForReconnect(const QUrl& url, int nextSleep) {
+
+  QMutexLocker locker(&_mutex);
+
+  t_caster* cst = caster(url);
+  qint64    now = QDateTime::currentMSecsSinceEpoch();
+
+  // Jittered exponential backoff; cut short as soon as another stream got
+  // through to the same caster again
+  // ----------------------------------------------------------------------
+  qint64 delay = qint64(nextSleep) * 1000;
+  if (delay > 0) {
+    _random = _random * 6364136223846793005ULL + 1442695040888963407ULL;
+    delay   = delay / 2 + qint64((_random >> 33) % quint64(delay / 2 + 1));
+  }
+  qint64 until       = now + delay;
+  qint64 lastConnect = cst->lastConnect;
+  while (now < until && cst->lastConnect == lastConnect) {
+    cst->connected.wait(&_mutex, (unsigned long)(until - now));
+    now = QDateTime::currentMSecsSinceEpoch();
+  }
+
+  // Spread the reconnects to one caster in time
+  // -------------------------------------------
+  qint64 start  = qMax(now, cst->nextSlot);
+  cst->nextSlot = start + _slotSpacing;
+
+  locker.unlock();
+  if (start > now) {
+    QThread::msleep(start - now);
+  }
+}
+
+// A stream received data from the caster
+////////////////////////////////////////////////////////////////////////////
+void bncNetTransport::reportConnected(const QUrl& url) {
+  QMutexLocker locker(&_mutex);
+  t_caster* cst = caster(url);
+  cst->lastConnect = QDateTime::currentMSecsSinceEpoch();
+  cst->connected.wakeAll();
+}
+
+// Caster Identifier (host and port)
+////////////////////////////////////////////////////////////////////////////
+QString bncNetTransport::casterKey(const QUrl& url) {
+  return url.host() + ":" + QString::number(url.port());
+}
+
+// Caster State (requires _mutex)
+////////////////////////////////////////////////////////////////////////////
+bncNetTransport::t_caster* bncNetTransport::caster(const QUrl& url) {
+  QString key = casterKey(url);
+  t_caster* cst = _casters.value(key, 0);
+  if (!cst) {
+    cst = new t_caster();
+    _casters[key] = cst;
+  }
+  return cst;
+}
+
+// Read SSL and Proxy Options (requires _mutex)
+////////////////////////////////////////////////////////////////////////////
+void bncNetTransport::readConfig() {
+  if (_configRead) {
+    return;
+  }
+  _configRead = true;
+
+  _sslConfig = bncSslConfig();
+#if QT_VERSION >= 0x050400
+  _sslConfig.setSslOption(QSsl::SslOptionDisableSessionPersistence, false);
+#endif
+
+  bncSettings settings;
+  QString proxyHost = settings.value("proxyHost").toString();
+  int     proxyPort = settings.value("proxyPort").toInt();
+  if (!proxyHost.isEmpty()) {
+    _proxy = QNetworkProxy(QNetworkProxy::HttpProxy, proxyHost, proxyPort);
+  }
+  else {
+    _proxy = QNetworkProxy(QNetworkProxy::NoProxy);
+  }
+}
@@ -0,0 +1,63 @@
+#ifndef BNCNETTRANSPORT_H
+#define BNCNETTRANSPORT_H
+
+#include <QMap>
+#include <QMutex>
+#include <QNetworkAccessManager>
+#include <QNetworkProxy>
+#include <QSslConfiguration>
+#include <QThreadStorage>
+#include <QUrl>
+#include <QWaitCondition>
+
+// Singleton Class
+// ---------------
+// State shared by all NTRIP connections of the process: one network access
+// manager per thread (kept across reconnects), the SSL and proxy setup read
+// once, TLS session tickets per caster, and the reconnect schedule per caster
+class bncNetTransport {
+ public:
+  static bncNetTransport* instance();
+
+  QNetworkAccessManager* manager();
+  QNetworkProxy          proxy();
+  QSslConfiguration      sslConfiguration(const QUrl& url);
+  void                   saveSslSession(const QUrl& url, const QSslConfiguration& sslConfig);
+  void                   resetConfig();
+
+  void waitForReconnect(const QUrl& url, int nextSleep);
+  void reportConnected(const QUrl& url);
+
+ private:
+  class t_caster {
+   public:
+    t_caster() {
+      lastConnect = 0;
+      nextSlot    = 0;
+    }
+    QByteArray     sessionTicket;
+    qint64         lastConnect; // [ms]
+    qint64         nextSlot;    // [ms]
+    QWaitCondition connected;
+  };
+
+  bncNetTransport();
+  ~bncNetTransport();
+
+  static QString casterKey(const QUrl& url);
+  t_caster*      caster(const QUrl& url);
+  void           readConfig();
+
+  static const int _slotSpacing = 100; // [ms] between two reconnects to one caster
+
+  QMutex                                  _mutex;
+  bool                                    _configRead;
+  QSslConfiguration                       _sslConfig;
+  QNetworkProxy                           _proxy;
+  QNetworkAccessManager*                  _mainManager;
+  quint64                                 _random;      // state of the jitter generator
+  QMap<QString, t_caster*>                _casters;
+  QThreadStorage<QNetworkAccessManager*>  _managers;
+};
+
+#endif
@@ -17,15 +17,73 @@
 
 #include <math.h>
 #include <iomanip>
+#ifdef WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 #include "bncoutf.h"
 #include "bncsettings.h"
 
 using namespace std;
 
+// Thread committing the lines of all files within outCommit milliseconds
+// (within a second if each epoch is committed), also when no further
+// epoch is written
+////////////////////////////////////////////////////////////////////////////
+class bncoutf::t_committer : public QThread {
+ public:
+  static t_committer* instance() {
+    static t_committer _committer;
+    return &_committer;
+  }
+  void add(bncoutf* outf) {
+    QMutexLocker locker(&_mutex);
+    _files.append(outf);
+    if (!isRunning()) {
+      start();
+    }
+  }
+  void remove(bncoutf* outf) {
+    QMutexLocker locker(&_mutex);
+    _files.removeAll(outf);
+  }
+ protected:
+  virtual void run() {
+    QMutexLocker locker(&_mutex);
+    while (!_stop) {
+      _waitCond.wait(&_mutex, _interval);
+      for (int ii = 0; ii < _files.size(); ii++) {
+        _files[ii]->commitDue(_interval);
+      }
+    }
+  }
+ private:
+  t_committer() {
+    bncSettings settings;
+    int commitTime = settings.value("outCommit").toInt();
+    _interval = (commitTime > 0) ? qMax(commitTime / 2, 1) : 1000;
+    _stop = false;
+  }
+  ~t_committer() {
+    _mutex.lock();
+    _stop = true;
+    _waitCond.wakeAll();
+    _mutex.unlock();
+    wait();
+  }
+  QMutex          _mutex;
+  QWaitCondition  _waitCond;
+  QList<bncoutf*> _files;
+  unsigned long   _interval;  // [ms]
+  bool            _stop;
+};
+
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
-bncoutf::bncoutf(const QString& sklFileName, const QString& intr, int sampl) {
+bncoutf::bncoutf(const QString& sklFileName, const QString& intr, int sampl) :
+  _mutex(QMutex::Recursive) {
 
   bncSettings settings;
 
@@ -33,6 +91,10 @@ bncoutf::bncoutf(const QString& sklFileName, const QString& intr, int sampl) {
   _sampl         = sampl;
   _intr          = intr;
   _numSec        = 0;
+  _fileBeg       = 0.0;
+  _fileEnd       = 0.0;
+  _lastEpoch     = -1.0;
+  _commitPos     = -1;
 
   if (! sklFileName.isEmpty()) {
     QFileInfo fileInfo(sklFileName);
@@ -48,18 +110,92 @@ bncoutf::bncoutf(const QString& sklFileName, const QString& intr, int sampl) {
 
   _append = Qt::CheckState(settings.value("rnxAppend").toInt()) == Qt::Checked;
   _v3filenames = settings.value("PPP/v3filenames").toBool();
+
+  // Lines are committed to the file at each new epoch, or at most every
+  // outCommit milliseconds; outFsync forces them to the disk
+  // -------------------------------------------------------------------
+  _commitTime = settings.value("outCommit").toInt();
+  if (_commitTime < 0) {
+    _commitTime = 0;
+  }
+  QString fsync = settings.value("outFsync").toString();
+  if      (fsync == "commit") {
+    _fsync = fsyncCommit;
+  }
+  else if (fsync == "close") {
+    _fsync = fsyncClose;
+  }
+  else {
+    _fsync = fsyncNone;
+  }
+
+  t_committer::instance()->add(this);
 }
 
 // Destructor
 ////////////////////////////////////////////////////////////////////////////
 bncoutf::~bncoutf() {
+  t_committer::instance()->remove(this);
   closeFile();
 }
 
 // Close the Old RINEX File
 ////////////////////////////////////////////////////////////////////////////
 void bncoutf::closeFile() {
-  _out.close();
+  QMutexLocker locker(&_mutex);
+  if (_out.is_open()) {
+    _out.close();
+    if (_fsync != fsyncNone) {
+      sync();
+    }
+  }
+}
+
+// Pass the buffered Lines to the System (if forced or the time is due)
+////////////////////////////////////////////////////////////////////////////
+void bncoutf::commit(bool force) {
+  if (!_out.is_open()) {
+    return;
+  }
+  if (!force && _commitTime > 0 && _lastCommit.isValid() &&
+      _lastCommit.elapsed() < _commitTime) {
+    return;
+  }
+  _out.flush();
+  _commitPos = qint64(_out.tellp());
+  if (_fsync == fsyncCommit) {
+    sync();
+  }
+  _lastCommit.start();
+}
+
+// Commit Lines still in the Buffer (called by the committer thread every
+// period milliseconds, lines are committed at the latest outCommit ms
+// after the last commit)
+////////////////////////////////////////////////////////////////////////////
+void bncoutf::commitDue(int period) {
+  QMutexLocker locker(&_mutex);
+  if (!_out.is_open() || qint64(_out.tellp()) == _commitPos) {
+    return;
+  }
+  if (_commitTime > 0 && _lastCommit.isValid() &&
+      _lastCommit.elapsed() + period < _commitTime) {
+    return;
+  }
+  commit(true);
+}
+
+// Force the current File to the Disk
+////////////////////////////////////////////////////////////////////////////
+void bncoutf::sync() {
+  QFile file(_fName);
+  if (file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+#ifdef WIN32
+    _commit(file.handle());
+#else
+    fsync(file.handle());
+#endif
+  }
 }
 
 // Epoch String
@@ -159,13 +295,37 @@ QString bncoutf::resolveFileName(int GPSweek, const QDateTime& datTim) {
 ////////////////////////////////////////////////////////////////////////////
 t_irc bncoutf::reopen(int GPSweek, double GPSweeks) {
 
+  QMutexLocker locker(&_mutex);
+
   if (_sampl != 0 && fmod(GPSweeks, _sampl) != 0.0) {
     return failure;
   }
 
+  // A new epoch commits the lines of the previous one
+  // -------------------------------------------------
+  double epoch = GPSweek * 604800.0 + GPSweeks;
+  if (epoch != _lastEpoch) {
+    commit(false);
+    _lastEpoch = epoch;
+  }
+
+  // The file name is resolved once per file interval
+  // ------------------------------------------------
+  if (_headerWritten && epoch >= _fileBeg && epoch < _fileEnd) {
+    return success;
+  }
+
   QDateTime datTim = dateAndTimeFromGPSweek(GPSweek, GPSweeks);
 
   QString newFileName = resolveFileName(GPSweek, datTim);
+  if (_numSec > 0 && 86400 % _numSec == 0 && (_numSec >= 3600 || 3600 % _numSec == 0)) {
+    _fileBeg = floor(epoch / _numSec) * _numSec;
+    _fileEnd = _fileBeg + _numSec;
+  }
+  else {
+    _fileBeg = 0.0;
+    _fileEnd = 0.0;
+  }
 
   // Close the file
   // --------------
@@ -189,6 +349,7 @@ t_irc bncoutf::reopen(int GPSweek, double GPSweeks) {
     if (_out.is_open()) {
       _headerWritten = true;
     }
+    _commitPos = -1;
   }
 
   return success;
@@ -197,8 +358,8 @@ t_irc bncoutf::reopen(int GPSweek, double GPSweeks) {
 // Write String
 ////////////////////////////////////////////////////////////////////////////
 t_irc bncoutf::write(int GPSweek, double GPSweeks, const QString& str) {
+  QMutexLocker locker(&_mutex);
   reopen(GPSweek, GPSweeks);
   _out << str.toLatin1().data();
-  _out.flush();
   return success;
 }
@@ -12,28 +12,43 @@ class bncoutf {
   bncoutf(const QString& sklFileName, const QString& intr, int sampl);
   virtual ~bncoutf();
   t_irc write(int GPSweek, double GPSweeks, const QString& str);
+  void  commitDue(int period);
 
  protected:
   virtual t_irc reopen(int GPSweek, double GPSweeks);
   virtual void  writeHeader(const QDateTime& /* datTim */) {}
   virtual void  closeFile();
+  void          commit(bool force);
+  QMutex        _mutex;      // recursive, guards _out against the periodic commit
   std::ofstream _out;
   int           _sampl;
   int           _numSec;
 
  private:
+  enum t_fsync {fsyncNone, fsyncClose, fsyncCommit};
+
+  class t_committer;
+
   QString epochStr(const QDateTime& datTim, const QString& intStr,
       int sampl);
   QString resolveFileName(int GPSweek, const QDateTime& datTim);
+  void    sync();
 
-  bool    _headerWritten;
-  QString _path;
-  QString _sklBaseName;
-  QString _extension;
-  QString _intr;
-  QString _fName;
-  bool    _append;
-  bool    _v3filenames;
+  bool          _headerWritten;
+  QString       _path;
+  QString       _sklBaseName;
+  QString       _extension;
+  QString       _intr;
+  QString       _fName;
+  bool          _append;
+  bool          _v3filenames;
+  double        _fileBeg;    // [s] since GPS week 0, interval of _fName
+  double        _fileEnd;
+  double        _lastEpoch;  // [s] since GPS week 0, of the last write
+  int           _commitTime; // [ms] 0: commit at each new epoch
+  QElapsedTimer _lastCommit;
+  qint64        _commitPos;  // stream position of the last commit
+  t_fsync       _fsync;
 };
 
 #endif
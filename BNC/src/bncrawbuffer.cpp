@@ -0,0 +1,141 @@
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      bncRawBuffer
+ *
+ * Purpose:    Raw stream data shared by the output sinks of a stream
+ *
+ * Author:     BKG
+ *
+ * Created:    18-Oct-2026
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include "bncrawbuffer.h"
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncRawBuffer::bncRawBuffer(const QByteArray& staID) {
+  _staID      = staID;
+  _firstSeq   = 0;
+  _numBytes   = 0;
+  _nextReader = 0;
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+bncRawBuffer::~bncRawBuffer() {
+}
+
+// New Data from the Stream
+////////////////////////////////////////////////////////////////////////////
+void bncRawBuffer::append(const QByteArray& data, const QByteArray& format) {
+
+  if (data.isEmpty()) {
+    return;
+  }
+
+  QMutexLocker locker(&_mutex);
+
+  if (_cursors.isEmpty()) {
+    return;
+  }
+
+  t_chunk chunk;
+  chunk._data   = data;
+  chunk._format = format;
+  _chunks.append(chunk);
+  _numBytes += data.size();
+
+  // Drop the oldest chunks, readers still behind lose them
+  // ------------------------------------------------------
+  while (_chunks.size() > _maxChunks || (_numBytes > _maxBytes && _chunks.size() > 1)) {
+    qint64 size = _chunks.first()._data.size();
+    QMutableMapIterator<int, t_cursor> it(_cursors);
+    while (it.hasNext()) {
+      t_cursor& cursor = it.next().value();
+      if (cursor._next == _firstSeq) {
+        cursor._lost += size;
+        ++cursor._next;
+      }
+    }
+    _numBytes -= size;
+    _chunks.removeFirst();
+    ++_firstSeq;
+  }
+
+  // Notify each reader once until it has read
+  // -----------------------------------------
+  QMutableMapIterator<int, t_cursor> it(_cursors);
+  while (it.hasNext()) {
+    t_cursor& cursor = it.next().value();
+    if (!cursor._notified) {
+      cursor._notified = true;
+      cursor._reader->rawDataAvailable(_staID);
+    }
+  }
+}
+
+// Register a Reader (it gets the data appended from now on)
+////////////////////////////////////////////////////////////////////////////
+int bncRawBuffer::addReader(bncRawReader* reader) {
+  QMutexLocker locker(&_mutex);
+  t_cursor cursor;
+  cursor._reader = reader;
+  cursor._next   = _firstSeq + _chunks.size();
+  int iReader = _nextReader++;
+  _cursors[iReader] = cursor;
+  return iReader;
+}
+
+// Unregister a Reader
+////////////////////////////////////////////////////////////////////////////
+void bncRawBuffer::removeReader(int iReader) {
+  QMutexLocker locker(&_mutex);
+  _cursors.remove(iReader);
+  trim();
+}
+
+// Chunks not yet read (returns the number of bytes lost since the last call)
+////////////////////////////////////////////////////////////////////////////
+qint64 bncRawBuffer::read(int iReader, QList<t_chunk>& chunks) {
+
+  QMutexLocker locker(&_mutex);
+
+  if (!_cursors.contains(iReader)) {
+    return 0;
+  }
+  t_cursor& cursor = _cursors[iReader];
+  cursor._notified = false;
+
+  qint64 endSeq = _firstSeq + _chunks.size();
+  for (qint64 seq = cursor._next; seq < endSeq; seq++) {
+    chunks.append(_chunks[int(seq - _firstSeq)]);
+  }
+  cursor._next = endSeq;
+
+  qint64 lost = cursor._lost;
+  cursor._lost = 0;
+
+  trim();
+
+  return lost;
+}
+
+// Release the chunks read by all readers (requires _mutex)
+////////////////////////////////////////////////////////////////////////////
+void bncRawBuffer::trim() {
+  qint64 minNext = _firstSeq + _chunks.size();
+  QMapIterator<int, t_cursor> it(_cursors);
+  while (it.hasNext()) {
+    minNext = qMin(minNext, it.next().value()._next);
+  }
+  while (_firstSeq < minNext) {
+    _numBytes -= _chunks.first()._data.size();
+    _chunks.removeFirst();
+    ++_firstSeq;
+  }
+}
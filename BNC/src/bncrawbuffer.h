@@ -0,0 +1,62 @@
+#ifndef BNCRAWBUFFER_H
+#define BNCRAWBUFFER_H
+
+#include <QByteArray>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+
+// Notification that new data are in a raw buffer. It is called in the
+// thread of the stream (with the buffer locked) and must return at once.
+class bncRawReader {
+ public:
+  virtual ~bncRawReader() {}
+  virtual void rawDataAvailable(const QByteArray& staID) = 0;
+};
+
+// Raw bytes of one stream, kept as implicitly shared chunks (not copied)
+// for several readers with cursors of their own. A reader falling behind
+// by more than the buffer size loses the oldest chunks; the stream thread
+// never waits for a reader.
+class bncRawBuffer {
+ public:
+  class t_chunk {
+   public:
+    QByteArray _data;
+    QByteArray _format;
+  };
+
+  bncRawBuffer(const QByteArray& staID);
+  ~bncRawBuffer();
+
+  const QByteArray& staID() const {return _staID;}
+  void   append(const QByteArray& data, const QByteArray& format);
+  int    addReader(bncRawReader* reader);
+  void   removeReader(int iReader);
+  qint64 read(int iReader, QList<t_chunk>& chunks);
+
+ private:
+  class t_cursor {
+   public:
+    t_cursor() {_reader = 0; _next = 0; _lost = 0; _notified = false;}
+    bncRawReader* _reader;
+    qint64        _next;     // sequence number of the next chunk to read
+    qint64        _lost;     // bytes lost since the last read
+    bool          _notified;
+  };
+
+  void trim();
+
+  static const int    _maxChunks = 1024;
+  static const qint64 _maxBytes  = 4 * 1024 * 1024;
+
+  QByteArray          _staID;
+  QMutex              _mutex;
+  QList<t_chunk>      _chunks;
+  qint64              _firstSeq;  // sequence number of _chunks.first()
+  qint64              _numBytes;
+  QMap<int, t_cursor> _cursors;
+  int                 _nextReader;
+};
+
+#endif
@@ -0,0 +1,157 @@
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      bncRawWriter
+ *
+ * Purpose:    Raw file and serial port output of all streams
+ *
+ * Author:     BKG
+ *
+ * Created:    18-Oct-2026
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include "bncrawwriter.h"
+#include "bnccore.h"
+
+// Shared Instance
+////////////////////////////////////////////////////////////////////////////
+bncRawWriter* bncRawWriter::instance() {
+  static bncRawWriter _bncRawWriter;
+  return &_bncRawWriter;
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncRawWriter::bncRawWriter() {
+  _nextSink    = 0;
+  _dataPending = false;
+  _stop        = false;
+  connect(this, SIGNAL(newMessage(QByteArray,bool)),
+          BNC_CORE, SLOT(slotMessage(const QByteArray,bool)));
+  start();
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+bncRawWriter::~bncRawWriter() {
+  _mutex.lock();
+  _stop = true;
+  _waitCond.wakeAll();
+  _mutex.unlock();
+  wait();
+  QMapIterator<int, t_sink*> it(_sinks);
+  while (it.hasNext()) {
+    t_sink* sink = it.next().value();
+    sink->_buffer->removeReader(sink->_iReader);
+    delete sink;
+  }
+}
+
+// Raw Output File of a Stream
+////////////////////////////////////////////////////////////////////////////
+int bncRawWriter::addFileSink(QSharedPointer<bncRawBuffer> buffer) {
+  t_sink* sink   = new t_sink;
+  sink->_buffer  = buffer;
+  sink->_removed = false;
+  sink->_iReader = buffer->addReader(this);
+
+  QMutexLocker locker(&_mutex);
+  int iSink = _nextSink++;
+  _sinks[iSink] = sink;
+  return iSink;
+}
+
+// Unregister a Sink; returns after its pending data have been written
+////////////////////////////////////////////////////////////////////////////
+void bncRawWriter::removeSink(int iSink) {
+  QMutexLocker locker(&_mutex);
+  if (!_sinks.contains(iSink)) {
+    return;
+  }
+  _sinks[iSink]->_removed = true;
+  _dataPending = true;
+  _waitCond.wakeOne();
+  while (_sinks.contains(iSink) && !_stop) {
+    _sinkRemoved.wait(&_mutex);
+  }
+}
+
+// Called by the stream threads
+////////////////////////////////////////////////////////////////////////////
+void bncRawWriter::rawDataAvailable(const QByteArray&) {
+  QMutexLocker locker(&_mutex);
+  _dataPending = true;
+  _waitCond.wakeOne();
+}
+
+// Thread
+////////////////////////////////////////////////////////////////////////////
+void bncRawWriter::run() {
+
+  QMutexLocker locker(&_mutex);
+
+  while (!_stop) {
+    if (!_dataPending) {
+      _waitCond.wait(&_mutex);
+      continue;
+    }
+    _dataPending = false;
+
+    // Write without holding the lock; sinks marked as removed before
+    // this pass have been drained afterwards and can go
+    // ---------------------------------------------------------------
+    QList<t_sink*> sinks   = _sinks.values();
+    QList<int>     removed;
+    QMapIterator<int, t_sink*> it(_sinks);
+    while (it.hasNext()) {
+      it.next();
+      if (it.value()->_removed) {
+        removed << it.key();
+      }
+    }
+    locker.unlock();
+
+    for (int ii = 0; ii < sinks.size(); ii++) {
+      writeSink(sinks[ii]);
+    }
+
+    locker.relock();
+    QList<t_sink*> finished;
+    for (int ii = 0; ii < removed.size(); ii++) {
+      finished << _sinks.take(removed[ii]);
+    }
+    if (!finished.isEmpty()) {
+      locker.unlock();
+      for (int ii = 0; ii < finished.size(); ii++) {
+        finished[ii]->_buffer->removeReader(finished[ii]->_iReader);
+        delete finished[ii];
+      }
+      locker.relock();
+      _sinkRemoved.wakeAll();
+    }
+  }
+  _sinkRemoved.wakeAll();
+}
+
+// Write the pending Data of one Sink
+////////////////////////////////////////////////////////////////////////////
+void bncRawWriter::writeSink(t_sink* sink) {
+
+  QList<bncRawBuffer::t_chunk> chunks;
+  qint64 lost = sink->_buffer->read(sink->_iReader, chunks);
+
+  const QByteArray& staID = sink->_buffer->staID();
+  if (lost > 0) {
+    emit newMessage(staID + ": Raw file output too slow, " + QByteArray::number(lost)
+                    + " bytes skipped", true);
+  }
+
+  for (int ii = 0; ii < chunks.size(); ii++) {
+    const bncRawBuffer::t_chunk& chunk = chunks[ii];
+    BNC_CORE->writeRawData(chunk._data, staID, chunk._format);
+  }
+}
@@ -0,0 +1,53 @@
+#ifndef BNCRAWWRITER_H
+#define BNCRAWWRITER_H
+
+#include <QMap>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QThread>
+#include <QWaitCondition>
+
+#include "bncrawbuffer.h"
+
+// Singleton Class
+// ---------------
+// Thread writing the raw data of all streams to the raw output file, so
+// that a slow disk does not delay the stream threads
+class bncRawWriter : public QThread, public bncRawReader {
+ Q_OBJECT
+ public:
+  static bncRawWriter* instance();
+
+  int  addFileSink(QSharedPointer<bncRawBuffer> buffer);
+  void removeSink(int iSink);
+
+  virtual void rawDataAvailable(const QByteArray& staID);
+
+ signals:
+  void newMessage(QByteArray msg, bool showOnScreen);
+
+ protected:
+  virtual void run();
+
+ private:
+  class t_sink {
+   public:
+    QSharedPointer<bncRawBuffer> _buffer;
+    int                          _iReader;
+    bool                         _removed;
+  };
+
+  bncRawWriter();
+  ~bncRawWriter();
+  void writeSink(t_sink* sink);
+
+  QMutex               _mutex;
+  QWaitCondition       _waitCond;
+  QWaitCondition       _sinkRemoved;
+  QMap<int, t_sink*>   _sinks;
+  int                  _nextSink;
+  bool                 _dataPending;
+  bool                 _stop;
+};
+
+#endif
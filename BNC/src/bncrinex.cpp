@@ -43,6 +43,11 @@
 #include <iomanip>
 #include <math.h>
 #include <sstream>
+#ifdef WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
 #include <QtCore>
 #include <QUrl>
@@ -52,11 +57,10 @@
 #include "bnccore.h"
 #include "bncutils.h"
 #include "bncconst.h"
-#include "bnctabledlg.h"
 #include "bncgetthread.h"
-#include "bncnetqueryv1.h"
-#include "bncnetqueryv2.h"
+#include "bncrotationservice.h"
 #include "bncsettings.h"
+#include "bncsklcache.h"
 #include "bncversion.h"
 
 using namespace std;
@@ -94,6 +98,16 @@ bncRinex::bncRinex(const QByteArray& statID, const QUrl& mountPoint,
   _writeRinexFileOnlyWithSkl = settings.value("rnxOnlyWithSKL").toBool();
 
   _rnxV3filenames = settings.value("rnxV3filenames").toBool();
+
+  _commitTime = settings.value("outCommit").toInt();
+  _fsync      = settings.value("outFsync").toString();
+
+  // Skeleton from the caster, unless local skeleton files are used
+  // ---------------------------------------------------------------
+  if (settings.value("rnxSkel").toString().isEmpty() &&
+      _ntripVersion != "N" && _ntripVersion != "UN" && _ntripVersion != "S") {
+    bncSklCache::instance()->prefetch(_mountPoint, _ntripVersion);
+  }
 }
 
 // Destructor
@@ -104,7 +118,12 @@ bncRinex::~bncRinex() {
     _out << ">                              4  1" << endl;
     _out << "END OF FILE" << endl;
   }
-  _out.close();
+  if (_out.is_open()) {
+    _out.close();
+    if (!_fsync.isEmpty() && _fsync != "none") {
+      sync();
+    }
+  }
 }
 
 // Download Skeleton Header File
@@ -113,60 +132,10 @@ t_irc bncRinex::downloadSkeleton() {
 
   t_irc irc = failure;
 
-  QStringList table;
-  bncTableDlg::getFullTable(_ntripVersion, _mountPoint.host(),
-                            _mountPoint.port(), table, true);
-  QString net;
-  QStringListIterator it(table);
-  while (it.hasNext()) {
-    QString line = it.next();
-    if (line.indexOf("STR") == 0) {
-      QStringList tags = line.split(";");
-      if (tags.size() > 7) {
-        if (tags.at(1) == _mountPoint.path().mid(1).toLatin1()) {
-          net = tags.at(7);
-          break;
-        }
-      }
-    }
-  }
-  QString sklDir;
-  if (!net.isEmpty()) {
-    it.toFront();
-    while (it.hasNext()) {
-      QString line = it.next();
-      if (line.indexOf("NET") == 0) {
-        QStringList tags = line.split(";");
-        if (tags.size() > 6) {
-          if (tags.at(1) == net) {
-            sklDir = tags.at(6).trimmed();
-            break;
-          }
-        }
-      }
-    }
-  }
-  if (!sklDir.isEmpty() && sklDir != "none") {
-    QUrl url(sklDir + "/" + _mountPoint.path().mid(1,4).toLower() + ".skl");
-    if (url.port() == -1) {
-      if (sklDir.contains("https", Qt::CaseInsensitive)) {
-        url.setPort(443);
-      }
-      else {
-        url.setPort(80);
-      }
-    }
-
-    bncNetQuery* query = new bncNetQueryV2(true);
-    QByteArray outData;
-    query->waitForRequestResult(url, outData);
-    if (query->status() == bncNetQuery::finished &&
-        outData.contains("END OF HEADER")) {
-      QTextStream in(outData);
-      irc = _sklHeader.read(&in);
-    }
-
-    delete query;
+  QByteArray sklData;
+  if (bncSklCache::instance()->skeleton(_mountPoint, _ntripVersion, sklData) == success) {
+    QTextStream in(sklData);
+    irc = _sklHeader.read(&in);
   }
 
   return irc;
@@ -435,6 +404,8 @@ void bncRinex::writeHeader(const QByteArray& format, const bncTime& firstObsTime
   _header.setStartTime(firstObsTime);
   _header.write(&outHlp, &txtMap);
 
+  _formatter.init(_header, _sklHeader);
+
   outHlp.flush();
 
   if (!_headerWritten) {
@@ -459,9 +430,8 @@ void bncRinex::dumpEpoch(const QByteArray& format, const bncTime& maxTime) {
   QList<t_satObs> obsList;
   QMutableListIterator<t_satObs> mIt(_obs);
   while (mIt.hasNext()) {
-    t_satObs obs = mIt.next();
-    if (obs._time < maxTime) {
-      obsList.push_back(obs);
+    if (mIt.next()._time < maxTime) {
+      obsList.push_back(mIt.value());
       mIt.remove();
     }
   }
@@ -493,69 +463,17 @@ void bncRinex::dumpEpoch(const QByteArray& format, const bncTime& maxTime) {
     return;
   }
 
-  // Prepare structure t_rnxEpo
-  // --------------------------
-  t_rnxObsFile::t_rnxEpo rnxEpo;
-  rnxEpo.tt = fObs._time;
-
-  QListIterator<t_satObs> it(obsList);
-  while (it.hasNext()) {
-    const t_satObs& satObs = it.next();
-    t_rnxObsFile::t_rnxSat rnxSat;
-    rnxSat.prn = satObs._prn;
-
-    // Initialize all observations mentioned in skeleton header
-    // --------------------------------------------------------
-    char sys = rnxSat.prn.system();
-    for (int iType = 0; iType < _sklHeader.nTypes(sys); iType++) {
-      QString type = _sklHeader.obsType(sys, iType);
-      t_rnxObsFile::t_rnxObs rnxObs; // create an empty observation
-      rnxSat.obs[type] = rnxObs;
-    }
-
-    for (unsigned ii = 0; ii < satObs._obs.size(); ii++) {
-      const t_frqObs* frqObs = satObs._obs[ii];
-      if (frqObs->_codeValid) {
-        QString type = 'C' + QString(frqObs->_rnxType2ch.c_str());
-        t_rnxObsFile::t_rnxObs rnxObs;
-        rnxObs.value = frqObs->_code;
-        rnxSat.obs[type] = rnxObs;
-      }
-      if (frqObs->_phaseValid) {
-        QString type = 'L' + QString(frqObs->_rnxType2ch.c_str());
-        t_rnxObsFile::t_rnxObs rnxObs;
-        rnxObs.value = frqObs->_phase;
-        if (frqObs->_slip) {
-          rnxObs.lli |= 1;
-        }
-        rnxSat.obs[type] = rnxObs;
-      }
-      if (frqObs->_dopplerValid) {
-        QString type = 'D' + QString(frqObs->_rnxType2ch.c_str());
-        t_rnxObsFile::t_rnxObs rnxObs;
-        rnxObs.value = frqObs->_doppler;
-        rnxSat.obs[type] = rnxObs;
-      }
-      if (frqObs->_snrValid) {
-        QString type = 'S' + QString(frqObs->_rnxType2ch.c_str());
-        t_rnxObsFile::t_rnxObs rnxObs;
-        rnxObs.value = frqObs->_snr;
-        rnxSat.obs[type] = rnxObs;
-      }
-    }
-
-
-    rnxEpo.rnxSat.push_back(rnxSat);
-  }
-
   // Write the epoch
   // ---------------
-  QByteArray outLines;
-  QTextStream outStream(&outLines);
-  t_rnxObsFile::writeEpoch(&outStream, _header, &rnxEpo);
-
-  _out << outLines.data();
-  _out.flush();
+  const string& outLines = _formatter.format(fObs._time, obsList);
+  _out.write(outLines.data(), outLines.size());
+  if (_commitTime <= 0 || !_lastCommit.isValid() || _lastCommit.elapsed() >= _commitTime) {
+    _out.flush();
+    if (_fsync == "commit") {
+      sync();
+    }
+    _lastCommit.start();
+  }
 }
 
 // Close the Old RINEX File
@@ -567,14 +485,24 @@ void bncRinex::closeFile() {
     _out << "END OF FILE" << endl;
   }
   _out.close();
+  if (!_fsync.isEmpty() && _fsync != "none") {
+    sync();
+  }
   if (!_rnxScriptName.isEmpty()) {
-    qApp->thread()->wait(100);
+    bncRotationService::instance()->post(_rnxScriptName, _fName);
+  }
+}
+
+// Force the current File to the Disk
+////////////////////////////////////////////////////////////////////////////
+void bncRinex::sync() {
+  QFile file(_fName);
+  if (file.open(QIODevice::WriteOnly | QIODevice::Append)) {
 #ifdef WIN32
-    QProcess::startDetached(_rnxScriptName, QStringList() << _fName) ;
+    _commit(file.handle());
 #else
-    QProcess::startDetached("nohup", QStringList() << _rnxScriptName << _fName) ;
+    fsync(file.handle());
 #endif
-
   }
 }
 
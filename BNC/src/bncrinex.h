@@ -31,6 +31,7 @@
 #include "bncconst.h"
 #include "satObs.h"
 #include "rinex/rnxobsfile.h"
+#include "rinex/rnxobsformatter.h"
 
 class bncRinex {
  public:
@@ -55,6 +56,7 @@ class bncRinex {
    bool readSkeleton();
    void writeHeader(const QByteArray& format, const bncTime& firstObsTime);
    void closeFile();
+   void sync();
    t_irc downloadSkeleton();
 
    QByteArray      _statID;
@@ -77,14 +79,18 @@ class bncRinex {
    bool            _reconnectFlag;
    QDate           _skeletonDate;
    int             _samplingRate;
+   int             _commitTime;  // [ms] 0: flush each epoch
+   QElapsedTimer   _lastCommit;
+   QString         _fsync;       // none, close or commit
    QStringList     _addComments;
 
    QMap<QString, int>  _slip_cnt_L1;
    QMap<QString, int>  _slip_cnt_L2;
    QMap<QString, int>  _slip_cnt_L5;
 
-   t_rnxObsHeader _sklHeader;
-   t_rnxObsHeader _header;
+   t_rnxObsHeader    _sklHeader;
+   t_rnxObsHeader    _header;
+   t_rnxObsFormatter _formatter;
 };
 
 #endif
@@ -0,0 +1,170 @@
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      bncRotationService
+ *
+ * Purpose:    Non-blocking script calls for finally saved files
+ *
+ * Author:     BKG
+ *
+ * Created:    18-Oct-2026
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QProcess>
+#include <QStringList>
+
+#include "bncrotationservice.h"
+#include "bnccore.h"
+#include "bncsettings.h"
+
+// Shared Instance
+////////////////////////////////////////////////////////////////////////////
+bncRotationService* bncRotationService::instance() {
+  static bncRotationService _bncRotationService;
+  return &_bncRotationService;
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncRotationService::bncRotationService() {
+  _stop = false;
+  connect(this, SIGNAL(newMessage(QByteArray,bool)),
+          BNC_CORE, SLOT(slotMessage(const QByteArray,bool)));
+  bncSettings settings;
+  int numWorkers = settings.value("rnxScriptThreads").toInt();
+  if (numWorkers < 1) {
+    numWorkers = 1;
+  }
+  for (int ii = 0; ii < numWorkers; ii++) {
+    t_worker* worker = new t_worker(this);
+    worker->start();
+    _workers << worker;
+  }
+}
+
+// Destructor (running scripts are restarted detached, queued ones detached)
+////////////////////////////////////////////////////////////////////////////
+bncRotationService::~bncRotationService() {
+  _mutex.lock();
+  _stop = true;
+  _waitCond.wakeAll();
+  _mutex.unlock();
+  for (int ii = 0; ii < _workers.size(); ii++) {
+    _workers[ii]->wait();
+    delete _workers[ii];
+  }
+  for (int ii = 0; ii < _queue.size(); ii++) {
+    detach(_queue[ii]);
+  }
+}
+
+// Queue a File (does not block)
+////////////////////////////////////////////////////////////////////////////
+void bncRotationService::post(const QString& script, const QString& fileName) {
+
+  t_file file;
+  file._script   = script;
+  file._fileName = fileName;
+
+  QMutexLocker locker(&_mutex);
+
+  if (_stop) {
+    detach(file);
+    return;
+  }
+
+  for (int ii = 0; ii < _queue.size(); ii++) {
+    if (_queue[ii]._fileName == fileName && _queue[ii]._script == script) {
+      return;
+    }
+  }
+  _queue.append(file);
+  _waitCond.wakeOne();
+}
+
+// Worker Threads
+////////////////////////////////////////////////////////////////////////////
+void bncRotationService::work() {
+
+  QMutexLocker locker(&_mutex);
+
+  while (!_stop) {
+    if (_queue.isEmpty()) {
+      _waitCond.wait(&_mutex);
+      continue;
+    }
+    t_file file = _queue.takeFirst();
+    locker.unlock();
+    execute(file);
+    locker.relock();
+  }
+}
+
+// Shutdown requested
+////////////////////////////////////////////////////////////////////////////
+bool bncRotationService::stopped() {
+  QMutexLocker locker(&_mutex);
+  return _stop;
+}
+
+// Call the Script for one File and wait for it (script output goes to
+// the standard output and error of BNC)
+////////////////////////////////////////////////////////////////////////////
+void bncRotationService::execute(const t_file& file) {
+
+  QProcess process;
+  process.setProcessChannelMode(QProcess::ForwardedChannels);
+  process.start(file._script, QStringList() << file._fileName);
+  if (!process.waitForStarted()) {
+    emit newMessage(QString("Cannot start script %1 for %2")
+                    .arg(file._script).arg(QFileInfo(file._fileName).fileName())
+                    .toLatin1(), true);
+    return;
+  }
+
+  // Wait, but do not delay the shutdown of BNC
+  // ------------------------------------------
+  QElapsedTimer elapsed;
+  elapsed.start();
+  while (!process.waitForFinished(_pollInterval)) {
+    if (process.state() == QProcess::NotRunning) {
+      break;
+    }
+    if (stopped()) {
+      process.kill();
+      process.waitForFinished();
+      detach(file);
+      return;
+    }
+    if (elapsed.elapsed() >= _timeout) {
+      process.kill();
+      process.waitForFinished();
+      emit newMessage(QString("Script %1 for %2 killed after %3 s")
+                      .arg(file._script).arg(QFileInfo(file._fileName).fileName())
+                      .arg(_timeout / 1000).toLatin1(), true);
+      return;
+    }
+  }
+
+  if (process.exitStatus() != QProcess::NormalExit || process.exitCode() != 0) {
+    emit newMessage(QString("Script %1 for %2 failed, exit code %3")
+                    .arg(file._script).arg(QFileInfo(file._fileName).fileName())
+                    .arg(process.exitCode()).toLatin1(), false);
+  }
+}
+
+// Call the Script without waiting (used at shutdown)
+////////////////////////////////////////////////////////////////////////////
+void bncRotationService::detach(const t_file& file) const {
+#ifdef WIN32
+  QProcess::startDetached(file._script, QStringList() << file._fileName);
+#else
+  QProcess::startDetached("nohup", QStringList() << file._script << file._fileName);
+#endif
+}
@@ -0,0 +1,61 @@
+#ifndef BNCROTATIONSERVICE_H
+#define BNCROTATIONSERVICE_H
+
+#include <QByteArray>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QThread>
+#include <QWaitCondition>
+
+// Singleton Class
+// ---------------
+// Runs the script for finally saved (rotated) files. The streams only queue
+// the file names; a small pool of worker threads calls the script once per
+// file, so that at most a few scripts run at the same time even if many
+// files are closed at once. Files still queued at shutdown are handed to
+// detached script calls.
+class bncRotationService : public QObject {
+ Q_OBJECT
+ public:
+  static bncRotationService* instance();
+  void post(const QString& script, const QString& fileName);
+
+ signals:
+  void newMessage(QByteArray msg, bool showOnScreen);
+
+ private:
+  class t_worker : public QThread {
+   public:
+    t_worker(bncRotationService* service) {_service = service;}
+   protected:
+    virtual void run() {_service->work();}
+   private:
+    bncRotationService* _service;
+  };
+
+  class t_file {
+   public:
+    QString _script;
+    QString _fileName;
+  };
+
+  bncRotationService();
+  ~bncRotationService();
+  void work();
+  void execute(const t_file& file);
+  void detach(const t_file& file) const;
+
+  bool stopped();
+
+  static const int _timeout      = 900000; // [ms] script running longer is killed
+  static const int _pollInterval = 500;    // [ms] check for shutdown
+
+  QMutex           _mutex;
+  QWaitCondition   _waitCond;
+  QList<t_file>    _queue;
+  QList<t_worker*> _workers;
+  bool             _stop;
+};
+
+#endif
@@ -0,0 +1,223 @@
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      bncRtpBuffer
+ *
+ * Purpose:    Batched reading and sequence-number ordering of RTP packets
+ *
+ * Author:     BKG
+ *
+ * Created:    18-Oct-2026
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "bncrtpbuffer.h"
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncRtpBuffer::bncRtpBuffer() {
+  _datagram.resize(_maxSize);
+  _slots.resize(_window);
+  for (int ii = 0; ii < _window; ii++) {
+    _slots[ii].reserve(_maxSize);
+  }
+  _used.fill(false, _window);
+  _numLost       = 0;
+  _numReordered  = 0;
+  _numDuplicates = 0;
+  _numResyncs    = 0;
+  _resynced      = false;
+  _reported      = 0;
+  _reportTimer.start();
+  reset();
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+bncRtpBuffer::~bncRtpBuffer() {
+}
+
+// Forget the held-back packets (new session)
+////////////////////////////////////////////////////////////////////////////
+void bncRtpBuffer::reset() {
+  _used.fill(false);
+  _numBuffered = 0;
+  _initialized = false;
+  _expected    = 0;
+  _numBehind   = 0;
+}
+
+// Read all pending Datagrams, append the in-order payload to outData
+// (returns false if a datagram without payload has been received)
+////////////////////////////////////////////////////////////////////////////
+bool bncRtpBuffer::readDatagrams(QUdpSocket* socket, QByteArray& outData) {
+
+  bool allOK = true;
+
+  while (socket->hasPendingDatagrams()) {
+    qint64 size = socket->readDatagram(_datagram.data(), _maxSize);
+    if (size <= 12) {
+      allOK = false;
+      continue;
+    }
+    const unsigned char* header = (const unsigned char*) _datagram.constData();
+    unsigned short seq = (header[2] << 8) | header[3];
+    addPacket(seq, _datagram.constData() + 12, int(size - 12), outData);
+  }
+
+  releaseDelayed(outData);
+
+  return allOK;
+}
+
+// Give up waiting for a missing packet after maxDelay
+////////////////////////////////////////////////////////////////////////////
+void bncRtpBuffer::releaseDelayed(QByteArray& outData) {
+  while (_numBuffered > 0 && _gapTimer.elapsed() >= maxDelay) {
+    skipOne(outData);
+  }
+}
+
+// Loss and Reorder Counters (if changed and due)
+////////////////////////////////////////////////////////////////////////////
+bool bncRtpBuffer::report(QByteArray& msg) {
+  unsigned sum = _numLost + _numReordered + _numDuplicates;
+  if (sum == _reported || _reportTimer.elapsed() < reportInterval * 1000) {
+    return false;
+  }
+  _reported = sum;
+  _reportTimer.start();
+  msg = "RTP packets lost " + QByteArray::number(_numLost)
+      + ", reordered " + QByteArray::number(_numReordered)
+      + ", duplicate/late " + QByteArray::number(_numDuplicates);
+  return true;
+}
+
+// Sequence restart (once after it happened)
+////////////////////////////////////////////////////////////////////////////
+bool bncRtpBuffer::resynced(QByteArray& msg) {
+  if (!_resynced) {
+    return false;
+  }
+  _resynced = false;
+  msg = "RTP sequence restarted (" + QByteArray::number(_numResyncs) + " restarts)";
+  return true;
+}
+
+// Put a packet into the right place
+////////////////////////////////////////////////////////////////////////////
+void bncRtpBuffer::addPacket(unsigned short seq, const char* payload, int len,
+                             QByteArray& outData) {
+
+  if (!_initialized) {
+    _initialized = true;
+    _expected    = seq;
+  }
+
+  short dSeq = short(seq - _expected);
+
+  // Late (its gap has been given up already) or repeated packet; far
+  // behind or repeatedly behind means the sender has restarted
+  // -----------------------------------------------------------------
+  if (dSeq < 0) {
+    if (dSeq >= -_window && ++_numBehind <= _window) {
+      ++_numDuplicates;
+      return;
+    }
+    restart(seq, outData);
+    dSeq = 0;
+  }
+  _numBehind = 0;
+
+  // Too far ahead: give up the oldest gaps
+  // --------------------------------------
+  while (dSeq >= _window) {
+    skipOne(outData);
+    dSeq = short(seq - _expected);
+  }
+
+  // Expected packet: pass it on together with the held-back ones
+  // ------------------------------------------------------------
+  if (dSeq == 0) {
+    if (_numBuffered > 0) {
+      ++_numReordered;
+    }
+    outData.append(payload, len);
+    ++_expected;
+    while (_used[_expected % _window]) {
+      const QByteArray& slot = _slots[_expected % _window];
+      outData.append(slot.constData(), slot.size());
+      _used[_expected % _window] = false;
+      --_numBuffered;
+      ++_expected;
+    }
+    if (_numBuffered > 0) {
+      _gapTimer.start();
+    }
+    return;
+  }
+
+  // Packet ahead of a gap: hold it back
+  // -----------------------------------
+  int iSlot = seq % _window;
+  if (_used[iSlot]) {
+    ++_numDuplicates;
+    return;
+  }
+  QByteArray& slot = _slots[iSlot];
+  slot.resize(len);
+  memcpy(slot.data(), payload, len);
+  _used[iSlot] = true;
+  if (_numBuffered == 0) {
+    _gapTimer.start();
+  }
+  ++_numBuffered;
+}
+
+// Pass on the held-back packets and continue with seq
+////////////////////////////////////////////////////////////////////////////
+void bncRtpBuffer::restart(unsigned short seq, QByteArray& outData) {
+  for (int ii = 0; ii < _window && _numBuffered > 0; ii++) {
+    int iSlot = (_expected + ii) % _window;
+    if (_used[iSlot]) {
+      outData.append(_slots[iSlot].constData(), _slots[iSlot].size());
+      _used[iSlot] = false;
+      --_numBuffered;
+    }
+  }
+  _expected  = seq;
+  _numBehind = 0;
+  ++_numResyncs;
+  _resynced  = true;
+}
+
+// Skip the expected packet (lost) and pass on what follows it
+////////////////////////////////////////////////////////////////////////////
+void bncRtpBuffer::skipOne(QByteArray& outData) {
+  int iSlot = _expected % _window;
+  if (_used[iSlot]) {
+    const QByteArray& slot = _slots[iSlot];
+    outData.append(slot.constData(), slot.size());
+    _used[iSlot] = false;
+    --_numBuffered;
+  }
+  else {
+    ++_numLost;
+  }
+  ++_expected;
+  while (_used[_expected % _window]) {
+    int iNext = _expected % _window;
+    outData.append(_slots[iNext].constData(), _slots[iNext].size());
+    _used[iNext] = false;
+    --_numBuffered;
+    ++_expected;
+  }
+  if (_numBuffered > 0) {
+    _gapTimer.start();
+  }
+}
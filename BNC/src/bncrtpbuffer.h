@@ -0,0 +1,58 @@
+#ifndef BNCRTPBUFFER_H
+#define BNCRTPBUFFER_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QUdpSocket>
+#include <QVector>
+
+// Receive side of an RTP/UDP stream: reads all pending datagrams into
+// preallocated buffers and passes the payload on in sequence-number order.
+// Packets arriving ahead of a gap are held back until the gap is filled,
+// the window is exceeded, or the gap is older than maxDelay. A packet far
+// behind the expected one (or a run of such packets) restarts the sequence.
+class bncRtpBuffer {
+ public:
+  bncRtpBuffer();
+  ~bncRtpBuffer();
+
+  void reset();
+  bool readDatagrams(QUdpSocket* socket, QByteArray& outData);
+  void releaseDelayed(QByteArray& outData);
+  bool waiting() const {return _numBuffered > 0;}
+
+  unsigned numLost() const {return _numLost;}
+  unsigned numReordered() const {return _numReordered;}
+  unsigned numDuplicates() const {return _numDuplicates;}
+  bool     report(QByteArray& msg);
+  bool     resynced(QByteArray& msg);
+
+  static const int maxDelay = 200; // [ms]
+  static const int reportInterval = 60; // [s]
+
+ private:
+  void addPacket(unsigned short seq, const char* payload, int len, QByteArray& outData);
+  void skipOne(QByteArray& outData);
+  void restart(unsigned short seq, QByteArray& outData);
+
+  static const int _window  = 8;      // packets held back at most
+  static const int _maxSize = 65536;  // maximum datagram size
+
+  QByteArray          _datagram;
+  QVector<QByteArray> _slots;
+  QVector<bool>       _used;
+  int                 _numBuffered;
+  bool                _initialized;
+  unsigned short      _expected;
+  QElapsedTimer       _gapTimer;
+  unsigned            _numLost;
+  unsigned            _numReordered;
+  unsigned            _numDuplicates;
+  int                 _numBehind;  // consecutive packets behind the expected one
+  unsigned            _numResyncs;
+  bool                _resynced;   // not yet reported
+  QElapsedTimer       _reportTimer;
+  unsigned            _reported;  // sum of the counters at the last report
+};
+
+#endif
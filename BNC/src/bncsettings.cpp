@@ -82,6 +82,8 @@ void bncSettings::reRead() {
     setValue_p("onTheFlyInterval",    "no");
     setValue_p("autoStart",           "0");
     setValue_p("rawOutFile",          "");
+    setValue_p("outCommit",           "0");
+    setValue_p("outFsync",            "none");
     // RINEX Observations
     setValue_p("rnxPath",             "");
     setValue_p("rnxIntr",             "1 day");
@@ -90,6 +92,7 @@ void bncSettings::reRead() {
     setValue_p("rnxSkel",             "SKL");
     setValue_p("rnxV2Priority",       "");
     setValue_p("rnxScript",           "");
+    setValue_p("rnxScriptThreads",    "4");
     setValue_p("rnxV3",               "0");
     setValue_p("rnxV3filenames",      "0");
     // RINEX Ephemeris
@@ -139,6 +142,7 @@ void bncSettings::reRead() {
     // Braodcast Corrections
     setValue_p("corrPath",            "");
     setValue_p("corrIntr",            "1 day");
+    setValue_p("corrFormat",          "ASCII");
     setValue_p("corrPort",            "");
     // Feed Engine
     setValue_p("outPort",             "");
@@ -174,6 +178,9 @@ void bncSettings::reRead() {
     setValue_p("cmbMaxres",           "");
     setValue_p("cmbSampl",            "10");
     setValue_p("cmbUseGlonass",       "");
+    setValue_p("cmbUseGalileo",       "");
+    setValue_p("cmbUseBDS",           "");
+    setValue_p("cmbUseQZSS",          "");
     // Upload (clk)
     setValue_p("uploadMountpointsOut","");
     setValue_p("uploadIntr",          "1 day");
@@ -235,6 +235,8 @@ void bncSinexTro::writeHeader(const QDateTime& datTim) {
 t_irc bncSinexTro::write(QByteArray staID, int GPSWeek, double GPSWeeks,
     double trotot, double stdev) {
 
+  QMutexLocker locker(&_mutex);
+
   QDateTime datTim = dateAndTimeFromGPSweek(GPSWeek, GPSWeeks);
   int daysec    = int(fmod(GPSWeeks, 86400.0));
   int dayOfYear = datTim.date().dayOfYear();
@@ -247,8 +249,7 @@ t_irc bncSinexTro::write(QByteArray staID, int GPSWeek, double GPSWeeks,
       (fmod(daysec, double(_sampl)) == 0.0)) {
     _out << ' '  << staID.left(4).data() << ' ' << time.toStdString() << ' '
          << noshowpos << setw(6) << setprecision(1) << trotot * 1000.0
-         << noshowpos << setw(6) << setprecision(1) << stdev  * 1000.0 << endl;
-    _out.flush();
+         << noshowpos << setw(6) << setprecision(1) << stdev  * 1000.0 << '\n';
     return success;
   }  else {
     return failure;
@@ -258,6 +259,7 @@ t_irc bncSinexTro::write(QByteArray staID, int GPSWeek, double GPSWeeks,
 // Close File (write last lines)
 ////////////////////////////////////////////////////////////////////////////
 void bncSinexTro::closeFile() {
+  QMutexLocker locker(&_mutex);
   _out << "-TROP/SOLUTION" << endl;
   _out << "%=ENDTROP" << endl;
   bncoutf::closeFile();
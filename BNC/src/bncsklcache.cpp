@@ -0,0 +1,297 @@
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      bncSklCache
+ *
+ * Purpose:    Shared, persistent cache of skeleton headers and sourcetables
+ *
+ * Author:     BKG
+ *
+ * Created:    18-Oct-2026
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegExp>
+#include <QTextStream>
+
+#include "bncsklcache.h"
+#include "bnccore.h"
+#include "bncnetqueryv2.h"
+#include "bnctabledlg.h"
+
+// Shared Instance
+////////////////////////////////////////////////////////////////////////////
+bncSklCache* bncSklCache::instance() {
+  static bncSklCache _bncSklCache;
+  return &_bncSklCache;
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncSklCache::bncSklCache() {
+  _stop = false;
+  _dir  = QDir::homePath() + QDir::separator()
+        + ".config" + QDir::separator()
+        + qApp->organizationName() + QDir::separator() + "skl";
+  QDir().mkpath(_dir);
+  connect(this, SIGNAL(newMessage(QByteArray,bool)),
+          BNC_CORE, SLOT(slotMessage(const QByteArray,bool)));
+  for (int ii = 0; ii < _numWorkers; ii++) {
+    t_worker* worker = new t_worker(this);
+    worker->start();
+    _workers << worker;
+  }
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+bncSklCache::~bncSklCache() {
+  _mutex.lock();
+  _stop = true;
+  _waitCond.wakeAll();
+  _fetched.wakeAll();
+  _mutex.unlock();
+  for (int ii = 0; ii < _workers.size(); ii++) {
+    _workers[ii]->wait();
+    delete _workers[ii];
+  }
+}
+
+// Download the Skeleton in the Background (does not block)
+////////////////////////////////////////////////////////////////////////////
+void bncSklCache::prefetch(const QUrl& mountPoint, const QByteArray& ntripVersion) {
+  QMutexLocker locker(&_mutex);
+  t_skeleton& skl = entry(mountPoint, ntripVersion);
+  if (!skl._fetched.isValid() ||
+      skl._fetched.secsTo(QDateTime::currentDateTime()) > _sklTTL) {
+    enqueue(key(mountPoint), skl);
+  }
+}
+
+// Skeleton of a Stream; waits only if nothing is known about it yet
+////////////////////////////////////////////////////////////////////////////
+t_irc bncSklCache::skeleton(const QUrl& mountPoint, const QByteArray& ntripVersion,
+                            QByteArray& sklData) {
+
+  QMutexLocker locker(&_mutex);
+
+  QString hlpKey = key(mountPoint);
+  t_skeleton& skl = entry(mountPoint, ntripVersion);
+
+  if (!skl._fetched.isValid() ||
+      skl._fetched.secsTo(QDateTime::currentDateTime()) > _sklTTL) {
+    enqueue(hlpKey, skl);
+  }
+  while (!skl._fetched.isValid() && skl._pending && !_stop) {
+    _fetched.wait(&_mutex);
+  }
+
+  sklData = skl._data;
+  return sklData.isEmpty() ? failure : success;
+}
+
+// Key of a Stream
+////////////////////////////////////////////////////////////////////////////
+QString bncSklCache::key(const QUrl& mountPoint) const {
+  return mountPoint.host() + ":" + QString::number(mountPoint.port()) + mountPoint.path();
+}
+
+// Skeleton Entry, read from disk the first time (requires _mutex)
+////////////////////////////////////////////////////////////////////////////
+bncSklCache::t_skeleton& bncSklCache::entry(const QUrl& mountPoint,
+                                            const QByteArray& ntripVersion) {
+  QString hlpKey = key(mountPoint);
+  if (!_skeletons.contains(hlpKey)) {
+    t_skeleton skl;
+    skl._mountPoint   = mountPoint;
+    skl._ntripVersion = ntripVersion;
+    QFile file(fileName(hlpKey));
+    if (file.open(QIODevice::ReadOnly)) {
+      skl._data    = file.readAll();
+      skl._fetched = QFileInfo(file).lastModified();
+    }
+    _skeletons[hlpKey] = skl;
+  }
+  return _skeletons[hlpKey];
+}
+
+// Queue a Download unless it is queued already (requires _mutex)
+////////////////////////////////////////////////////////////////////////////
+void bncSklCache::enqueue(const QString& key, t_skeleton& skl) {
+  if (skl._pending) {
+    return;
+  }
+  skl._pending = true;
+  _queue.append(key);
+  _waitCond.wakeOne();
+}
+
+// Worker Threads
+////////////////////////////////////////////////////////////////////////////
+void bncSklCache::work() {
+
+  QMutexLocker locker(&_mutex);
+
+  while (!_stop) {
+    if (_queue.isEmpty()) {
+      _waitCond.wait(&_mutex);
+      continue;
+    }
+    QString    hlpKey       = _queue.takeFirst();
+    QUrl       mountPoint   = _skeletons[hlpKey]._mountPoint;
+    QByteArray ntripVersion = _skeletons[hlpKey]._ntripVersion;
+    locker.unlock();
+
+    QByteArray sklData;
+    t_irc irc = download(mountPoint, ntripVersion, sklData);
+    if (irc == success) {
+      QFile file(fileName(hlpKey));
+      if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        file.write(sklData);
+      }
+    }
+
+    // A failed refresh keeps the previous skeleton
+    // --------------------------------------------
+    locker.relock();
+    t_skeleton& skl = _skeletons[hlpKey];
+    skl._pending = false;
+    if (irc == success) {
+      skl._data    = sklData;
+      skl._fetched = QDateTime::currentDateTime();
+    }
+    else {
+      emit newMessage(hlpKey.toLatin1() + ": Skeleton download failed", false);
+    }
+    _fetched.wakeAll();
+  }
+}
+
+// Download the Skeleton of a Stream (success with empty data if the caster
+// publishes none)
+////////////////////////////////////////////////////////////////////////////
+t_irc bncSklCache::download(const QUrl& mountPoint, const QByteArray& ntripVersion,
+                            QByteArray& sklData) {
+
+  sklData.clear();
+
+  QStringList table;
+  if (sourcetable(mountPoint, ntripVersion, table) != success) {
+    return failure;
+  }
+
+  QString net;
+  QStringListIterator it(table);
+  while (it.hasNext()) {
+    QString line = it.next();
+    if (line.indexOf("STR") == 0) {
+      QStringList tags = line.split(";");
+      if (tags.size() > 7) {
+        if (tags.at(1) == mountPoint.path().mid(1).toLatin1()) {
+          net = tags.at(7);
+          break;
+        }
+      }
+    }
+  }
+  QString sklDir;
+  if (!net.isEmpty()) {
+    it.toFront();
+    while (it.hasNext()) {
+      QString line = it.next();
+      if (line.indexOf("NET") == 0) {
+        QStringList tags = line.split(";");
+        if (tags.size() > 6) {
+          if (tags.at(1) == net) {
+            sklDir = tags.at(6).trimmed();
+            break;
+          }
+        }
+      }
+    }
+  }
+  if (sklDir.isEmpty() || sklDir == "none") {
+    return success;
+  }
+
+  QUrl url(sklDir + "/" + mountPoint.path().mid(1,4).toLower() + ".skl");
+  if (url.port() == -1) {
+    if (sklDir.contains("https", Qt::CaseInsensitive)) {
+      url.setPort(443);
+    }
+    else {
+      url.setPort(80);
+    }
+  }
+
+  bncNetQuery* query = new bncNetQueryV2(true);
+  QByteArray outData;
+  query->waitForRequestResult(url, outData);
+  t_irc irc = failure;
+  if (query->status() == bncNetQuery::finished) {
+    if (outData.contains("END OF HEADER")) {
+      sklData = outData;
+    }
+    irc = success;
+  }
+  delete query;
+
+  return irc;
+}
+
+// Sourcetable of the Caster, downloaded once for all its streams
+////////////////////////////////////////////////////////////////////////////
+t_irc bncSklCache::sourcetable(const QUrl& mountPoint, const QByteArray& ntripVersion,
+                               QStringList& lines) {
+
+  QString hlpKey = mountPoint.host() + ":" + QString::number(mountPoint.port());
+
+  QMutexLocker locker(&_mutex);
+
+  while (_tables[hlpKey]._pending && !_stop) {
+    _fetched.wait(&_mutex);
+  }
+  t_table& table = _tables[hlpKey];
+  if (table._fetched.isValid() &&
+      table._fetched.secsTo(QDateTime::currentDateTime()) <= _tableTTL) {
+    lines = table._lines;
+    return success;
+  }
+
+  table._pending = true;
+  locker.unlock();
+
+  QStringList allLines;
+  t_irc irc = bncTableDlg::getFullTable(ntripVersion, mountPoint.host(),
+                                        mountPoint.port(), allLines, true);
+
+  // An outdated table is better than none
+  // -------------------------------------
+  locker.relock();
+  t_table& hlpTable = _tables[hlpKey];
+  hlpTable._pending = false;
+  if (irc == success) {
+    hlpTable._lines   = allLines;
+    hlpTable._fetched = QDateTime::currentDateTime();
+  }
+  _fetched.wakeAll();
+  if (irc == success || hlpTable._fetched.isValid()) {
+    lines = hlpTable._lines;
+    return success;
+  }
+  return failure;
+}
+
+// Cache File of a Skeleton
+////////////////////////////////////////////////////////////////////////////
+QString bncSklCache::fileName(const QString& key) const {
+  QString name = key;
+  name.replace(QRegExp("[^A-Za-z0-9._-]"), "_");
+  return _dir + QDir::separator() + name + ".skl";
+}
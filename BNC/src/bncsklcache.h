@@ -0,0 +1,89 @@
+#ifndef BNCSKLCACHE_H
+#define BNCSKLCACHE_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QStringList>
+#include <QThread>
+#include <QUrl>
+#include <QWaitCondition>
+
+#include "bncconst.h"
+
+// Singleton Class
+// ---------------
+// Skeleton headers of the streams and the sourcetables of their casters,
+// shared by all streams. Downloads run in a few worker threads, one per
+// skeleton and caster at a time. Skeletons are kept on disk and used
+// within their lifetime without network access; an expired skeleton is
+// still returned while a worker refreshes it.
+class bncSklCache : public QObject {
+ Q_OBJECT
+ public:
+  static bncSklCache* instance();
+  void  prefetch(const QUrl& mountPoint, const QByteArray& ntripVersion);
+  t_irc skeleton(const QUrl& mountPoint, const QByteArray& ntripVersion,
+                 QByteArray& sklData);
+
+ signals:
+  void newMessage(QByteArray msg, bool showOnScreen);
+
+ private:
+  class t_worker : public QThread {
+   public:
+    t_worker(bncSklCache* cache) {_cache = cache;}
+   protected:
+    virtual void run() {_cache->work();}
+   private:
+    bncSklCache* _cache;
+  };
+
+  class t_skeleton {
+   public:
+    t_skeleton() {_pending = false;}
+    QUrl       _mountPoint;
+    QByteArray _ntripVersion;
+    QByteArray _data;     // empty: the caster publishes no skeleton
+    QDateTime  _fetched;  // invalid: nothing known yet
+    bool       _pending;
+  };
+
+  class t_table {
+   public:
+    t_table() {_pending = false;}
+    QStringList _lines;
+    QDateTime   _fetched;
+    bool        _pending;
+  };
+
+  bncSklCache();
+  ~bncSklCache();
+  QString     key(const QUrl& mountPoint) const;
+  t_skeleton& entry(const QUrl& mountPoint, const QByteArray& ntripVersion);
+  void        enqueue(const QString& key, t_skeleton& skl);
+  void        work();
+  t_irc       download(const QUrl& mountPoint, const QByteArray& ntripVersion,
+                       QByteArray& sklData);
+  t_irc       sourcetable(const QUrl& mountPoint, const QByteArray& ntripVersion,
+                          QStringList& lines);
+  QString     fileName(const QString& key) const;
+
+  static const int _numWorkers = 4;
+  static const int _sklTTL     = 86400; // [s]
+  static const int _tableTTL   = 3600;  // [s]
+
+  QMutex                     _mutex;
+  QWaitCondition             _waitCond;  // skeletons queued
+  QWaitCondition             _fetched;   // a download has finished
+  QMap<QString, t_skeleton>  _skeletons;
+  QMap<QString, t_table>     _tables;
+  QList<QString>             _queue;
+  QList<t_worker*>           _workers;
+  QString                    _dir;
+  bool                       _stop;
+};
+
+#endif
@@ -65,6 +65,8 @@ bncSP3::~bncSP3() {
 t_irc bncSP3::write(int GPSweek, double GPSweeks, const QString& prn,
                     const ColumnVector& xCoM, double sp3Clk) {
 
+  QMutexLocker locker(&_mutex);
+
   if (reopen(GPSweek, GPSweeks) == success) {
 
     bncTime epoTime(GPSweek, GPSweeks);
@@ -75,13 +77,13 @@ t_irc bncSP3::write(int GPSweek, double GPSweeks, const QString& prn,
       // ------------------------------------------------
       if (_lastEpoTime.valid() && _sampl > 0) {
         for (bncTime ep = _lastEpoTime +_sampl; ep < epoTime; ep = ep +_sampl) {
-          _out << "*  " << ep.datestr(' ') << ' ' << ep.timestr(8, ' ') << endl;
+          _out << "*  " << ep.datestr(' ') << ' ' << ep.timestr(8, ' ') << '\n';
         }
       }
 
       // Print the new epoch
       // -------------------
-      _out << "*  " << epoTime.datestr(' ') << ' ' << epoTime.timestr(8, ' ') << endl;
+      _out << "*  " << epoTime.datestr(' ') << ' ' << epoTime.timestr(8, ' ') << '\n';
 
       _lastEpoTime = epoTime;
     }
@@ -90,7 +92,7 @@ t_irc bncSP3::write(int GPSweek, double GPSweeks, const QString& prn,
          << setw(14) << setprecision(6) << xCoM(1) / 1000.0
          << setw(14) << setprecision(6) << xCoM(2) / 1000.0
          << setw(14) << setprecision(6) << xCoM(3) / 1000.0
-         << setw(14) << setprecision(6) << sp3Clk * 1e6 << endl;
+         << setw(14) << setprecision(6) << sp3Clk * 1e6 << '\n';
 
     return success;
   }
@@ -102,6 +104,7 @@ t_irc bncSP3::write(int GPSweek, double GPSweeks, const QString& prn,
 // Close File (write last line)
 ////////////////////////////////////////////////////////////////////////////
 void bncSP3::closeFile() {
+  QMutexLocker locker(&_mutex);
   _out << "EOF" << endl;
   bncoutf::closeFile();
 }
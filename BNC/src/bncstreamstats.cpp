@@ -0,0 +1,107 @@
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      bncStreamCounters, bncStreamStats
+ *
+ * Purpose:    Per-stream throughput and latency counters sampled by the GUI
+ *
+ * Author:     BKG
+ *
+ * Created:    18-Oct-2026
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include <math.h>
+
+#include "bncstreamstats.h"
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncStreamCounters::bncStreamCounters() {
+  _bytes   = 0;
+  _chunks  = 0;
+  _latency = -1;
+  for (int iBin = 0; iBin < numBins; iBin++) {
+    _hist[iBin] = 0;
+  }
+}
+
+// Upper Limit of a Histogram Bin
+////////////////////////////////////////////////////////////////////////////
+int bncStreamCounters::binLimit(int iBin) {
+  static const int limits[numBins-1] = {100, 200, 500, 1000, 2000, 5000,
+                                        10000, 30000, 60000};
+  if (iBin < numBins-1) {
+    return limits[iBin];
+  }
+  return -1;
+}
+
+// Latest Latency, counted in the histogram whenever it changes
+////////////////////////////////////////////////////////////////////////////
+void bncStreamCounters::setLatency(double latency) {
+  qint64 latMs = qint64(fabs(latency) * 1000.0 + 0.5);
+  if (_latency.exchange(latMs, std::memory_order_relaxed) == latMs) {
+    return;
+  }
+  int iBin = 0;
+  while (iBin < numBins-1 && latMs >= binLimit(iBin)) {
+    ++iBin;
+  }
+  _hist[iBin].fetch_add(1, std::memory_order_relaxed);
+}
+
+// Latest Latency [s] (negative if none yet)
+////////////////////////////////////////////////////////////////////////////
+double bncStreamCounters::latency() const {
+  qint64 latMs = _latency.load(std::memory_order_relaxed);
+  if (latMs < 0) {
+    return -1.0;
+  }
+  return latMs / 1000.0;
+}
+
+// Copy of the Latency Histogram
+////////////////////////////////////////////////////////////////////////////
+void bncStreamCounters::latencyHistogram(QVector<quint64>& hist) const {
+  hist.resize(numBins);
+  for (int iBin = 0; iBin < numBins; iBin++) {
+    hist[iBin] = _hist[iBin].load(std::memory_order_relaxed);
+  }
+}
+
+// Shared Instance
+////////////////////////////////////////////////////////////////////////////
+bncStreamStats* bncStreamStats::instance() {
+  static bncStreamStats _bncStreamStats;
+  return &_bncStreamStats;
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+bncStreamStats::bncStreamStats() {
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+bncStreamStats::~bncStreamStats() {
+  QMapIterator<QByteArray, bncStreamCounters*> it(_counters);
+  while (it.hasNext()) {
+    delete it.next().value();
+  }
+}
+
+// Counters of a Stream (created on first request)
+////////////////////////////////////////////////////////////////////////////
+bncStreamCounters* bncStreamStats::counters(const QByteArray& staID) {
+  QMutexLocker locker(&_mutex);
+  bncStreamCounters* cnt = _counters.value(staID, 0);
+  if (!cnt) {
+    cnt = new bncStreamCounters();
+    _counters[staID] = cnt;
+  }
+  return cnt;
+}
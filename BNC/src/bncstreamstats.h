@@ -0,0 +1,54 @@
+#ifndef BNCSTREAMSTATS_H
+#define BNCSTREAMSTATS_H
+
+#include <atomic>
+#include <QByteArray>
+#include <QMap>
+#include <QMutex>
+#include <QVector>
+
+// Counters of one incoming stream. They are updated in place by the get
+// thread and read by the GUI at its own rate; no locking involved.
+class bncStreamCounters {
+ public:
+  bncStreamCounters();
+
+  void addChunk(qint64 nBytes) {
+    _bytes.fetch_add(quint64(nBytes), std::memory_order_relaxed);
+    _chunks.fetch_add(1, std::memory_order_relaxed);
+  }
+  void setLatency(double latency);
+
+  quint64 bytes() const  {return _bytes.load(std::memory_order_relaxed);}
+  quint64 chunks() const {return _chunks.load(std::memory_order_relaxed);}
+  double  latency() const; // [s]
+  void    latencyHistogram(QVector<quint64>& hist) const;
+
+  static const int numBins = 10;
+  static int       binLimit(int iBin); // upper limit of bin [ms], -1 for the last one
+
+ private:
+  std::atomic<quint64> _bytes;
+  std::atomic<quint64> _chunks;
+  std::atomic<qint64>  _latency; // [ms]
+  std::atomic<quint64> _hist[numBins];
+};
+
+// Singleton Class
+// ---------------
+// Counters of all streams by station ID. They live as long as the program,
+// so pointers handed out stay valid after the get thread has finished.
+class bncStreamStats {
+ public:
+  static bncStreamStats* instance();
+  bncStreamCounters*     counters(const QByteArray& staID);
+
+ private:
+  bncStreamStats();
+  ~bncStreamStats();
+
+  QMutex                                _mutex;
+  QMap<QByteArray, bncStreamCounters*>  _counters;
+};
+
+#endif
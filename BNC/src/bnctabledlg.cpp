@@ -203,6 +203,8 @@ t_irc bncTableDlg::getFullTable(const QString& ntripVersion,
   static QMutex mutex;
   static QMap<QString, QStringList> allTables;
 
+  // The lock guards the stored tables only, casters are read in parallel
+  // --------------------------------------------------------------------
   QMutexLocker locker(&mutex);
 
   if (!alwaysRead && allTables.find(casterHost) != allTables.end()) {
@@ -210,6 +212,8 @@ t_irc bncTableDlg::getFullTable(const QString& ntripVersion,
     return success;
   }
 
+  locker.unlock();
+
   allLines.clear();
 
   bncNetQuery* query = 0;
@@ -243,6 +247,7 @@ t_irc bncTableDlg::getFullTable(const QString& ntripVersion,
       allLines.append(line);
       line = in.readLine();
     }
+    locker.relock();
     allTables.insert(casterHost, allLines);
     delete query;
     return success;
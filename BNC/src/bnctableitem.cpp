@@ -38,8 +38,11 @@
  *
  * -----------------------------------------------------------------------*/
 
+#include <QTimer>
+
 #include "bnctableitem.h"
 #include "bncgetthread.h"
+#include "bncstreamstats.h"
 
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
@@ -47,6 +50,8 @@ bncTableItem::bncTableItem() : QTableWidgetItem() {
   _bytesRead = 0.0;
   setText(QString("%1 byte(s)").arg(0));
   _getThread = 0;
+  _counters  = 0;
+  _bytesBase = 0;
 }
 
 // Destructor
@@ -56,12 +61,7 @@ bncTableItem::~bncTableItem() {
 
 // 
 ////////////////////////////////////////////////////////////////////////////
-void bncTableItem::slotNewBytes(const QByteArray, double nbyte) {
-
-  QMutexLocker locker(&_mutex);
-
-  _bytesRead += nbyte;
-
+void bncTableItem::showBytes() {
   if      (_bytesRead < 1e3) {
     setText(QString("%1 byte(s)").arg((int)_bytesRead));
   }
@@ -77,6 +77,26 @@ void bncTableItem::slotNewBytes(const QByteArray, double nbyte) {
 ////////////////////////////////////////////////////////////////////////////
 void bncTableItem::setGetThread(bncGetThread* getThread) {
   _getThread = getThread;
-  connect(_getThread, SIGNAL(newBytes(QByteArray, double)),
-          this, SLOT(slotNewBytes(QByteArray, double)));
+  setCounters(bncStreamStats::instance()->counters(getThread->staID()));
+}
+
+// Counters to show (may be called from any thread)
+////////////////////////////////////////////////////////////////////////////
+void bncTableItem::setCounters(bncStreamCounters* counters) {
+  QMutexLocker locker(&_mutex);
+  bool started = (_counters != 0);
+  _counters  = counters;
+  _bytesBase = _counters->bytes();
+  if (!started) {
+    QMetaObject::invokeMethod(this, "slotSampleCounters", Qt::QueuedConnection);
+  }
+}
+
+// Bytes received or sent by the stream (sampled once a second)
+////////////////////////////////////////////////////////////////////////////
+void bncTableItem::slotSampleCounters() {
+  QMutexLocker locker(&_mutex);
+  _bytesRead = double(_counters->bytes() - _bytesBase);
+  showBytes();
+  QTimer::singleShot(1000, this, SLOT(slotSampleCounters()));
 }
@@ -30,6 +30,7 @@
 #include <QTableWidgetItem>
 
 class bncGetThread;
+class bncStreamCounters;
 
 class bncTableItem : public QObject, public QTableWidgetItem {
   Q_OBJECT
@@ -39,16 +40,20 @@ class bncTableItem : public QObject, public QTableWidgetItem {
     ~bncTableItem();
     void setGetThread(bncGetThread* getThread);
     bncGetThread* getThread() {return _getThread;}
+    void setCounters(bncStreamCounters* counters);
 
   signals:
  
-  public slots:
-    void slotNewBytes(const QByteArray staID, double nbyte);
+  private slots:
+    void slotSampleCounters();
 
   private:
+    void showBytes();
     double _bytesRead;
     QMutex _mutex;
     bncGetThread* _getThread;
+    bncStreamCounters* _counters;
+    quint64            _bytesBase;
 };
 
 #endif
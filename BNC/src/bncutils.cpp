@@ -249,13 +249,19 @@ QDateTime currentDateAndTimeGPS() {
 //
 ////////////////////////////////////////////////////////////////////////////
 bool checkForWrongObsEpoch(bncTime obsEpoch) {
-  const double maxDt = 600.0;
-  long iSec    = long(floor(obsEpoch.gpssec()+0.5));
-  long obsTime = obsEpoch.gpsw()*7*24*3600 + iSec;
   int    week;
   double sec;
   currentGPSWeeks(week, sec);
-  long currTime = week * 7*24*3600 + long(sec);
+  return checkForWrongObsEpoch(obsEpoch, week, sec);
+}
+
+// Same, with the current GPS time given by the caller
+////////////////////////////////////////////////////////////////////////////
+bool checkForWrongObsEpoch(bncTime obsEpoch, int currWeek, double currSec) {
+  const double maxDt = 600.0;
+  long iSec    = long(floor(obsEpoch.gpssec()+0.5));
+  long obsTime = obsEpoch.gpsw()*7*24*3600 + iSec;
+  long currTime = currWeek * 7*24*3600 + long(currSec);
 
   if (fabs(currTime - obsTime) > maxDt) {
     return true;
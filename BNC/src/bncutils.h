@@ -64,6 +64,8 @@ QDateTime    currentDateAndTimeGPS();
 
 bool         checkForWrongObsEpoch(bncTime obsEpoch);
 
+bool         checkForWrongObsEpoch(bncTime obsEpoch, int currWeek, double currSec);
+
 QByteArray   ggaString(const QByteArray& latitude, const QByteArray& longitude,
                        const QByteArray& height, const QString& ggaType);
 
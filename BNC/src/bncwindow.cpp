@@ -84,6 +84,7 @@
 #include "qtfilechooser.h"
 #include "reqcdlg.h"
 #include "bncmap.h"
+#include "bncnettransport.h"
 #include "rinex/reqcedit.h"
 #include "rinex/reqcanalyze.h"
 #include "orbComp/sp3Comp.h"
@@ -474,6 +475,12 @@ bncWindow::bncWindow() {
   _cmbMaxresLineEdit = new QLineEdit(settings.value("cmbMaxres").toString());
   _cmbUseGlonass     = new QCheckBox();
   _cmbUseGlonass->setCheckState(Qt::CheckState(settings.value("cmbUseGlonass").toInt()));
+  _cmbUseGalileo     = new QCheckBox();
+  _cmbUseGalileo->setCheckState(Qt::CheckState(settings.value("cmbUseGalileo").toInt()));
+  _cmbUseBDS         = new QCheckBox();
+  _cmbUseBDS->setCheckState(Qt::CheckState(settings.value("cmbUseBDS").toInt()));
+  _cmbUseQZSS        = new QCheckBox();
+  _cmbUseQZSS->setCheckState(Qt::CheckState(settings.value("cmbUseQZSS").toInt()));
 
   _cmbSamplSpinBox = new QSpinBox;
   _cmbSamplSpinBox->setMinimum(10);
@@ -503,12 +510,18 @@ bncWindow::bncWindow() {
     enableWidget(true, _cmbMaxresLineEdit);
     enableWidget(true, _cmbSamplSpinBox);
     enableWidget(true, _cmbUseGlonass);
+    enableWidget(true, _cmbUseGalileo);
+    enableWidget(true, _cmbUseBDS);
+    enableWidget(true, _cmbUseQZSS);
   }
   else {
     enableWidget(false, _cmbMethodComboBox);
     enableWidget(false, _cmbMaxresLineEdit);
     enableWidget(false, _cmbSamplSpinBox);
     enableWidget(false, _cmbUseGlonass);
+    enableWidget(false, _cmbUseGalileo);
+    enableWidget(false, _cmbUseBDS);
+    enableWidget(false, _cmbUseQZSS);
   }
 
   // Upload Results
@@ -1219,7 +1232,13 @@ bncWindow::bncWindow() {
   cmbLayout->addWidget(_cmbSamplSpinBox,                                     5, 7);
   cmbLayout->addWidget(new QLabel("   Use GLONASS"),                         6, 6, Qt::AlignRight);
   cmbLayout->addWidget(_cmbUseGlonass,                                       6, 7);
-  cmbLayout->setRowStretch(7, 999);
+  cmbLayout->addWidget(new QLabel("   Use Galileo"),                         6, 8, Qt::AlignRight);
+  cmbLayout->addWidget(_cmbUseGalileo,                                       6, 9);
+  cmbLayout->addWidget(new QLabel("   Use BDS"),                             7, 6, Qt::AlignRight);
+  cmbLayout->addWidget(_cmbUseBDS,                                           7, 7);
+  cmbLayout->addWidget(new QLabel("   Use QZSS"),                            7, 8, Qt::AlignRight);
+  cmbLayout->addWidget(_cmbUseQZSS,                                          7, 9);
+  cmbLayout->setRowStretch(8, 999);
 
   connect(addCmbRowButton, SIGNAL(clicked()), this, SLOT(slotAddCmbRow()));
   connect(delCmbRowButton, SIGNAL(clicked()), this, SLOT(slotDelCmbRow()));
@@ -1448,6 +1467,9 @@ bncWindow::bncWindow() {
   _cmbMaxresLineEdit->setWhatsThis(tr("<p>BNC combines all incoming clocks according to specified weights. Individual clock estimates that differ by more than 'Maximal residuum' meters from the average of all clocks will be ignored.<p></p>It is suggested to specify a value of about 0.2 m for the Kalman filter combination approach and a value of about 3.0 meters for the Single-Epoch combination approach.</p><p>Default is a value of '999.0'. <i>[key: cmbMaxres]</i></p>"));
   _cmbSamplSpinBox->setWhatsThis(tr("<p>Select a combination Sampling interval for the clocks. Clock corrections will be produced following that interval.</p><p>A value of 10 sec may be an appropriate choice. <i>[key: cmbSampl]</i></p>"));
   _cmbUseGlonass->setWhatsThis(tr("<p>In case the incoming orbit and clock correction stream(s) support GLONASS, you can tick 'Use GLONASS' to produce a GPS plus GLONASS combination solution.</p><p>Default is a GPS-only combination. <i>[key: cmbUseGlonass]</i></p>"));
+  _cmbUseGalileo->setWhatsThis(tr("<p>Tick 'Use Galileo' to include Galileo satellites in the combination. Each satellite system is combined in its own block of parameters. <i>[key: cmbUseGalileo]</i></p>"));
+  _cmbUseBDS->setWhatsThis(tr("<p>Tick 'Use BDS' to include BDS satellites in the combination. <i>[key: cmbUseBDS]</i></p>"));
+  _cmbUseQZSS->setWhatsThis(tr("<p>Tick 'Use QZSS' to include QZSS satellites in the combination. <i>[key: cmbUseQZSS]</i></p>"));
 
   // WhatsThis, Upload Corrections
   // -----------------------------
@@ -1481,7 +1503,7 @@ bncWindow::bncWindow() {
   // ---------------------
   _log->setWhatsThis(tr("<p>Records of BNC's activities are shown in the 'Log' tab. The message log covers the communication status between BNC and the Ntrip Broadcaster as well as problems that occur in the communication link, stream availability, stream delay, stream conversion etc.</p>"));
   _bncFigure->setWhatsThis(tr("<p>The bandwidth consumption per stream is shown in the 'Throughput' tab in bits per second (bps) or kilobits per second (kbps).</p>"));
-  _bncFigureLate->setWhatsThis(tr("<p>The individual latency of observations of incoming streams is shown in the 'Latency' tab. Streams not carrying observations (e.g. those providing only Broadcast Ephemeris) remain unconsidered.</p><p>Note that the calculation of correct latencies requires the clock of the host computer to be properly synchronized.</p>"));
+  _bncFigureLate->setWhatsThis(tr("<p>The individual latency of observations of incoming streams is shown in the 'Latency' tab. Streams not carrying observations (e.g. those providing only Broadcast Ephemeris) remain unconsidered. A short line above a bar marks the latency below which 95% of the latencies since the last update have been.</p><p>Note that the calculation of correct latencies requires the clock of the host computer to be properly synchronized.</p>"));
   _bncFigurePPP->setWhatsThis(tr("<p>PPP time series of North (red), East (green) and Up (blue) displacements are shown in the 'PPP Plot' tab when the corresponding option is selected.</p><p>Values are referred to an XYZ a priori coordinate. The sliding PPP time series window covers the period of the latest 5 minutes.</p>"));
 
 
@@ -1576,6 +1598,9 @@ bncWindow::~bncWindow() {
   _cmbTable->deleteLater();
   delete _cmbMaxresLineEdit;
   delete _cmbUseGlonass;
+  delete _cmbUseGalileo;
+  delete _cmbUseBDS;
+  delete _cmbUseQZSS;
   delete _cmbSamplSpinBox;
   delete _cmbMethodComboBox;;
   _uploadEphTable->deleteLater();
@@ -2059,6 +2084,9 @@ void bncWindow::saveOptions() {
   settings.setValue("cmbMaxres",     _cmbMaxresLineEdit->text());
   settings.setValue("cmbSampl",      _cmbSamplSpinBox->value());
   settings.setValue("cmbUseGlonass", _cmbUseGlonass->checkState());
+  settings.setValue("cmbUseGalileo", _cmbUseGalileo->checkState());
+  settings.setValue("cmbUseBDS",     _cmbUseBDS->checkState());
+  settings.setValue("cmbUseQZSS",    _cmbUseQZSS->checkState());
 // Upload Corrections
   if (!uploadMountpointsOut.isEmpty()) {
     settings.setValue("uploadMountpointsOut", uploadMountpointsOut);
@@ -2086,6 +2114,8 @@ void bncWindow::saveOptions() {
     _caster->readMountPoints();
   }
 
+  bncNetTransport::instance()->resetConfig();
+
   _pppWidgets.saveOptions();
 }
 
@@ -2336,14 +2366,6 @@ void bncWindow::slotMountPointsRead(QList<bncGetThread*> threads) {
           _mountPointsTable->item(iRow, 4)->text() == thread->latitude()   &&
           _mountPointsTable->item(iRow, 5)->text() == thread->longitude() ) {
         ((bncTableItem*) _mountPointsTable->item(iRow, 8))->setGetThread(thread);
-        disconnect(thread, SIGNAL(newBytes(QByteArray, double)),
-                  _bncFigure, SLOT(slotNewData(QByteArray, double)));
-        connect(thread, SIGNAL(newBytes(QByteArray, double)),
-                _bncFigure, SLOT(slotNewData(QByteArray, double)));
-        disconnect(thread, SIGNAL(newLatency(QByteArray, double)),
-                   _bncFigureLate, SLOT(slotNewLatency(QByteArray, double)));
-        connect(thread, SIGNAL(newLatency(QByteArray, double)),
-                _bncFigureLate, SLOT(slotNewLatency(QByteArray, double)));
         break;
       }
     }
@@ -2578,12 +2600,18 @@ void bncWindow::slotBncTextChanged(){
       enableWidget(true, _cmbMaxresLineEdit);
       enableWidget(true, _cmbSamplSpinBox);
       enableWidget(true, _cmbUseGlonass);
+      enableWidget(true, _cmbUseGalileo);
+      enableWidget(true, _cmbUseBDS);
+      enableWidget(true, _cmbUseQZSS);
     }
     else {
       enableWidget(false, _cmbMethodComboBox);
       enableWidget(false, _cmbMaxresLineEdit);
       enableWidget(false, _cmbSamplSpinBox);
       enableWidget(false, _cmbUseGlonass);
+      enableWidget(false, _cmbUseGalileo);
+      enableWidget(false, _cmbUseBDS);
+      enableWidget(false, _cmbUseQZSS);
     }
   }
 
@@ -2682,6 +2710,9 @@ void bncWindow::slotDelCmbRow() {
     enableWidget(false, _cmbMaxresLineEdit);
     enableWidget(false, _cmbSamplSpinBox);
     enableWidget(false, _cmbUseGlonass);
+    enableWidget(false, _cmbUseGalileo);
+    enableWidget(false, _cmbUseBDS);
+    enableWidget(false, _cmbUseQZSS);
   }
 }
 
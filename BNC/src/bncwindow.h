@@ -218,6 +218,9 @@ class bncWindow : public QMainWindow {
     QComboBox*     _cmbMethodComboBox;
     QSpinBox*      _cmbSamplSpinBox;
     QCheckBox*     _cmbUseGlonass;
+    QCheckBox*     _cmbUseGalileo;
+    QCheckBox*     _cmbUseBDS;
+    QCheckBox*     _cmbUseQZSS;
 
     QTableWidget*  _uploadTable;
     QComboBox*     _uploadIntrComboBox;
@@ -47,12 +47,7 @@ bncComb::cmbParam::cmbParam(parType type_, int index_, const QString& ac_, const
   xx     = 0.0;
   eph    = 0;
 
-  if      (type == offACgps) {
-    epoSpec = true;
-    sig0    = sig0_offAC;
-    sigP    = sig0;
-  }
-  else if (type == offACglo) {
+  if      (type == offACSys) {
     epoSpec = true;
     sig0    = sig0_offAC;
     sigP    = sig0;
@@ -78,13 +73,8 @@ bncComb::cmbParam::~cmbParam() {
 ////////////////////////////////////////////////////////////////////////////
 double bncComb::cmbParam::partial(const QString& AC_, const QString& prn_) {
 
-  if      (type == offACgps) {
-    if (AC == AC_ && prn_[0] == 'G') {
-      return 1.0;
-    }
-  }
-  else if (type == offACglo) {
-    if (AC == AC_ && prn_[0] == 'R') {
+  if      (type == offACSys) {
+    if (AC == AC_) {
       return 1.0;
     }
   }
@@ -108,11 +98,12 @@ QString bncComb::cmbParam::toString() const {
 
   QString outStr;
 
-  if      (type == offACgps) {
-    outStr = "AC offset GPS " + AC;
-  }
-  else if (type == offACglo) {
-    outStr = "AC offset GLO " + AC;
+  if      (type == offACSys) {
+    char sys = prn[0].toLatin1();
+    outStr = "AC offset "
+           + QString((sys == 'G') ? "GPS" : (sys == 'R') ? "GLO" :
+                     (sys == 'E') ? "GAL" : (sys == 'C') ? "BDS" : "QZS")
+           + " " + AC;
   }
   else if (type == offACSat) {
     outStr = "Sat Offset " + AC + " " + prn.mid(0,3);
@@ -151,6 +142,7 @@ bncComb::bncComb() : _ephUser(true) {
     while (it.hasNext()) {
       QStringList hlp = it.next().split(" ");
       cmbAC* newAC = new cmbAC();
+      newAC->index      = _ACs.size();
       newAC->mountPoint = hlp[0];
       newAC->name       = hlp[1];
       newAC->weight     = hlp[2].toDouble();
@@ -158,6 +150,7 @@ bncComb::bncComb() : _ephUser(true) {
         _masterOrbitAC = newAC->name;
       }
       _ACs.append(newAC);
+      _mountPoints[newAC->mountPoint] = newAC;
     }
   }
 
@@ -184,55 +177,28 @@ bncComb::bncComb() : _ephUser(true) {
     _method = filter;
   }
 
-  // Use Glonass
-  // -----------
+  // Satellite Systems (each one is combined in its own parameter block)
+  // -------------------------------------------------------------------
+  _systems.append(new cmbSys('G'));
   if ( Qt::CheckState(settings.value("cmbUseGlonass").toInt()) == Qt::Checked) {
-    _useGlonass = true;
+    _systems.append(new cmbSys('R'));
   }
-  else {
-    _useGlonass = false;
+  if ( Qt::CheckState(settings.value("cmbUseGalileo").toInt()) == Qt::Checked) {
+    _systems.append(new cmbSys('E'));
+  }
+  if ( Qt::CheckState(settings.value("cmbUseBDS").toInt()) == Qt::Checked) {
+    _systems.append(new cmbSys('C'));
+  }
+  if ( Qt::CheckState(settings.value("cmbUseQZSS").toInt()) == Qt::Checked) {
+    _systems.append(new cmbSys('J'));
   }
 
   // Initialize Parameters (model: Clk_Corr = AC_Offset + Sat_Offset + Clk)
   // ----------------------------------------------------------------------
   if (_method == filter) {
-    int nextPar = 0;
-    QListIterator<cmbAC*> it(_ACs);
-    while (it.hasNext()) {
-      cmbAC* AC = it.next();
-      _params.push_back(new cmbParam(cmbParam::offACgps, ++nextPar, AC->name, ""));
-      for (unsigned iGps = 1; iGps <= t_prn::MAXPRN_GPS; iGps++) {
-        QString prn = QString("G%1_0").arg(iGps, 2, 10, QChar('0'));
-        _params.push_back(new cmbParam(cmbParam::offACSat, ++nextPar,
-                                       AC->name, prn));
-      }
-      if (_useGlonass) {
-        _params.push_back(new cmbParam(cmbParam::offACglo, ++nextPar, AC->name, ""));
-        for (unsigned iGlo = 1; iGlo <= t_prn::MAXPRN_GLONASS; iGlo++) {
-          QString prn = QString("R%1_0").arg(iGlo, 2, 10, QChar('0'));
-          _params.push_back(new cmbParam(cmbParam::offACSat, ++nextPar,
-                                         AC->name, prn));
-        }
-      }
-    }
-    for (unsigned iGps = 1; iGps <= t_prn::MAXPRN_GPS; iGps++) {
-      QString prn = QString("G%1_0").arg(iGps, 2, 10, QChar('0'));
-      _params.push_back(new cmbParam(cmbParam::clkSat, ++nextPar, "", prn));
-    }
-    if (_useGlonass) {
-      for (unsigned iGlo = 1; iGlo <= t_prn::MAXPRN_GLONASS; iGlo++) {
-        QString prn = QString("R%1_0").arg(iGlo, 2, 10, QChar('0'));
-        _params.push_back(new cmbParam(cmbParam::clkSat, ++nextPar, "", prn));
-      }
-    }
-
-    // Initialize Variance-Covariance Matrix
-    // -------------------------------------
-    _QQ.ReSize(_params.size());
-    _QQ = 0.0;
-    for (int iPar = 1; iPar <= _params.size(); iPar++) {
-      cmbParam* pp = _params[iPar-1];
-      _QQ(iPar,iPar) = pp->sig0 * pp->sig0;
+    QListIterator<cmbSys*> itSys(_systems);
+    while (itSys.hasNext()) {
+      initParams(itSys.next());
     }
   }
 
@@ -266,8 +232,9 @@ bncComb::~bncComb() {
   }
   delete _rtnetDecoder;
   delete _antex;
-  for (int iPar = 1; iPar <= _params.size(); iPar++) {
-    delete _params[iPar-1];
+  QListIterator<cmbSys*> itSys(_systems);
+  while (itSys.hasNext()) {
+    delete itSys.next();
   }
   QListIterator<bncTime> itTime(_buffer.keys());
   while (itTime.hasNext()) {
@@ -276,35 +243,100 @@ bncComb::~bncComb() {
   }
 }
 
+// Filter Parameters and Variance-Covariance Matrix of one System
+////////////////////////////////////////////////////////////////////////////
+void bncComb::initParams(cmbSys* sys) {
+
+  int nextPar = 0;
+  QListIterator<cmbAC*> it(_ACs);
+  while (it.hasNext()) {
+    cmbAC* AC = it.next();
+    sys->params.push_back(new cmbParam(cmbParam::offACSys, ++nextPar,
+                                       AC->name, QString(QChar(sys->sys))));
+    for (unsigned iPrn = 1; iPrn <= maxPrn(sys->sys); iPrn++) {
+      sys->params.push_back(new cmbParam(cmbParam::offACSat, ++nextPar,
+                                         AC->name, prnString(sys->sys, iPrn)));
+    }
+  }
+  for (unsigned iPrn = 1; iPrn <= maxPrn(sys->sys); iPrn++) {
+    sys->params.push_back(new cmbParam(cmbParam::clkSat, ++nextPar,
+                                       "", prnString(sys->sys, iPrn)));
+  }
+
+  sys->QQ.ReSize(sys->params.size());
+  sys->QQ = 0.0;
+  for (int iPar = 1; iPar <= sys->params.size(); iPar++) {
+    cmbParam* pp = sys->params[iPar-1];
+    sys->QQ(iPar,iPar) = pp->sig0 * pp->sig0;
+  }
+}
+
+// Parameter Block of a System
+////////////////////////////////////////////////////////////////////////////
+bncComb::cmbSys* bncComb::findSys(char sys) const {
+  QListIterator<cmbSys*> itSys(_systems);
+  while (itSys.hasNext()) {
+    cmbSys* cmbsys = itSys.next();
+    if (cmbsys->sys == sys) {
+      return cmbsys;
+    }
+  }
+  return 0;
+}
+
+// Number of Satellites of a System
+////////////////////////////////////////////////////////////////////////////
+unsigned bncComb::maxPrn(char sys) {
+  switch (sys) {
+    case 'G': return t_prn::MAXPRN_GPS;
+    case 'R': return t_prn::MAXPRN_GLONASS;
+    case 'E': return t_prn::MAXPRN_GALILEO;
+    case 'C': return t_prn::MAXPRN_BDS;
+    case 'J': return t_prn::MAXPRN_QZSS;
+  }
+  return 0;
+}
+
+// PRN Flags of the combined Corrections (Galileo corrections refer to the
+// I/NAV clock, corrections with other flags are not combined)
+////////////////////////////////////////////////////////////////////////////
+int bncComb::prnFlags(char sys) {
+  return (sys == 'E') ? 1 : 0;
+}
+
+// Internal PRN String
+////////////////////////////////////////////////////////////////////////////
+QString bncComb::prnString(char sys, unsigned number) {
+  t_prn prn(sys, number, prnFlags(sys));
+  return QString(prn.toInternalString().c_str());
+}
+
 // Remember orbit corrections
 ////////////////////////////////////////////////////////////////////////////
 void bncComb::slotNewOrbCorrections(QList<t_orbCorr> orbCorrections) {
   QMutexLocker locker(&_mutex);
 
   for (int ii = 0; ii < orbCorrections.size(); ii++) {
-    t_orbCorr& orbCorr = orbCorrections[ii];
-    QString    staID(orbCorr._staID.c_str());
-    QString    prn(orbCorr._prn.toInternalString().c_str());
+    const t_orbCorr& orbCorr = orbCorrections[ii];
 
-    // Find/Check the AC Name
-    // ----------------------
-    QString acName;
-    QListIterator<cmbAC*> icAC(_ACs);
-    while (icAC.hasNext()) {
-      cmbAC* AC = icAC.next();
-      if (AC->mountPoint == staID) {
-        acName = AC->name;
-        break;
-      }
+    // Find/Check the AC
+    // -----------------
+    cmbAC* AC = _mountPoints.value(QString(orbCorr._staID.c_str()), 0);
+    if (!AC) {
+      continue;
     }
-    if (acName.isEmpty()) {
+
+    // Check the Satellite System
+    // --------------------------
+    char sys = orbCorr._prn.system();
+    if (!findSys(sys) || orbCorr._prn.number() > maxPrn(sys) ||
+        orbCorr._prn.flags() != prnFlags(sys)) {
       continue;
     }
 
     // Store the correction
     // --------------------
-    QMap<t_prn, t_orbCorr>& storage = _orbCorrections[acName];
-    storage[orbCorr._prn] = orbCorr;
+    AC->orbCorr[orbCorr._prn.toInt()] = orbCorr;
   }
 }
 
@@ -316,9 +348,7 @@ void bncComb::slotNewClkCorrections(QList<t_clkCorr> clkCorrections) {
   bncTime lastTime;
 
   for (int ii = 0; ii < clkCorrections.size(); ii++) {
-    t_clkCorr& clkCorr = clkCorrections[ii];
-    QString    staID(clkCorr._staID.c_str());
-    QString    prn(clkCorr._prn.toInternalString().c_str());
+    const t_clkCorr& clkCorr = clkCorrections[ii];
 
     // Set the last time
     // -----------------
@@ -326,36 +356,22 @@ void bncComb::slotNewClkCorrections(QList<t_clkCorr> clkCorrections) {
       lastTime = clkCorr._time;
     }
 
-    // Find/Check the AC Name
-    // ----------------------
-    QString acName;
-    QListIterator<cmbAC*> icAC(_ACs);
-    while (icAC.hasNext()) {
-      cmbAC* AC = icAC.next();
-      if (AC->mountPoint == staID) {
-        acName = AC->name;
-        break;
-      }
-    }
-    if (acName.isEmpty()) {
+    // Find/Check the AC
+    // -----------------
+    cmbAC* AC = _mountPoints.value(QString(clkCorr._staID.c_str()), 0);
+    if (!AC) {
       continue;
     }
 
-    // Check GLONASS
-    // -------------
-    if (!_useGlonass && clkCorr._prn.system() == 'R') {
+    // Check the Satellite System
+    // --------------------------
+    char sys = clkCorr._prn.system();
+    if (!findSys(sys) || clkCorr._prn.number() > maxPrn(sys) ||
+        clkCorr._prn.flags() != prnFlags(sys)) {
       continue;
     }
+    int iPrn = clkCorr._prn.toInt();
 
-    if (
-        clkCorr._prn.system() == 'E' ||
-        clkCorr._prn.system() == 'C' ||
-        clkCorr._prn.system() == 'J' ||
-        clkCorr._prn.system() == 'I' ||
-        clkCorr._prn.system() == 'S' )   {
-      continue;
-    }
-    
     // Check Modulo Time
     // -----------------
     if (int(clkCorr._time.gpssec()) % _cmbSampl != 0.0) {
@@ -365,65 +381,80 @@ void bncComb::slotNewClkCorrections(QList<t_clkCorr> clkCorrections) {
     // Check Correction Age
     // --------------------
     if (_resTime.valid() && clkCorr._time <= _resTime) {
-      emit newMessage("bncComb: old correction: " + acName.toLatin1() + " " + prn.mid(0,3).toLatin1(), true);
+      emit newMessage("bncComb: old correction: " + AC->name.toLatin1() + " " +
+                      QByteArray(clkCorr._prn.toString().c_str()), true);
       continue;
     }
 
-    // Create new correction
-    // ---------------------
-    cmbCorr* newCorr  = new cmbCorr();
-    newCorr->_prn     = prn;
-    newCorr->_time    = clkCorr._time;
-    newCorr->_iod     = clkCorr._iod;
-    newCorr->_acName  = acName;
-    newCorr->_clkCorr = clkCorr;
-
     // Check orbit correction
     // ----------------------
-    if (!_orbCorrections.contains(acName)) {
-      delete newCorr;
+    const t_orbCorr& orbCorr = AC->orbCorr[iPrn];
+    if (orbCorr._time.undef() || orbCorr._iod != clkCorr._iod) {
       continue;
     }
-    else {
-      QMap<t_prn, t_orbCorr>& storage = _orbCorrections[acName];
-      if (!storage.contains(clkCorr._prn)  || storage[clkCorr._prn]._iod != newCorr->_iod) {
-        delete newCorr;
-        continue;
-      }
-      else {
-        newCorr->_orbCorr = storage[clkCorr._prn];
-      }
-    }
 
     // Check the Ephemeris
     //--------------------
+    QString prn(clkCorr._prn.toInternalString().c_str());
     t_eph* ephLast = _ephUser.ephLast(prn);
     t_eph* ephPrev = _ephUser.ephPrev(prn);
+    t_eph* eph     = 0;
     if (ephLast == 0) {
       emit newMessage("bncComb: eph not found "  + prn.mid(0,3).toLatin1(), true);
-      delete newCorr;
       continue;
     }
     else {
-      if      (ephLast->IOD() == newCorr->_iod) {
-        newCorr->_eph = ephLast;
+      if      (ephLast->IOD() == clkCorr._iod) {
+        eph = ephLast;
       }
-      else if (ephPrev && ephPrev->IOD() == newCorr->_iod) {
-        newCorr->_eph = ephPrev;
-        switchToLastEph(ephLast, newCorr);
+      else if (ephPrev && ephPrev->IOD() == clkCorr._iod) {
+        eph = ephPrev;
       }
       else {
         emit newMessage("bncComb: eph not found "  + prn.mid(0,3).toLatin1() +
-                        QString(" %1").arg(newCorr->_iod).toLatin1(), true);
-        delete newCorr;
+                        QString(" %1").arg(clkCorr._iod).toLatin1(), true);
         continue;
       }
     }
 
-    // Store correction into the buffer
-    // --------------------------------
-    QVector<cmbCorr*>& corrs = _buffer[newCorr->_time].corrs;
-    corrs.push_back(newCorr);
+    // Store correction into the epoch slab (a repeated correction of the
+    // same AC and satellite replaces the previous one)
+    // ------------------------------------------------------------------
+    cmbEpoch& epoch = _buffer[clkCorr._time];
+    if (epoch.slot.isEmpty()) {
+      int maxSat = 0;
+      QListIterator<cmbSys*> itSys(_systems);
+      while (itSys.hasNext()) {
+        maxSat += maxPrn(itSys.next()->sys);
+      }
+      epoch.slot.fill(-1, _ACs.size() * (t_prn::MAXPRN + 1));
+      epoch.slab.reserve(_ACs.size() * maxSat);
+    }
+    int& slot = epoch.slot[AC->index * (t_prn::MAXPRN + 1) + iPrn];
+    if (slot < 0) {
+      if (!epoch.freed.isEmpty()) {
+        slot = epoch.freed.last();
+        epoch.freed.pop_back();
+        epoch.slab[slot] = cmbCorr();
+      }
+      else {
+        slot = epoch.slab.size();
+        epoch.slab.push_back(cmbCorr());
+      }
+      epoch.corrs.push_back(slot);
+    }
+    cmbCorr& newCorr = epoch.slab[slot];
+    newCorr._prn     = prn;
+    newCorr._time    = clkCorr._time;
+    newCorr._iod     = clkCorr._iod;
+    newCorr._acName  = AC->name;
+    newCorr._acIndex = AC->index;
+    newCorr._eph     = eph;
+    newCorr._clkCorr = clkCorr;
+    newCorr._orbCorr = orbCorr;
+    if (eph == ephPrev) {
+      switchToLastEph(ephLast, &newCorr);
+    }
   }
 
   // Process previous Epoch(s)
@@ -484,6 +515,14 @@ void bncComb::processEpoch() {
 
   _log.clear();
 
+  // Corrections of the Epoch (the slab is not changed during processing)
+  // ---------------------------------------------------------------------
+  cmbEpoch& epoch = _buffer[_resTime];
+  _corrs.clear();
+  for (int ii = 0; ii < epoch.corrs.size(); ii++) {
+    _corrs.push_back(&epoch.slab[epoch.corrs[ii]]);
+  }
+
   QTextStream out(&_log, QIODevice::WriteOnly);
 
   out << endl <<           "Combination:" << endl
@@ -493,18 +532,18 @@ void bncComb::processEpoch() {
   // ----------------------
   bool masterPresent = false;
   QListIterator<cmbAC*> icAC(_ACs);
+  while (icAC.hasNext()) {
+    icAC.next()->numObs = 0;
+  }
+  QVectorIterator<cmbCorr*> itCorr(corrs());
+  while (itCorr.hasNext()) {
+    _ACs[itCorr.next()->_acIndex]->numObs += 1;
+  }
+  icAC.toFront();
   while (icAC.hasNext()) {
     cmbAC* AC = icAC.next();
-    AC->numObs = 0;
-    QVectorIterator<cmbCorr*> itCorr(corrs());
-    while (itCorr.hasNext()) {
-      cmbCorr* corr = itCorr.next();
-      if (corr->_acName == AC->name) {
-        AC->numObs += 1;
-        if (AC->name == _masterOrbitAC) {
-          masterPresent = true;
-        }
-      }
+    if (AC->numObs > 0 && AC->name == _masterOrbitAC) {
+      masterPresent = true;
     }
     out << AC->name.toLatin1().data() << ": " << AC->numObs << endl;
   }
@@ -520,6 +559,7 @@ void bncComb::processEpoch() {
     if (_masterMissingEpochs < switchMasterAfterGap) {
       out << "Missing Master, Epoch skipped" << endl;
       _buffer.remove(_resTime);
+      _corrs.clear();
       emit newMessage(_log, false);
       return;
     }
@@ -541,39 +581,81 @@ void bncComb::processEpoch() {
     }
   }
 
+  // Check Satellite Positions for Outliers
+  // --------------------------------------
+  if (checkOrbits(out) != success) {
+    _buffer.remove(_resTime);
+    _corrs.clear();
+    emit newMessage(_log, false);
+    return;
+  }
+
   QMap<QString, cmbCorr*> resCorr;
 
-  // Perform the actual Combination using selected Method
-  // ----------------------------------------------------
-  t_irc irc;
-  ColumnVector dx;
-  if (_method == filter) {
-    irc = processEpoch_filter(out, resCorr, dx);
-  }
-  else {
-    irc = processEpoch_singleEpoch(out, resCorr, dx);
-  }
+  // Perform the actual Combination using selected Method, one System
+  // (block of the normal equations) after another
+  // ----------------------------------------------------------------
+  QListIterator<cmbSys*> itSys(_systems);
+  while (itSys.hasNext()) {
+    cmbSys* sys = itSys.next();
 
-  // Update Parameter Values, Print Results
-  // --------------------------------------
-  if (irc == success) {
-    for (int iPar = 1; iPar <= _params.size(); iPar++) {
-      cmbParam* pp = _params[iPar-1];
-      pp->xx += dx(iPar);
-      if (pp->type == cmbParam::clkSat) {
-        if (resCorr.find(pp->prn) != resCorr.end()) {
-          resCorr[pp->prn]->_dClkResult = pp->xx / t_CST::c;
+    QVector<cmbCorr*> sysCorrs;
+    QVectorIterator<cmbCorr*> itCorr(corrs());
+    while (itCorr.hasNext()) {
+      cmbCorr* corr = itCorr.next();
+      if (corr->_prn[0] == sys->sys) {
+        sysCorrs.push_back(corr);
+      }
+    }
+    if (sysCorrs.isEmpty()) {
+      continue;
+    }
+
+    QMap<QString, cmbCorr*> sysResCorr;
+    t_irc irc;
+    ColumnVector dx;
+    if (_method == filter) {
+      irc = processEpoch_filter(out, sys, sysCorrs, sysResCorr, dx);
+    }
+    else {
+      irc = processEpoch_singleEpoch(out, sys, sysCorrs, sysResCorr, dx);
+    }
+
+    // Update Parameter Values, Print Results
+    // --------------------------------------
+    if (irc == success) {
+      for (int iPar = 1; iPar <= sys->params.size(); iPar++) {
+        cmbParam* pp = sys->params[iPar-1];
+        pp->xx += dx(iPar);
+        if (pp->type == cmbParam::clkSat) {
+          if (sysResCorr.find(pp->prn) != sysResCorr.end()) {
+            sysResCorr[pp->prn]->_dClkResult = pp->xx / t_CST::c;
+          }
         }
+        out << _resTime.datestr().c_str() << " "
+            << _resTime.timestr().c_str() << " ";
+        out.setRealNumberNotation(QTextStream::FixedNotation);
+        out.setFieldWidth(8);
+        out.setRealNumberPrecision(4);
+        out << pp->toString() << " "
+            << pp->xx << " +- " << sqrt(sys->QQ(pp->index,pp->index)) << endl;
+        out.setFieldWidth(0);
+      }
+      QMapIterator<QString, cmbCorr*> itRes(sysResCorr);
+      while (itRes.hasNext()) {
+        itRes.next();
+        resCorr[itRes.key()] = itRes.value();
       }
-      out << _resTime.datestr().c_str() << " "
-          << _resTime.timestr().c_str() << " ";
-      out.setRealNumberNotation(QTextStream::FixedNotation);
-      out.setFieldWidth(8);
-      out.setRealNumberPrecision(4);
-      out << pp->toString() << " "
-          << pp->xx << " +- " << sqrt(_QQ(pp->index,pp->index)) << endl;
-      out.setFieldWidth(0);
     }
+    else {
+      QMapIterator<QString, cmbCorr*> itRes(sysResCorr);
+      while (itRes.hasNext()) {
+        delete itRes.next().value();
+      }
+    }
+  }
+
+  if (!resCorr.isEmpty()) {
     printResults(out, resCorr);
     dumpResults(resCorr);
   }
@@ -581,54 +663,50 @@ void bncComb::processEpoch() {
   // Delete Data, emit Message
   // -------------------------
   _buffer.remove(_resTime);
+  _corrs.clear();
   emit newMessage(_log, false);
 }
 
 // Process Epoch - Filter Method
 ////////////////////////////////////////////////////////////////////////////
-t_irc bncComb::processEpoch_filter(QTextStream& out,
+t_irc bncComb::processEpoch_filter(QTextStream& out, cmbSys* sys,
+                                   QVector<cmbCorr*>& sysCorrs,
                                    QMap<QString, cmbCorr*>& resCorr,
                                    ColumnVector& dx) {
 
   // Prediction Step
   // ---------------
-  int nPar = _params.size();
+  int nPar = sys->params.size();
   ColumnVector x0(nPar);
-  for (int iPar = 1; iPar <= _params.size(); iPar++) {
-    cmbParam* pp  = _params[iPar-1];
+  for (int iPar = 1; iPar <= sys->params.size(); iPar++) {
+    cmbParam* pp  = sys->params[iPar-1];
     if (pp->epoSpec) {
       pp->xx = 0.0;
-      _QQ.Row(iPar)    = 0.0;
-      _QQ.Column(iPar) = 0.0;
-      _QQ(iPar,iPar) = pp->sig0 * pp->sig0;
+      sys->QQ.Row(iPar)    = 0.0;
+      sys->QQ.Column(iPar) = 0.0;
+      sys->QQ(iPar,iPar) = pp->sig0 * pp->sig0;
     }
     else {
-      _QQ(iPar,iPar) += pp->sigP * pp->sigP;
+      sys->QQ(iPar,iPar) += pp->sigP * pp->sigP;
     }
     x0(iPar) = pp->xx;
   }
 
-  // Check Satellite Positions for Outliers
-  // --------------------------------------
-  if (checkOrbits(out) != success) {
-    return failure;
-  }
-
   // Update and outlier detection loop
   // ---------------------------------
-  SymmetricMatrix QQ_sav = _QQ;
+  SymmetricMatrix QQ_sav = sys->QQ;
   while (true) {
 
     Matrix         AA;
     ColumnVector   ll;
     DiagonalMatrix PP;
 
-    if (createAmat(AA, ll, PP, x0, resCorr) != success) {
+    if (createAmat(sys, sysCorrs, AA, ll, PP, x0, resCorr) != success) {
       return failure;
     }
 
     dx.ReSize(nPar); dx = 0.0;
-    kalman(AA, ll, PP, _QQ, dx);
+    kalman(AA, ll, PP, sys->QQ, dx);
 
     ColumnVector vv = ll - AA * dx;
 
@@ -638,13 +716,13 @@ t_irc bncComb::processEpoch_filter(QTextStream& out,
     out.setRealNumberPrecision(3);
     out << _resTime.datestr().c_str() << " " << _resTime.timestr().c_str()
         << " Maximum Residuum " << maxRes << ' '
-        << corrs()[maxResIndex-1]->_acName << ' ' << corrs()[maxResIndex-1]->_prn.mid(0,3);
+        << sysCorrs[maxResIndex-1]->_acName << ' ' << sysCorrs[maxResIndex-1]->_prn.mid(0,3);
     if (maxRes > _MAXRES) {
-      for (int iPar = 1; iPar <= _params.size(); iPar++) {
-        cmbParam* pp = _params[iPar-1];
+      for (int iPar = 1; iPar <= sys->params.size(); iPar++) {
+        cmbParam* pp = sys->params[iPar-1];
         if (pp->type == cmbParam::offACSat            &&
-            pp->AC   == corrs()[maxResIndex-1]->_acName &&
-            pp->prn  == corrs()[maxResIndex-1]->_prn.mid(0,3)) {
+            pp->AC   == sysCorrs[maxResIndex-1]->_acName &&
+            pp->prn  == sysCorrs[maxResIndex-1]->_prn.mid(0,3)) {
           QQ_sav.Row(iPar)    = 0.0;
           QQ_sav.Column(iPar) = 0.0;
           QQ_sav(iPar,iPar)   = pp->sig0 * pp->sig0;
@@ -652,15 +730,15 @@ t_irc bncComb::processEpoch_filter(QTextStream& out,
       }
 
       out << "  Outlier" << endl;
-      _QQ = QQ_sav;
-      corrs().remove(maxResIndex-1);
+      sys->QQ = QQ_sav;
+      sysCorrs.remove(maxResIndex-1);
     }
     else {
       out << "  OK" << endl;
       out.setRealNumberNotation(QTextStream::FixedNotation);
       out.setRealNumberPrecision(4);
-      for (int ii = 0; ii < corrs().size(); ii++) {
-      const cmbCorr* corr = corrs()[ii];
+      for (int ii = 0; ii < sysCorrs.size(); ii++) {
+      const cmbCorr* corr = sysCorrs[ii];
         out << _resTime.datestr().c_str() << ' '
             << _resTime.timestr().c_str() << " "
             << corr->_acName << ' ' << corr->_prn.mid(0,3);
@@ -811,30 +889,32 @@ void bncComb::dumpResults(const QMap<QString, cmbCorr*>& resCorr) {
 
 // Create First Design Matrix and Vector of Measurements
 ////////////////////////////////////////////////////////////////////////////
-t_irc bncComb::createAmat(Matrix& AA, ColumnVector& ll, DiagonalMatrix& PP,
+t_irc bncComb::createAmat(cmbSys* sys, const QVector<cmbCorr*>& sysCorrs,
+                          Matrix& AA, ColumnVector& ll, DiagonalMatrix& PP,
                           const ColumnVector& x0,
                           QMap<QString, cmbCorr*>& resCorr) {
 
-  unsigned nPar = _params.size();
-  unsigned nObs = corrs().size();
+  unsigned nPar = sys->params.size();
+  unsigned nObs = sysCorrs.size();
 
   if (nObs == 0) {
     return failure;
   }
 
-  int maxSat = t_prn::MAXPRN_GPS;
-//  if (_useGlonass) {
-//    maxSat = t_prn::MAXPRN_GPS + t_prn::MAXPRN_GLONASS;
-//  }
+  int maxSat = maxPrn(sys->sys);
+
+  // No per-satellite conditions for GLONASS (as in the GPS/GLONASS version)
+  // -----------------------------------------------------------------------
+  int maxSatCon = (sys->sys == 'R') ? 0 : maxSat;
 
-  const int nCon = (_method == filter) ? 1 + maxSat : 0;
+  const int nCon = (_method == filter) ? 1 + maxSatCon : 0;
 
   AA.ReSize(nObs+nCon, nPar);  AA = 0.0;
   ll.ReSize(nObs+nCon);        ll = 0.0;
   PP.ReSize(nObs+nCon);        PP = 1.0 / (sigObs * sigObs);
 
   int iObs = 0;
-  QVectorIterator<cmbCorr*> itCorr(corrs());
+  QVectorIterator<cmbCorr*> itCorr(sysCorrs);
   while (itCorr.hasNext()) {
     cmbCorr* corr = itCorr.next();
     QString  prn  = corr->_prn;
@@ -845,8 +925,8 @@ t_irc bncComb::createAmat(Matrix& AA, ColumnVector& ll, DiagonalMatrix& PP,
       resCorr[prn] = new cmbCorr(*corr);
     }
 
-    for (int iPar = 1; iPar <= _params.size(); iPar++) {
-      cmbParam* pp = _params[iPar-1];
+    for (int iPar = 1; iPar <= sys->params.size(); iPar++) {
+      cmbParam* pp = sys->params[iPar-1];
       AA(iObs, iPar) = pp->partial(corr->_acName, prn);
     }
 
@@ -858,20 +938,20 @@ t_irc bncComb::createAmat(Matrix& AA, ColumnVector& ll, DiagonalMatrix& PP,
   if (_method == filter) {
     const double Ph = 1.e6;
     PP(nObs+1) = Ph;
-    for (int iPar = 1; iPar <= _params.size(); iPar++) {
-      cmbParam* pp = _params[iPar-1];
+    for (int iPar = 1; iPar <= sys->params.size(); iPar++) {
+      cmbParam* pp = sys->params[iPar-1];
       if ( AA.Column(iPar).maximum_absolute_value() > 0.0 &&
            pp->type == cmbParam::clkSat ) {
         AA(nObs+1, iPar) = 1.0;
       }
     }
     int iCond = 1;
-    for (unsigned iGps = 1; iGps <= t_prn::MAXPRN_GPS; iGps++) {
-      QString prn = QString("G%1_0").arg(iGps, 2, 10, QChar('0'));
+    for (int iPrn = 1; iPrn <= maxSatCon; iPrn++) {
+      QString prn = prnString(sys->sys, iPrn);
       ++iCond;
       PP(nObs+iCond) = Ph;
-      for (int iPar = 1; iPar <= _params.size(); iPar++) {
-        cmbParam* pp = _params[iPar-1];
+      for (int iPar = 1; iPar <= sys->params.size(); iPar++) {
+        cmbParam* pp = sys->params[iPar-1];
         if ( pp &&
              AA.Column(iPar).maximum_absolute_value() > 0.0 &&
              pp->type == cmbParam::offACSat                 &&
@@ -880,22 +960,6 @@ t_irc bncComb::createAmat(Matrix& AA, ColumnVector& ll, DiagonalMatrix& PP,
         }
       }
     }
-//    if (_useGlonass) {
-//      for (int iGlo = 1; iGlo <= t_prn::MAXPRN_GLONASS; iGlo++) {
-//        QString prn = QString("R%1_0").arg(iGlo, 2, 10, QChar('0'));
-//        ++iCond;
-//        PP(nObs+iCond) = Ph;
-//        for (int iPar = 1; iPar <= _params.size(); iPar++) {
-//          cmbParam* pp = _params[iPar-1];
-//          if ( pp &&
-//               AA.Column(iPar).maximum_absolute_value() > 0.0 &&
-//               pp->type == cmbParam::offACSat                 &&
-//               pp->prn == prn) {
-//            AA(nObs+iCond, iPar) = 1.0;
-//          }
-//        }
-//      }
-//    }
   }
 
   return success;
@@ -903,28 +967,23 @@ t_irc bncComb::createAmat(Matrix& AA, ColumnVector& ll, DiagonalMatrix& PP,
 
 // Process Epoch - Single-Epoch Method
 ////////////////////////////////////////////////////////////////////////////
-t_irc bncComb::processEpoch_singleEpoch(QTextStream& out,
+t_irc bncComb::processEpoch_singleEpoch(QTextStream& out, cmbSys* sys,
+                                        QVector<cmbCorr*>& sysCorrs,
                                         QMap<QString, cmbCorr*>& resCorr,
                                         ColumnVector& dx) {
 
-  // Check Satellite Positions for Outliers
-  // --------------------------------------
-  if (checkOrbits(out) != success) {
-    return failure;
-  }
-
   // Outlier Detection Loop
   // ----------------------
   while (true) {
 
     // Remove Satellites that are not in Master
     // ----------------------------------------
-    QMutableVectorIterator<cmbCorr*> it(corrs());
+    QMutableVectorIterator<cmbCorr*> it(sysCorrs);
     while (it.hasNext()) {
       cmbCorr* corr = it.next();
       QString  prn  = corr->_prn;
       bool foundMaster = false;
-      QVectorIterator<cmbCorr*> itHlp(corrs());
+      QVectorIterator<cmbCorr*> itHlp(sysCorrs);
       while (itHlp.hasNext()) {
         cmbCorr* corrHlp = itHlp.next();
         QString  prnHlp  = corrHlp->_prn;
@@ -935,7 +994,6 @@ t_irc bncComb::processEpoch_singleEpoch(QTextStream& out,
         }
       }
       if (!foundMaster) {
-        delete corr;
         it.remove();
       }
     }
@@ -944,7 +1002,7 @@ t_irc bncComb::processEpoch_singleEpoch(QTextStream& out,
     // -----------------------------------------------------
     QMap<QString, int> numObsPrn;
     QMap<QString, int> numObsAC;
-    QVectorIterator<cmbCorr*> itCorr(corrs());
+    QVectorIterator<cmbCorr*> itCorr(sysCorrs);
     while (itCorr.hasNext()) {
       cmbCorr* corr = itCorr.next();
       QString  prn  = corr->_prn;
@@ -965,10 +1023,10 @@ t_irc bncComb::processEpoch_singleEpoch(QTextStream& out,
 
     // Clean-Up the Paramters
     // ----------------------
-    for (int iPar = 1; iPar <= _params.size(); iPar++) {
-      delete _params[iPar-1];
+    for (int iPar = 1; iPar <= sys->params.size(); iPar++) {
+      delete sys->params[iPar-1];
     }
-    _params.clear();
+    sys->params.clear();
 
     // Set new Parameters
     // ------------------
@@ -980,10 +1038,8 @@ t_irc bncComb::processEpoch_singleEpoch(QTextStream& out,
       const QString& AC     = itAC.key();
       int            numObs = itAC.value();
       if (AC != _masterOrbitAC && numObs > 0) {
-        _params.push_back(new cmbParam(cmbParam::offACgps, ++nextPar, AC, ""));
-        if (_useGlonass) {
-          _params.push_back(new cmbParam(cmbParam::offACglo, ++nextPar, AC, ""));
-        }
+        sys->params.push_back(new cmbParam(cmbParam::offACSys, ++nextPar,
+                                           AC, QString(QChar(sys->sys))));
       }
     }
 
@@ -993,11 +1049,11 @@ t_irc bncComb::processEpoch_singleEpoch(QTextStream& out,
       const QString& prn    = itPrn.key();
       int            numObs = itPrn.value();
       if (numObs > 0) {
-        _params.push_back(new cmbParam(cmbParam::clkSat, ++nextPar, "", prn));
+        sys->params.push_back(new cmbParam(cmbParam::clkSat, ++nextPar, "", prn));
       }
     }
 
-    int nPar = _params.size();
+    int nPar = sys->params.size();
     ColumnVector x0(nPar);
     x0 = 0.0;
 
@@ -1006,7 +1062,7 @@ t_irc bncComb::processEpoch_singleEpoch(QTextStream& out,
     Matrix         AA;
     ColumnVector   ll;
     DiagonalMatrix PP;
-    if (createAmat(AA, ll, PP, x0, resCorr) != success) {
+    if (createAmat(sys, sysCorrs, AA, ll, PP, x0, resCorr) != success) {
       return failure;
     }
 
@@ -1015,8 +1071,8 @@ t_irc bncComb::processEpoch_singleEpoch(QTextStream& out,
       Matrix          ATP = AA.t() * PP;
       SymmetricMatrix NN; NN << ATP * AA;
       ColumnVector    bb = ATP * ll;
-      _QQ = NN.i();
-      dx  = _QQ * bb;
+      sys->QQ = NN.i();
+      dx  = sys->QQ * bb;
       vv  = ll - AA * dx;
     }
     catch (Exception& exc) {
@@ -1030,19 +1086,18 @@ t_irc bncComb::processEpoch_singleEpoch(QTextStream& out,
     out.setRealNumberPrecision(3);
     out << _resTime.datestr().c_str() << " " << _resTime.timestr().c_str()
         << " Maximum Residuum " << maxRes << ' '
-        << corrs()[maxResIndex-1]->_acName << ' ' << corrs()[maxResIndex-1]->_prn.mid(0,3);
+        << sysCorrs[maxResIndex-1]->_acName << ' ' << sysCorrs[maxResIndex-1]->_prn.mid(0,3);
 
     if (maxRes > _MAXRES) {
       out << "  Outlier" << endl;
-      delete corrs()[maxResIndex-1];
-      corrs().remove(maxResIndex-1);
+      sysCorrs.remove(maxResIndex-1);
     }
     else {
       out << "  OK" << endl;
       out.setRealNumberNotation(QTextStream::FixedNotation);
       out.setRealNumberPrecision(3);
       for (int ii = 0; ii < vv.Nrows(); ii++) {
-        const cmbCorr* corr = corrs()[ii];
+        const cmbCorr* corr = sysCorrs[ii];
         out << _resTime.datestr().c_str() << ' '
             << _resTime.timestr().c_str() << " "
             << corr->_acName << ' ' << corr->_prn.mid(0,3);
@@ -1076,12 +1131,10 @@ t_irc bncComb::checkOrbits(QTextStream& out) {
 
     if      (ephLast == 0) {
       out << "checkOrbit: missing eph (not found) " << corr->_prn.mid(0,3) << endl;
-      delete corr;
       im.remove();
     }
     else if (corr->_eph == 0) {
       out << "checkOrbit: missing eph (zero) " << corr->_prn.mid(0,3) << endl;
-      delete corr;
       im.remove();
     }
     else {
@@ -1090,7 +1143,6 @@ t_irc bncComb::checkOrbits(QTextStream& out) {
       }
       else {
         out << "checkOrbit: missing eph (deleted) " << corr->_prn.mid(0,3) << endl;
-        delete corr;
         im.remove();
       }
     }
@@ -1159,7 +1211,6 @@ t_irc bncComb::checkOrbits(QTextStream& out) {
       cmbCorr* corr = im.next();
       QString  prn  = corr->_prn;
       if      (numCorr[prn] < 2) {
-        delete corr;
         im.remove();
       }
       else if (corr == maxDiff[prn]) {
@@ -1172,7 +1223,6 @@ t_irc bncComb::checkOrbits(QTextStream& out) {
               << prn.mid(0,3).toLatin1().data()           << " "
               << corr->_iod                     << " "
               << norm                           << endl;
-          delete corr;
           im.remove();
           removed = true;
         }
@@ -1196,33 +1246,27 @@ void bncComb::slotProviderIDChanged(QString mountPoint) {
 
   // Find the AC Name
   // ----------------
-  QString acName;
-  QListIterator<cmbAC*> icAC(_ACs);
-  while (icAC.hasNext()) {
-    cmbAC* AC = icAC.next();
-    if (AC->mountPoint == mountPoint) {
-      acName = AC->name;
-      out << "Provider ID changed: AC " << AC->name.toLatin1().data()   << " "
-          << _resTime.datestr().c_str()    << " "
-          << _resTime.timestr().c_str()    << endl;
-      break;
-    }
-  }
-  if (acName.isEmpty()) {
+  cmbAC* AC = _mountPoints.value(mountPoint, 0);
+  if (!AC) {
     return;
   }
+  QString acName = AC->name;
+  out << "Provider ID changed: AC " << AC->name.toLatin1().data()   << " "
+      << _resTime.datestr().c_str()    << " "
+      << _resTime.timestr().c_str()    << endl;
 
   // Remove all corrections of the corresponding AC
   // ----------------------------------------------
-  QListIterator<bncTime> itTime(_buffer.keys());
-  while (itTime.hasNext()) {
-    bncTime epoTime = itTime.next();
-    QVector<cmbCorr*>& corrVec = _buffer[epoTime].corrs;
-    QMutableVectorIterator<cmbCorr*> it(corrVec);
+  QMutableMapIterator<bncTime, cmbEpoch> itEpo(_buffer);
+  while (itEpo.hasNext()) {
+    cmbEpoch& epoch = itEpo.next().value();
+    QMutableVectorIterator<int> it(epoch.corrs);
     while (it.hasNext()) {
-      cmbCorr* corr = it.next();
-      if (acName == corr->_acName) {
-        delete corr;
+      int            iSlab = it.next();
+      const cmbCorr& corr  = epoch.slab[iSlab];
+      if (corr._acIndex == AC->index) {
+        epoch.slot[AC->index * (t_prn::MAXPRN + 1) + corr._clkCorr._prn.toInt()] = -1;
+        epoch.freed.push_back(iSlab);
         it.remove();
       }
     }
@@ -1231,13 +1275,17 @@ void bncComb::slotProviderIDChanged(QString mountPoint) {
   // Reset Satellite Offsets
   // -----------------------
   if (_method == filter) {
-    for (int iPar = 1; iPar <= _params.size(); iPar++) {
-      cmbParam* pp = _params[iPar-1];
-      if (pp->AC == acName && pp->type == cmbParam::offACSat) {
-        pp->xx = 0.0;
-        _QQ.Row(iPar)    = 0.0;
-        _QQ.Column(iPar) = 0.0;
-        _QQ(iPar,iPar) = pp->sig0 * pp->sig0;
+    QListIterator<cmbSys*> itSys(_systems);
+    while (itSys.hasNext()) {
+      cmbSys* sys = itSys.next();
+      for (int iPar = 1; iPar <= sys->params.size(); iPar++) {
+        cmbParam* pp = sys->params[iPar-1];
+        if (pp->AC == acName && pp->type == cmbParam::offACSat) {
+          pp->xx = 0.0;
+          sys->QQ.Row(iPar)    = 0.0;
+          sys->QQ.Column(iPar) = 0.0;
+          sys->QQ(iPar,iPar) = pp->sig0 * pp->sig0;
+        }
       }
     }
   }
@@ -34,7 +34,7 @@ class bncComb : public QObject {
 
   class cmbParam {
    public:
-    enum parType {offACgps, offACglo, offACSat, clkSat};
+    enum parType {offACSys, offACSat, clkSat};
     cmbParam(parType type_, int index_, const QString& ac_, const QString& prn_);
     ~cmbParam();
     double partial(const QString& AC_, const QString& prn_);
@@ -53,14 +53,18 @@ class bncComb : public QObject {
   class cmbAC {
    public:
     cmbAC() {
+      index  = 0;
       weight = 0.0;
       numObs = 0;
+      orbCorr.resize(t_prn::MAXPRN + 1);
     }
     ~cmbAC() {}
-    QString  mountPoint;
-    QString  name;
-    double   weight;
-    unsigned numObs;
+    int                index;
+    QString            mountPoint;
+    QString            name;
+    double             weight;
+    unsigned           numObs;
+    QVector<t_orbCorr> orbCorr; // latest orbit correction, indexed by t_prn::toInt()
   };
 
   class cmbCorr {
@@ -68,6 +72,7 @@ class bncComb : public QObject {
     cmbCorr() {
       _eph        = 0;
       _iod        = 0;
+      _acIndex    = 0;
       _dClkResult = 0.0;
     }
     ~cmbCorr() {}
@@ -78,52 +83,76 @@ class bncComb : public QObject {
     t_orbCorr     _orbCorr;
     t_clkCorr     _clkCorr;
     QString       _acName;
+    int           _acIndex;
     double        _dClkResult;
     ColumnVector  _diffRao;
     QString ID() {return _acName + "_" + _prn;}
   };
 
-  class cmbEpoch {
+  // Parameters and covariance matrix of one satellite system; the systems
+  // share no parameters, so each block is estimated independently
+  class cmbSys {
    public:
-    cmbEpoch() {}
-    ~cmbEpoch() {
-      QVectorIterator<cmbCorr*> it(corrs);
-      while (it.hasNext()) {
-        delete it.next();
+    cmbSys(char sys_) {
+      sys = sys_;
+    }
+    ~cmbSys() {
+      for (int iPar = 1; iPar <= params.size(); iPar++) {
+        delete params[iPar-1];
       }
     }
-    QVector<cmbCorr*> corrs;
+    char               sys;
+    QVector<cmbParam*> params;
+    SymmetricMatrix    QQ;
+  };
+
+  // Corrections of one epoch are stored by value in a slab reserved once;
+  // slot maps (AC index, PRN index) to the slab position (-1 if empty),
+  // corrs lists the slab positions in use, unused ones are kept in freed
+  class cmbEpoch {
+   public:
+    cmbEpoch() {}
+    ~cmbEpoch() {}
+    QVector<cmbCorr>  slab;
+    QVector<int>      slot;
+    QVector<int>      corrs;
+    QVector<int>      freed;
   };
 
   void  processEpoch();
-  t_irc processEpoch_filter(QTextStream& out, QMap<QString, cmbCorr*>& resCorr,
-                            ColumnVector& dx);
-  t_irc processEpoch_singleEpoch(QTextStream& out, QMap<QString, cmbCorr*>& resCorr,
-                                 ColumnVector& dx);
-  t_irc createAmat(Matrix& AA, ColumnVector& ll, DiagonalMatrix& PP,
+  t_irc processEpoch_filter(QTextStream& out, cmbSys* sys, QVector<cmbCorr*>& sysCorrs,
+                            QMap<QString, cmbCorr*>& resCorr, ColumnVector& dx);
+  t_irc processEpoch_singleEpoch(QTextStream& out, cmbSys* sys, QVector<cmbCorr*>& sysCorrs,
+                                 QMap<QString, cmbCorr*>& resCorr, ColumnVector& dx);
+  t_irc createAmat(cmbSys* sys, const QVector<cmbCorr*>& sysCorrs,
+                   Matrix& AA, ColumnVector& ll, DiagonalMatrix& PP,
                    const ColumnVector& x0, QMap<QString, cmbCorr*>& resCorr);
+  void  initParams(cmbSys* sys);
+  cmbSys* findSys(char sys) const;
+  static unsigned maxPrn(char sys);
+  static int      prnFlags(char sys);
+  static QString  prnString(char sys, unsigned number);
   void  dumpResults(const QMap<QString, cmbCorr*>& resCorr);
   void  printResults(QTextStream& out, const QMap<QString, cmbCorr*>& resCorr);
   void  switchToLastEph(t_eph* lastEph, cmbCorr* corr);
   t_irc checkOrbits(QTextStream& out);
-  QVector<cmbCorr*>& corrs() {return _buffer[_resTime].corrs;}
+  QVector<cmbCorr*>& corrs() {return _corrs;}
 
   QMutex                                 _mutex;
   QList<cmbAC*>                          _ACs;
   bncTime                                _resTime;
-  QVector<cmbParam*>                     _params;
+  QList<cmbSys*>                         _systems;
   QMap<bncTime, cmbEpoch>                _buffer;
+  QVector<cmbCorr*>                      _corrs;  // of the epoch being processed
   bncRtnetDecoder*                       _rtnetDecoder;
-  SymmetricMatrix                        _QQ;
   QByteArray                             _log;
   bncAntex*                              _antex;
   double                                 _MAXRES;
   QString                                _masterOrbitAC;
   unsigned                               _masterMissingEpochs;
   e_method                               _method;
-  bool                                   _useGlonass;
   int                                    _cmbSampl;
-  QMap<QString, QMap<t_prn, t_orbCorr> > _orbCorrections;
+  QHash<QString, cmbAC*>                 _mountPoints;
   bncEphUser                             _ephUser;
 };
 
@@ -35,6 +35,8 @@ class t_eph {
   t_irc   getCrd(const bncTime& tt, ColumnVector& xc, ColumnVector& vv, bool useCorr) const;
   void    setOrbCorr(const t_orbCorr* orbCorr);
   void    setClkCorr(const t_clkCorr* clkCorr);
+  const t_orbCorr* orbCorr() const {return _orbCorr;}
+  const t_clkCorr* clkCorr() const {return _clkCorr;}
   const QDateTime& receptDateTime() const {return _receptDateTime;}
   static QString rinexDateStr(const bncTime& tt, const t_prn& prn, double version);
   static QString rinexDateStr(const bncTime& tt, const QString& prnStr, double version);
@@ -39,14 +39,10 @@
  * -----------------------------------------------------------------------*/
 
 #include <iostream>
-
-#ifdef WIN32
-#include <windows.h>
-#else
-#include <unistd.h>
-#endif
+#include <math.h>
 
 #include "latencychecker.h"
+#include "bncalertservice.h"
 #include "bnccore.h"
 #include "bncutils.h"
 #include "bncsettings.h"
@@ -322,10 +318,25 @@ void latencyChecker::checkObsLatency(const QList<t_satObs>& obsList) {
   if (_miscIntr > 0 ) {
     t_latency& l = _lObs;
     l._type =  "Observations";
+
+    // Current GPS time, needed once per call only
+    // -------------------------------------------
+    int      currWeek;
+    double   currSec;
+    currentGPSWeeks(currWeek, currSec);
+    const double secPerWeek = 7.0 * 24.0 * 3600.0;
+
+    // One check per epoch (the satellites of an epoch follow each other)
+    // ------------------------------------------------------------------
+    bncTime lastEpoch;
     QListIterator<t_satObs> it(obsList);
     while (it.hasNext()) {
       const t_satObs& obs = it.next();
-      bool wrongObservationEpoch = checkForWrongObsEpoch(obs._time);
+      if (obs._time == lastEpoch) {
+        continue;
+      }
+      lastEpoch = obs._time;
+      bool wrongObservationEpoch = checkForWrongObsEpoch(obs._time, currWeek, currSec);
       l._newSec = static_cast<int>(obs._time.gpssec());
       if (l._newSec > l._oldSec && !wrongObservationEpoch) {
         if (l._newSec % _miscIntr < l._oldSec % _miscIntr) {
@@ -371,10 +382,8 @@ void latencyChecker::checkObsLatency(const QList<t_satObs>& obsList) {
 
         // Compute the observations latency
         // --------------------------------
-        int      week;
-        double   sec;
-        currentGPSWeeks(week, sec);
-        const double secPerWeek = 7.0 * 24.0 * 3600.0;
+        int      week = currWeek;
+        double   sec  = currSec;
         if (week < int(obs._time.gpsw())) {
           week += 1;
           sec  -= secPerWeek;
@@ -541,16 +550,10 @@ void latencyChecker::checkCorrLatency(int corrGPSEpochTime, int type) {
    }
 }
 
-// Call advisory notice script
+// Call advisory notice script (in the thread of the alert service)
 ////////////////////////////////////////////////////////////////////////////
 void latencyChecker::callScript(const char* comment) {
   if (!_adviseScript.isEmpty()) {
-#ifdef WIN32
-    Sleep(1);
-    QProcess::startDetached(_adviseScript, QStringList() << _staID << comment) ;
-#else
-    sleep(1);
-    QProcess::startDetached("nohup", QStringList() << _adviseScript << _staID << comment) ;
-#endif
+    bncAlertService::instance()->post(_adviseScript, _staID, comment);
   }
 }
@@ -44,6 +44,9 @@
 #include "pppMain.h"
 #include "pppCrdFile.h"
 #include "bncsettings.h"
+#ifdef USE_PPP_SSR_I
+#include "pppSatCache.h"
+#endif
 
 using namespace BNC_PPP;
 using namespace std;
@@ -114,6 +117,18 @@ void t_pppMain::stop() {
     _pppThreads.clear();
   }
 
+#ifdef USE_PPP_SSR_I
+  // Satellite positions shared between the PPP clients of this session
+  // ------------------------------------------------------------------
+  t_pppSatCache* satCache = t_pppSatCache::instance();
+  if (satCache->numHits() + satCache->numMisses() > 0) {
+    BNC_CORE->slotMessage(QString("PPP satellite cache: %1 hits, %2 misses, hit rate %3%")
+                          .arg(satCache->numHits()).arg(satCache->numMisses())
+                          .arg(100.0 * satCache->hitRate(), 0, 'f', 1).toLatin1(), false);
+  }
+  satCache->clear();
+#endif
+
   _running = false;
 }
 
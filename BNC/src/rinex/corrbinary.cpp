@@ -0,0 +1,422 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      t_corrBinary
+ *
+ * Purpose:    Binary format of the correction files
+ *
+ * Author:     BKG
+ *
+ * Created:    18-Oct-2026
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include <string.h>
+#include "corrbinary.h"
+
+using namespace std;
+
+const char* t_corrBinary::_magic = "BNCCORRB";
+
+// Epoch Header
+////////////////////////////////////////////////////////////////////////////
+static t_corrBinary::t_epoHead epoHead(t_corrSSR::e_type type, const bncTime& epoTime,
+                                       unsigned int updateInt, int numRecords,
+                                       const string& staID) {
+  t_corrBinary::t_epoHead head;
+  memset(&head, 0, sizeof(head));
+  head._daysec     = epoTime.daysec();
+  head._mjd        = epoTime.mjd();
+  head._type       = type;
+  head._updateInt  = updateInt;
+  head._numRecords = numRecords;
+  strncpy(head._staID, staID.c_str(), sizeof(head._staID) - 1);
+  return head;
+}
+
+// Epoch Time
+////////////////////////////////////////////////////////////////////////////
+static bncTime epoTime(const t_corrBinary::t_epoHead& head) {
+  bncTime tt;
+  tt.setmjd(head._daysec, head._mjd);
+  return tt;
+}
+
+// Station ID
+////////////////////////////////////////////////////////////////////////////
+static string staID(const t_corrBinary::t_epoHead& head) {
+  return string(head._staID, strnlen(head._staID, sizeof(head._staID)));
+}
+
+// Store a Signal Type (at most 2 characters)
+////////////////////////////////////////////////////////////////////////////
+static void setType(char* field, const string& type) {
+  strncpy(field, type.c_str(), 2);
+}
+
+// Signal Type of a Record
+////////////////////////////////////////////////////////////////////////////
+static string getType(const char* field) {
+  return string(field, strnlen(field, 2));
+}
+
+// Write the File Header
+////////////////////////////////////////////////////////////////////////////
+void t_corrBinary::writeFileHead(ostream* out) {
+  if (!out) {
+    return;
+  }
+  t_fileHead head;
+  memcpy(head._magic, _magic, sizeof(head._magic));
+  head._byteOrder = _byteOrder;
+  head._version   = 1;
+  out->write(reinterpret_cast<const char*>(&head), sizeof(head));
+}
+
+// Write Orbit Corrections
+////////////////////////////////////////////////////////////////////////////
+void t_corrBinary::writeEpoch(ostream* out, const QList<t_orbCorr>& corrList) {
+  if (!out || corrList.size() == 0) {
+    return;
+  }
+  const t_orbCorr& first = corrList[0];
+  t_epoHead head = epoHead(t_corrSSR::orbCorr, first._time, first._updateInt,
+                           corrList.size(), first._staID);
+  out->write(reinterpret_cast<const char*>(&head), sizeof(head));
+
+  for (int ii = 0; ii < corrList.size(); ii++) {
+    const t_orbCorr& corr = corrList[ii];
+    t_orbRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    for (int jj = 0; jj < 3; jj++) {
+      rec._xr[jj]    = corr._xr[jj];
+      rec._dotXr[jj] = corr._dotXr[jj];
+    }
+    rec._iod      = corr._iod;
+    rec._prnNum   = corr._prn.number();
+    rec._prnFlags = corr._prn.flags();
+    rec._prnSys   = corr._prn.system();
+    out->write(reinterpret_cast<const char*>(&rec), sizeof(rec));
+  }
+}
+
+// Write Clock Corrections
+////////////////////////////////////////////////////////////////////////////
+void t_corrBinary::writeEpoch(ostream* out, const QList<t_clkCorr>& corrList) {
+  if (!out || corrList.size() == 0) {
+    return;
+  }
+  const t_clkCorr& first = corrList[0];
+  t_epoHead head = epoHead(t_corrSSR::clkCorr, first._time, first._updateInt,
+                           corrList.size(), first._staID);
+  out->write(reinterpret_cast<const char*>(&head), sizeof(head));
+
+  for (int ii = 0; ii < corrList.size(); ii++) {
+    const t_clkCorr& corr = corrList[ii];
+    t_clkRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    rec._dClk       = corr._dClk;
+    rec._dotDClk    = corr._dotDClk;
+    rec._dotDotDClk = corr._dotDotDClk;
+    rec._iod        = corr._iod;
+    rec._prnNum     = corr._prn.number();
+    rec._prnFlags   = corr._prn.flags();
+    rec._prnSys     = corr._prn.system();
+    out->write(reinterpret_cast<const char*>(&rec), sizeof(rec));
+  }
+}
+
+// Write Code Biases
+////////////////////////////////////////////////////////////////////////////
+void t_corrBinary::writeEpoch(ostream* out, const QList<t_satCodeBias>& biasList) {
+  if (!out || biasList.size() == 0) {
+    return;
+  }
+  int numRecords = 0;
+  for (int ii = 0; ii < biasList.size(); ii++) {
+    numRecords += qMax(int(biasList[ii]._bias.size()), 1);
+  }
+  const t_satCodeBias& first = biasList[0];
+  t_epoHead head = epoHead(t_corrSSR::codeBias, first._time, first._updateInt,
+                           numRecords, first._staID);
+  out->write(reinterpret_cast<const char*>(&head), sizeof(head));
+
+  for (int ii = 0; ii < biasList.size(); ii++) {
+    const t_satCodeBias& satCodeBias = biasList[ii];
+    unsigned jj = 0;
+    do {
+      t_codeBiasRecord rec;
+      memset(&rec, 0, sizeof(rec));
+      rec._prnNum   = satCodeBias._prn.number();
+      rec._prnFlags = satCodeBias._prn.flags();
+      rec._prnSys   = satCodeBias._prn.system();
+      if (jj < satCodeBias._bias.size()) {
+        const t_frqCodeBias& frqCodeBias = satCodeBias._bias[jj];
+        rec._value = frqCodeBias._value;
+        setType(rec._rnxType2ch, frqCodeBias._rnxType2ch);
+      }
+      out->write(reinterpret_cast<const char*>(&rec), sizeof(rec));
+    } while (++jj < satCodeBias._bias.size());
+  }
+}
+
+// Write Phase Biases
+////////////////////////////////////////////////////////////////////////////
+void t_corrBinary::writeEpoch(ostream* out, const QList<t_satPhaseBias>& biasList) {
+  if (!out || biasList.size() == 0) {
+    return;
+  }
+  int numRecords = 0;
+  for (int ii = 0; ii < biasList.size(); ii++) {
+    numRecords += qMax(int(biasList[ii]._bias.size()), 1);
+  }
+  const t_satPhaseBias& first = biasList[0];
+  t_epoHead head = epoHead(t_corrSSR::phaseBias, first._time, first._updateInt,
+                           numRecords, first._staID);
+  head._dispBiasConstistInd = first._dispBiasConstistInd;
+  head._MWConsistInd        = first._MWConsistInd;
+  out->write(reinterpret_cast<const char*>(&head), sizeof(head));
+
+  for (int ii = 0; ii < biasList.size(); ii++) {
+    const t_satPhaseBias& satPhaseBias = biasList[ii];
+    unsigned jj = 0;
+    do {
+      t_phaseBiasRecord rec;
+      memset(&rec, 0, sizeof(rec));
+      rec._yawDeg     = satPhaseBias._yawDeg;
+      rec._yawDegRate = satPhaseBias._yawDegRate;
+      rec._prnNum     = satPhaseBias._prn.number();
+      rec._prnFlags   = satPhaseBias._prn.flags();
+      rec._prnSys     = satPhaseBias._prn.system();
+      if (jj < satPhaseBias._bias.size()) {
+        const t_frqPhaseBias& frqPhaseBias = satPhaseBias._bias[jj];
+        rec._value                = frqPhaseBias._value;
+        rec._fixIndicator         = frqPhaseBias._fixIndicator;
+        rec._fixWideLaneIndicator = frqPhaseBias._fixWideLaneIndicator;
+        rec._jumpCounter          = frqPhaseBias._jumpCounter;
+        setType(rec._rnxType2ch, frqPhaseBias._rnxType2ch);
+      }
+      out->write(reinterpret_cast<const char*>(&rec), sizeof(rec));
+    } while (++jj < satPhaseBias._bias.size());
+  }
+}
+
+// Write VTEC
+////////////////////////////////////////////////////////////////////////////
+void t_corrBinary::writeEpoch(ostream* out, const t_vTec& vTec) {
+  if (!out || vTec._layers.size() == 0) {
+    return;
+  }
+  int numRecords = 0;
+  for (unsigned ii = 0; ii < vTec._layers.size(); ii++) {
+    numRecords += vTec._layers[ii]._C.Nrows() * vTec._layers[ii]._C.Ncols();
+  }
+  t_epoHead head = epoHead(t_corrSSR::vTec, vTec._time, vTec._updateInt,
+                           numRecords, vTec._staID);
+  out->write(reinterpret_cast<const char*>(&head), sizeof(head));
+
+  for (unsigned ii = 0; ii < vTec._layers.size(); ii++) {
+    const t_vTecLayer& layer = vTec._layers[ii];
+    for (int iDeg = 0; iDeg < layer._C.Nrows(); iDeg++) {
+      for (int iOrd = 0; iOrd < layer._C.Ncols(); iOrd++) {
+        t_tecRecord rec;
+        memset(&rec, 0, sizeof(rec));
+        rec._height = layer._height;
+        rec._C      = layer._C[iDeg][iOrd];
+        rec._S      = layer._S[iDeg][iOrd];
+        rec._layer  = ii;
+        rec._degree = iDeg;
+        rec._order  = iOrd;
+        rec._maxDeg = layer._C.Nrows() - 1;
+        rec._maxOrd = layer._C.Ncols() - 1;
+        out->write(reinterpret_cast<const char*>(&rec), sizeof(rec));
+      }
+    }
+  }
+}
+
+// Binary File of this Host
+////////////////////////////////////////////////////////////////////////////
+bool t_corrBinary::isBinary(const char* data, qint64 size) {
+  if (size < qint64(sizeof(t_fileHead))) {
+    return false;
+  }
+  t_fileHead head;
+  memcpy(&head, data, sizeof(head));
+  return memcmp(head._magic, _magic, sizeof(head._magic)) == 0 &&
+         head._byteOrder == _byteOrder && head._version == 1;
+}
+
+// Size of the Records of an Epoch Type (0: unknown type)
+////////////////////////////////////////////////////////////////////////////
+qint64 t_corrBinary::recordSize(int type) {
+  switch (type) {
+    case t_corrSSR::orbCorr:   return sizeof(t_orbRecord);
+    case t_corrSSR::clkCorr:   return sizeof(t_clkRecord);
+    case t_corrSSR::codeBias:  return sizeof(t_codeBiasRecord);
+    case t_corrSSR::phaseBias: return sizeof(t_phaseBiasRecord);
+    case t_corrSSR::vTec:      return sizeof(t_tecRecord);
+    default:                   return 0;
+  }
+}
+
+// Read Orbit Corrections (data: first record)
+////////////////////////////////////////////////////////////////////////////
+void t_corrBinary::readEpoch(const t_epoHead& head, const char* data,
+                             QList<t_orbCorr>& corrList) {
+  bncTime tt = epoTime(head);
+  for (int ii = 0; ii < head._numRecords; ii++) {
+    t_orbRecord rec;
+    memcpy(&rec, data + ii * sizeof(rec), sizeof(rec));
+    t_orbCorr corr;
+    corr._staID     = staID(head);
+    corr._time      = tt;
+    corr._updateInt = head._updateInt;
+    corr._prn.set(rec._prnSys, rec._prnNum, rec._prnFlags);
+    corr._system    = rec._prnSys;
+    corr._iod       = rec._iod;
+    for (int jj = 0; jj < 3; jj++) {
+      corr._xr[jj]    = rec._xr[jj];
+      corr._dotXr[jj] = rec._dotXr[jj];
+    }
+    corrList.push_back(corr);
+  }
+}
+
+// Read Clock Corrections (data: first record)
+////////////////////////////////////////////////////////////////////////////
+void t_corrBinary::readEpoch(const t_epoHead& head, const char* data,
+                             QList<t_clkCorr>& corrList) {
+  bncTime tt = epoTime(head);
+  for (int ii = 0; ii < head._numRecords; ii++) {
+    t_clkRecord rec;
+    memcpy(&rec, data + ii * sizeof(rec), sizeof(rec));
+    t_clkCorr corr;
+    corr._staID      = staID(head);
+    corr._time       = tt;
+    corr._updateInt  = head._updateInt;
+    corr._prn.set(rec._prnSys, rec._prnNum, rec._prnFlags);
+    corr._iod        = rec._iod;
+    corr._dClk       = rec._dClk;
+    corr._dotDClk    = rec._dotDClk;
+    corr._dotDotDClk = rec._dotDotDClk;
+    corrList.push_back(corr);
+  }
+}
+
+// Read Code Biases (data: first record)
+////////////////////////////////////////////////////////////////////////////
+void t_corrBinary::readEpoch(const t_epoHead& head, const char* data,
+                             QList<t_satCodeBias>& biasList) {
+  bncTime tt = epoTime(head);
+  for (int ii = 0; ii < head._numRecords; ii++) {
+    t_codeBiasRecord rec;
+    memcpy(&rec, data + ii * sizeof(rec), sizeof(rec));
+    t_prn prn(rec._prnSys, rec._prnNum, rec._prnFlags);
+    if (biasList.isEmpty() || !(biasList.last()._prn == prn)) {
+      t_satCodeBias satCodeBias;
+      satCodeBias._staID     = staID(head);
+      satCodeBias._time      = tt;
+      satCodeBias._updateInt = head._updateInt;
+      satCodeBias._prn       = prn;
+      biasList.push_back(satCodeBias);
+    }
+    string type = getType(rec._rnxType2ch);
+    if (!type.empty()) {
+      t_frqCodeBias frqCodeBias;
+      frqCodeBias._rnxType2ch = type;
+      frqCodeBias._value      = rec._value;
+      biasList.last()._bias.push_back(frqCodeBias);
+    }
+  }
+}
+
+// Read Phase Biases (data: first record)
+////////////////////////////////////////////////////////////////////////////
+void t_corrBinary::readEpoch(const t_epoHead& head, const char* data,
+                             QList<t_satPhaseBias>& biasList) {
+  bncTime tt = epoTime(head);
+  for (int ii = 0; ii < head._numRecords; ii++) {
+    t_phaseBiasRecord rec;
+    memcpy(&rec, data + ii * sizeof(rec), sizeof(rec));
+    t_prn prn(rec._prnSys, rec._prnNum, rec._prnFlags);
+    if (biasList.isEmpty() || !(biasList.last()._prn == prn)) {
+      t_satPhaseBias satPhaseBias;
+      satPhaseBias._staID               = staID(head);
+      satPhaseBias._time                = tt;
+      satPhaseBias._updateInt           = head._updateInt;
+      satPhaseBias._dispBiasConstistInd = head._dispBiasConstistInd;
+      satPhaseBias._MWConsistInd        = head._MWConsistInd;
+      satPhaseBias._prn                 = prn;
+      satPhaseBias._yawDeg              = rec._yawDeg;
+      satPhaseBias._yawDegRate          = rec._yawDegRate;
+      biasList.push_back(satPhaseBias);
+    }
+    string type = getType(rec._rnxType2ch);
+    if (!type.empty()) {
+      t_frqPhaseBias frqPhaseBias;
+      frqPhaseBias._rnxType2ch           = type;
+      frqPhaseBias._value                = rec._value;
+      frqPhaseBias._fixIndicator         = rec._fixIndicator;
+      frqPhaseBias._fixWideLaneIndicator = rec._fixWideLaneIndicator;
+      frqPhaseBias._jumpCounter          = rec._jumpCounter;
+      biasList.last()._bias.push_back(frqPhaseBias);
+    }
+  }
+}
+
+// Read VTEC (data: first record)
+////////////////////////////////////////////////////////////////////////////
+void t_corrBinary::readEpoch(const t_epoHead& head, const char* data, t_vTec& vTec) {
+  vTec._staID     = staID(head);
+  vTec._time      = epoTime(head);
+  vTec._updateInt = head._updateInt;
+  int lastLayer = -1;
+  for (int ii = 0; ii < head._numRecords; ii++) {
+    t_tecRecord rec;
+    memcpy(&rec, data + ii * sizeof(rec), sizeof(rec));
+    if (rec._layer != lastLayer) {
+      t_vTecLayer layer;
+      layer._height = rec._height;
+      layer._C.ReSize(rec._maxDeg+1, rec._maxOrd+1);
+      layer._S.ReSize(rec._maxDeg+1, rec._maxOrd+1);
+      layer._C = 0.0;
+      layer._S = 0.0;
+      vTec._layers.push_back(layer);
+      lastLayer = rec._layer;
+    }
+    t_vTecLayer& layer = vTec._layers.back();
+    if (rec._degree >= 0 && rec._degree < layer._C.Nrows() &&
+        rec._order  >= 0 && rec._order  < layer._C.Ncols()) {
+      layer._C[rec._degree][rec._order] = rec._C;
+      layer._S[rec._degree][rec._order] = rec._S;
+    }
+  }
+}
@@ -0,0 +1,141 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+#ifndef CORRBINARY_H
+#define CORRBINARY_H
+
+#include <ostream>
+#include <QtCore>
+#include "satObs.h"
+
+// Binary Correction File
+// ----------------------
+// A file header followed by one block per correction epoch. A block is an
+// epoch header and a number of fixed-size records of the epoch's type:
+// one per satellite (orbit, clock), one per satellite and signal (code
+// and phase biases; a satellite without biases has one record with empty
+// signal type) or one per coefficient (VTEC). Values are stored unrounded
+// in the byte order of the writing host; the file header tells the reader
+// whether it can use the file.
+class t_corrBinary {
+ public:
+  static const char*   _magic;     // 8 characters
+  static const quint32 _byteOrder = 0x01020304;
+
+  class t_fileHead {
+   public:
+    char    _magic[8];
+    quint32 _byteOrder;
+    quint32 _version;
+  };
+
+  class t_epoHead {
+   public:
+    double  _daysec;
+    qint32  _mjd;
+    qint32  _type;               // t_corrSSR::e_type
+    qint32  _updateInt;
+    qint32  _numRecords;
+    qint32  _dispBiasConstistInd;
+    qint32  _MWConsistInd;
+    char    _staID[32];
+  };
+
+  class t_orbRecord {
+   public:
+    double  _xr[3];
+    double  _dotXr[3];
+    qint32  _iod;
+    qint32  _prnNum;
+    qint32  _prnFlags;
+    char    _prnSys;
+    char    _pad[3];
+  };
+
+  class t_clkRecord {
+   public:
+    double  _dClk;
+    double  _dotDClk;
+    double  _dotDotDClk;
+    qint32  _iod;
+    qint32  _prnNum;
+    qint32  _prnFlags;
+    char    _prnSys;
+    char    _pad[3];
+  };
+
+  class t_codeBiasRecord {
+   public:
+    double  _value;
+    qint32  _prnNum;
+    qint32  _prnFlags;
+    char    _prnSys;
+    char    _rnxType2ch[3];
+    char    _pad[4];
+  };
+
+  class t_phaseBiasRecord {
+   public:
+    double  _value;
+    double  _yawDeg;
+    double  _yawDegRate;
+    qint32  _fixIndicator;
+    qint32  _fixWideLaneIndicator;
+    qint32  _jumpCounter;
+    qint32  _prnNum;
+    qint32  _prnFlags;
+    char    _prnSys;
+    char    _rnxType2ch[3];
+  };
+
+  class t_tecRecord {
+   public:
+    double  _height;
+    double  _C;
+    double  _S;
+    qint32  _layer;
+    qint32  _degree;
+    qint32  _order;
+    qint32  _maxDeg;
+    qint32  _maxOrd;
+    char    _pad[4];
+  };
+
+  static void writeFileHead(std::ostream* out);
+  static void writeEpoch(std::ostream* out, const QList<t_orbCorr>& corrList);
+  static void writeEpoch(std::ostream* out, const QList<t_clkCorr>& corrList);
+  static void writeEpoch(std::ostream* out, const QList<t_satCodeBias>& biasList);
+  static void writeEpoch(std::ostream* out, const QList<t_satPhaseBias>& biasList);
+  static void writeEpoch(std::ostream* out, const t_vTec& vTec);
+
+  static bool   isBinary(const char* data, qint64 size);
+  static qint64 recordSize(int type);
+  static void   readEpoch(const t_epoHead& head, const char* data, QList<t_orbCorr>& corrList);
+  static void   readEpoch(const t_epoHead& head, const char* data, QList<t_clkCorr>& corrList);
+  static void   readEpoch(const t_epoHead& head, const char* data, QList<t_satCodeBias>& biasList);
+  static void   readEpoch(const t_epoHead& head, const char* data, QList<t_satPhaseBias>& biasList);
+  static void   readEpoch(const t_epoHead& head, const char* data, t_vTec& vTec);
+};
+
+#endif
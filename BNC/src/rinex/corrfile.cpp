@@ -39,9 +39,11 @@
  * -----------------------------------------------------------------------*/
 
 #include <iostream>
+#include <string.h>
 #include "corrfile.h"
 #include "bncutils.h"
 #include "bncephuser.h"
+#include "corrbinary.h"
 
 using namespace std;
 
@@ -49,6 +51,29 @@ using namespace std;
 ////////////////////////////////////////////////////////////////////////////
 t_corrFile::t_corrFile(QString fileName) {
   expandEnvVar(fileName);
+  _data    = 0;
+  _size    = 0;
+  _nextEpo = 0;
+
+  // Binary files are mapped into memory and indexed
+  // -----------------------------------------------
+  _file.setFileName(fileName);
+  if (_file.open(QIODevice::ReadOnly)) {
+    QByteArray head = _file.peek(sizeof(t_corrBinary::t_fileHead));
+    if (t_corrBinary::isBinary(head.constData(), head.size())) {
+      _size = _file.size();
+      _data = reinterpret_cast<const char*>(_file.map(0, _size));
+      if (!_data) {
+        _buffer = _file.readAll();
+        _data   = _buffer.constData();
+        _size   = _buffer.size();
+      }
+      indexBinary();
+      return;
+    }
+    _file.close();
+  }
+
   _stream.open(fileName.toLatin1().data());
 }
 
@@ -57,10 +82,87 @@ t_corrFile::t_corrFile(QString fileName) {
 t_corrFile::~t_corrFile() {
 }
 
+// Index of the Epochs of a Binary File (an incomplete last epoch is ignored)
+////////////////////////////////////////////////////////////////////////////
+void t_corrFile::indexBinary() {
+  qint64 offset = sizeof(t_corrBinary::t_fileHead);
+  while (offset + qint64(sizeof(t_corrBinary::t_epoHead)) <= _size) {
+    t_corrBinary::t_epoHead head;
+    memcpy(&head, _data + offset, sizeof(head));
+    qint64 recSize = t_corrBinary::recordSize(head._type);
+    if (recSize == 0 || head._numRecords < 0) {
+      break;
+    }
+    qint64 next = offset + sizeof(head) + head._numRecords * recSize;
+    if (next > _size) {
+      break;
+    }
+    t_epoIndex epo;
+    epo._time.setmjd(head._daysec, head._mjd);
+    epo._offset = offset;
+    _index.push_back(epo);
+    offset = next;
+  }
+}
+
+// Read till a given time (binary file)
+////////////////////////////////////////////////////////////////////////////
+void t_corrFile::syncReadBinary(const bncTime& tt) {
+
+  while (_nextEpo < _index.size() && _index[_nextEpo]._time <= tt) {
+
+    const char* data = _data + _index[_nextEpo]._offset;
+    t_corrBinary::t_epoHead head;
+    memcpy(&head, data, sizeof(head));
+    data += sizeof(head);
+    ++_nextEpo;
+
+    if      (head._type == t_corrSSR::clkCorr) {
+      QList<t_clkCorr> clkCorrList;
+      t_corrBinary::readEpoch(head, data, clkCorrList);
+      emit newClkCorrections(clkCorrList);
+    }
+    else if (head._type == t_corrSSR::orbCorr) {
+      QList<t_orbCorr> orbCorrList;
+      t_corrBinary::readEpoch(head, data, orbCorrList);
+      QListIterator<t_orbCorr> it(orbCorrList);
+      while (it.hasNext()) {
+        const t_orbCorr& corr = it.next();
+        _corrIODs[QString(corr._prn.toInternalString().c_str())] = corr._iod;
+      }
+      emit newOrbCorrections(orbCorrList);
+    }
+    else if (head._type == t_corrSSR::codeBias) {
+      QList<t_satCodeBias> satCodeBiasList;
+      t_corrBinary::readEpoch(head, data, satCodeBiasList);
+      emit newCodeBiases(satCodeBiasList);
+    }
+    else if (head._type == t_corrSSR::phaseBias) {
+      QList<t_satPhaseBias> satPhaseBiasList;
+      t_corrBinary::readEpoch(head, data, satPhaseBiasList);
+      emit newPhaseBiases(satPhaseBiasList);
+    }
+    else if (head._type == t_corrSSR::vTec) {
+      t_vTec vTec;
+      t_corrBinary::readEpoch(head, data, vTec);
+      emit newTec(vTec);
+    }
+  }
+
+  if (_nextEpo >= _index.size()) {
+    throw "t_corrFile: end of file";
+  }
+}
+
 // Read till a given time
 ////////////////////////////////////////////////////////////////////////////
 void t_corrFile::syncRead(const bncTime& tt) {
 
+  if (_data) {
+    syncReadBinary(tt);
+    return;
+  }
+
   while (_stream.good() && (!_lastEpoTime.valid() || _lastEpoTime <= tt)) {
 
     if (_lastLine.empty()) {
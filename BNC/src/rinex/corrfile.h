@@ -38,6 +38,7 @@ class t_corrFile : public QObject {
   t_corrFile(QString fileName);
   ~t_corrFile();
   void syncRead(const bncTime& tt);
+  bool isBinary() const {return _data != 0;}
   const QMap<QString, unsigned int>& corrIODs() const {return _corrIODs;}
 
  signals:
@@ -48,10 +49,25 @@ class t_corrFile : public QObject {
   void newTec(t_vTec);
 
  private:
+  class t_epoIndex {
+   public:
+    bncTime _time;
+    qint64  _offset;  // epoch header
+  };
+
+  void indexBinary();
+  void syncReadBinary(const bncTime& tt);
+
   std::ifstream               _stream;
   std::string                 _lastLine;
   bncTime                     _lastEpoTime;
   QMap<QString, unsigned int> _corrIODs;
+  QFile                       _file;
+  const char*                 _data;    // binary file, mapped
+  qint64                      _size;
+  QByteArray                  _buffer;  // binary file, if it cannot be mapped
+  QVector<t_epoIndex>         _index;
+  int                         _nextEpo;
 };
 
 #endif
@@ -56,6 +56,8 @@
 
 using namespace std;
 
+const double CHUNKSTEP = 600.0; // multipath is analyzed in chunks of 10 minutes
+
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
 t_reqcAnalyze::t_reqcAnalyze(QObject* parent) : QThread(parent) {
@@ -65,7 +67,8 @@ t_reqcAnalyze::t_reqcAnalyze(QObject* parent) : QThread(parent) {
   _logFileName     = settings.value("reqcOutLogFile").toString(); expandEnvVar(_logFileName);
   _logFile         = 0;
   _log             = 0;
-  _currEpo         = 0;
+  _logSummaryOnly  = Qt::CheckState(settings.value("reqcLogSummaryOnly").toInt()) == Qt::Checked;
+  _satPool         = new QThreadPool();
   _obsFileNames    = settings.value("reqcObsFile").toString().split(",", QString::SkipEmptyParts);
   _navFileNames    = settings.value("reqcNavFile").toString().split(",", QString::SkipEmptyParts);
   _reqcPlotSignals = settings.value("reqcSkyPlotSignals").toString();
@@ -89,6 +92,7 @@ t_reqcAnalyze::t_reqcAnalyze(QObject* parent) : QThread(parent) {
 // Destructor
 ////////////////////////////////////////////////////////////////////////////
 t_reqcAnalyze::~t_reqcAnalyze() {
+  delete _satPool;
   for (int ii = 0; ii < _rnxObsFiles.size(); ii++) {
     delete _rnxObsFiles[ii];
   }
@@ -135,10 +139,33 @@ void t_reqcAnalyze::run() {
   // ----------------
   t_reqcEdit::readEphemerides(_navFileNames, _ephs);
 
-  // Loop over all RINEX Files
-  // -------------------------
+  // Analyze the RINEX Files concurrently, report them in input order
+  // (only a limited number of files is analyzed ahead of the report)
+  // ----------------------------------------------------------------
+  QThreadPool        filePool;
+  const int          maxAhead = 2 * filePool.maxThreadCount();
+  QVector<t_qcFile*> qcFiles(_rnxObsFiles.size(), 0);
+  int                nextFile = 0;
   for (int ii = 0; ii < _rnxObsFiles.size(); ii++) {
-    analyzeFile(_rnxObsFiles[ii]);
+    while (nextFile < _rnxObsFiles.size() && nextFile < ii + maxAhead) {
+      qcFiles[nextFile] = new t_qcFile(_rnxObsFiles[nextFile]);
+      filePool.start(new t_fileTask(this, qcFiles[nextFile]));
+      ++nextFile;
+    }
+    t_qcFile* qcFile = qcFiles[ii];
+    qcFile->_done.acquire();
+    if (_log) {
+      *_log << qcFile->_report;
+      _log->flush();
+      if (qcFile->_epoFile) {
+        qcFile->_epoFile->seek(0);
+        while (!qcFile->_epoFile->atEnd()) {
+          _logFile->write(qcFile->_epoFile->read(1 << 20));
+        }
+      }
+    }
+    dspPlots(qcFile);
+    delete qcFile;
   }
 
   // Exit
@@ -147,6 +174,20 @@ void t_reqcAnalyze::run() {
   deleteLater();
 }
 
+// Analyze one File (runs in the file thread pool)
+////////////////////////////////////////////////////////////////////////////
+void t_reqcAnalyze::t_fileTask::run() {
+  _reqcAnalyze->analyzeFile(_qcFile);
+  _qcFile->_done.release();
+}
+
+// Analyze one Satellite of a File (runs in the satellite thread pool)
+////////////////////////////////////////////////////////////////////////////
+void t_reqcAnalyze::t_satTask::run() {
+  *_result = _reqcAnalyze->expectedObs(_qcFile, _prn);
+  _done->release();
+}
+
 //
 ////////////////////////////////////////////////////////////////////////////
 void t_reqcAnalyze::analyzePlotSignals(QMap<char, QVector<QString> >& signalTypes) {
@@ -183,85 +224,207 @@ void t_reqcAnalyze::analyzePlotSignals(QMap<char, QVector<QString> >& signalType
   }
 }
 
+// Index of a satellite in t_qcFile::_ephIndex (-1 if out of range)
+////////////////////////////////////////////////////////////////////////////
+static int ephIndex(const t_prn& prn) {
+  unsigned maxPrn = 0;
+  switch (prn.system()) {
+    case 'G': maxPrn = t_prn::MAXPRN_GPS;     break;
+    case 'R': maxPrn = t_prn::MAXPRN_GLONASS; break;
+    case 'E': maxPrn = t_prn::MAXPRN_GALILEO; break;
+    case 'J': maxPrn = t_prn::MAXPRN_QZSS;    break;
+    case 'S': maxPrn = t_prn::MAXPRN_SBAS;    break;
+    case 'C': maxPrn = t_prn::MAXPRN_BDS;     break;
+    case 'I': maxPrn = t_prn::MAXPRN_IRNSS;   break;
+  }
+  if (prn.number() == 0 || prn.number() > maxPrn) {
+    return -1;
+  }
+  return prn.toInt();
+}
+
+// Ephemerides used for one File (the first one of each satellite)
+////////////////////////////////////////////////////////////////////////////
+void t_reqcAnalyze::initEphIndex(t_qcFile* qcFile) const {
+
+  qcFile->_ephIndex.fill(0, t_prn::MAXPRN + 1);
+
+  for (int ie = 0; ie < _ephs.size(); ie++) {
+    t_eph* eph  = _ephs[ie];
+    int    iPrn = ephIndex(eph->prn());
+    if (iPrn < 0 || qcFile->_ephIndex[iPrn] != 0) {
+      continue;
+    }
+    if (eph->type() == t_eph::GLONASS) {
+      t_eph* ephGlo = new t_ephGlo(*dynamic_cast<t_ephGlo*>(eph));
+      qcFile->_ownEphs.append(ephGlo);
+      qcFile->_ephIndex[iPrn] = ephGlo;
+    }
+    else {
+      qcFile->_ephIndex[iPrn] = eph;
+    }
+  }
+}
+
 //
 ////////////////////////////////////////////////////////////////////////////
-void t_reqcAnalyze::analyzeFile(t_rnxObsFile* obsFile) {
+void t_reqcAnalyze::analyzeFile(t_qcFile* qcFile) const {
 
-  _qcFile.clear();
+  t_rnxObsFile* obsFile = qcFile->_obsFile;
 
   // A priori Coordinates
   // --------------------
-  ColumnVector xyzSta = obsFile->xyz();
+  qcFile->_xyzSta = obsFile->xyz();
+
+  // Ephemerides
+  // -----------
+  initEphIndex(qcFile);
 
   // Loop over all Epochs
   // --------------------
   try {
-    QMap<QString, bncTime> lastObsTime;
-    bool firstEpo = true;
-    while ( (_currEpo = obsFile->nextEpoch()) != 0) {
+    if (_log && !_logSummaryOnly) {
+      qcFile->_epoFile = new QTemporaryFile();
+      if (!qcFile->_epoFile->open()) {
+        throw QString("cannot open temporary file ") + qcFile->_epoFile->fileTemplate();
+      }
+    }
+    QMap<QString, bncTime>  lastObsTime;
+    bool                    firstEpo = true;
+    t_rnxObsFile::t_rnxEpo* epo      = 0;
+    while ( (epo = obsFile->nextEpoch()) != 0) {
       if (firstEpo) {
         firstEpo = false;
-        _qcFile._startTime    = _currEpo->tt;
-        _qcFile._antennaName  = obsFile->antennaName();
-        _qcFile._markerName   = obsFile->markerName();
-        _qcFile._receiverType = obsFile->receiverType();
-        _qcFile._interval     = obsFile->interval();
+        qcFile->_startTime    = epo->tt;
+        qcFile->_antennaName  = obsFile->antennaName();
+        qcFile->_markerName   = obsFile->markerName();
+        qcFile->_receiverType = obsFile->receiverType();
+        qcFile->_interval     = obsFile->interval();
+      }
+      qcFile->_endTime = epo->tt;
+
+      int chunk = int(floor((epo->tt - qcFile->_startTime) / CHUNKSTEP));
+      if (chunk != qcFile->_chunk) {
+        closeChunk(qcFile);
+        qcFile->_chunk = chunk;
       }
-      _qcFile._endTime = _currEpo->tt;
 
       t_qcEpo qcEpo;
-      qcEpo._epoTime = _currEpo->tt;
-      qcEpo._PDOP    = cmpDOP(xyzSta);
+      qcEpo._epoTime = epo->tt;
+      qcEpo._PDOP    = cmpDOP(qcFile, epo);
 
       // Loop over all satellites
       // ------------------------
-      for (unsigned iObs = 0; iObs < _currEpo->rnxSat.size(); iObs++) {
-        const t_rnxObsFile::t_rnxSat& rnxSat = _currEpo->rnxSat[iObs];
+      for (unsigned iObs = 0; iObs < epo->rnxSat.size(); iObs++) {
+        const t_rnxObsFile::t_rnxSat& rnxSat = epo->rnxSat[iObs];
         if (_navFileNames.size() &&
-            _numExpObs.find(rnxSat.prn) == _numExpObs.end()) {
-          _numExpObs[rnxSat.prn] = 0;
+            qcFile->_numExpObs.find(rnxSat.prn) == qcFile->_numExpObs.end()) {
+          qcFile->_numExpObs[rnxSat.prn] = 0;
         }
-        if (_signalTypes.find(rnxSat.prn.system()) == _signalTypes.end()) {
+        if (!_signalTypes.contains(rnxSat.prn.system())) {
           continue;
         }
         t_satObs satObs;
-        t_rnxObsFile::setObsFromRnx(obsFile, _currEpo, rnxSat, satObs);
+        t_rnxObsFile::setObsFromRnx(obsFile, epo, rnxSat, satObs);
         t_qcSat& qcSat = qcEpo._qcSat[satObs._prn];
-        setQcObs(qcEpo._epoTime, xyzSta, satObs, lastObsTime, qcSat);
-        updateQcSat(qcSat, _qcFile._qcSatSum[satObs._prn]);
+        setQcObs(qcFile, qcEpo._epoTime, satObs, lastObsTime, qcSat);
+        updateQcSat(qcSat, qcFile->_qcSatSum[satObs._prn]);
       }
-      _qcFile._qcEpo.push_back(qcEpo);
+      qcFile->_qcEpo.push_back(qcEpo);
     }
-
-    analyzeMultipath();
+    closeChunk(qcFile);
 
     if (_navFileNames.size()) {
-      setExpectedObs(_qcFile._startTime, _qcFile._endTime, _qcFile._interval, xyzSta);
+      runSatTasks(qcFile);
     }
 
-    preparePlotData(obsFile);
+    preparePlotData(qcFile);
 
-    printReport(obsFile);
+    if (_log) {
+      QTextStream out(&qcFile->_report, QIODevice::WriteOnly);
+      printReport(qcFile, out);
+    }
   }
   catch (QString str) {
     if (_log) {
-      *_log << "Exception " << str << endl;
+      QTextStream out(&qcFile->_report, QIODevice::WriteOnly | QIODevice::Append);
+      out << "Exception " << str << endl;
     }
     else {
       qDebug() << str;
     }
+    delete qcFile->_epoFile;
+    qcFile->_epoFile = 0;
+  }
+
+  // Epoch-wise data are no longer needed
+  // ------------------------------------
+  qcFile->_qcEpo.clear();
+  qcFile->_qcEpo.squeeze();
+}
+
+// Finish the Chunk of Epochs buffered so far
+////////////////////////////////////////////////////////////////////////////
+void t_reqcAnalyze::closeChunk(t_qcFile* qcFile) const {
+
+  analyzeMultipath(qcFile);
+
+  QTextStream* out = 0;
+  if (qcFile->_epoFile) {
+    out = new QTextStream(qcFile->_epoFile);
+  }
+  bool plots = BNC_CORE->GUIenabled();
+
+  for (int iEpo = 0; iEpo < qcFile->_qcEpo.size(); iEpo++) {
+    const t_qcEpo& qcEpo = qcFile->_qcEpo[iEpo];
+    if (plots) {
+      addPlotData(qcFile, qcEpo);
+    }
+    if (out) {
+      printEpoch(qcEpo, *out);
+    }
+  }
+
+  delete out;
+  qcFile->_qcEpo.clear();
+}
+
+// Count the expected Observations of one File in parallel
+////////////////////////////////////////////////////////////////////////////
+void t_reqcAnalyze::runSatTasks(t_qcFile* qcFile) const {
+
+  QList<t_prn> prns = qcFile->_numExpObs.keys();
+  QVector<int> result(prns.size(), 0);
+  QSemaphore   done;
+
+  for (int ii = 0; ii < prns.size(); ii++) {
+    _satPool->start(new t_satTask(this, qcFile, prns[ii], result.data() + ii, &done));
+  }
+  done.acquire(prns.size());
+
+  // Store the Number of expected Observations
+  // -----------------------------------------
+  for (int ii = 0; ii < prns.size(); ii++) {
+    if (result[ii] >= 0) {
+      qcFile->_numExpObs[prns[ii]] = result[ii];
+    }
+    else if (!qcFile->_navFileIncomplete.contains(prns[ii].system())) {
+      qcFile->_navFileIncomplete.append(prns[ii].system());
+    }
   }
 }
 
 // Compute Dilution of Precision
 ////////////////////////////////////////////////////////////////////////////
-double t_reqcAnalyze::cmpDOP(const ColumnVector& xyzSta) const {
+double t_reqcAnalyze::cmpDOP(const t_qcFile* qcFile, const t_rnxObsFile::t_rnxEpo* epo) const {
+
+  const ColumnVector& xyzSta = qcFile->_xyzSta;
 
   if ( xyzSta.size() != 3 || (xyzSta[0] == 0.0 && xyzSta[1] == 0.0 && xyzSta[2] == 0.0) ) {
     return 0.0;
   }
 
-  unsigned nSat = _currEpo->rnxSat.size();
+  unsigned nSat = epo->rnxSat.size();
 
   if (nSat < 4) {
     return 0.0;
@@ -272,24 +435,19 @@ double t_reqcAnalyze::cmpDOP(const ColumnVector& xyzSta) const {
   unsigned nSatUsed = 0;
   for (unsigned iSat = 0; iSat < nSat; iSat++) {
 
-    const t_rnxObsFile::t_rnxSat& rnxSat = _currEpo->rnxSat[iSat];
+    const t_rnxObsFile::t_rnxSat& rnxSat = epo->rnxSat[iSat];
     const t_prn& prn = rnxSat.prn;
 
-    if (_signalTypes.find(prn.system()) == _signalTypes.end()) {
+    if (!_signalTypes.contains(prn.system())) {
       continue;
     }
 
-    t_eph* eph = 0;
-    for (int ie = 0; ie < _ephs.size(); ie++) {
-      if (_ephs[ie]->prn() == prn) {
-        eph = _ephs[ie];
-        break;
-      }
-    }
+    int          iPrn = ephIndex(prn);
+    const t_eph* eph  = (iPrn < 0) ? 0 : qcFile->_ephIndex[iPrn];
     if (eph) {
       ColumnVector xSat(4);
       ColumnVector vv(3);
-      if (eph->getCrd(_currEpo->tt, xSat, vv, false) == success) {
+      if (eph->getCrd(epo->tt, xSat, vv, false) == success) {
         ++nSatUsed;
         ColumnVector dx = xSat.Rows(1,3) - xyzSta;
         double rho = dx.norm_Frobenius();
@@ -316,7 +474,7 @@ double t_reqcAnalyze::cmpDOP(const ColumnVector& xyzSta) const {
 
 //
 ////////////////////////////////////////////////////////////////////////////
-void t_reqcAnalyze::updateQcSat(const t_qcSat& qcSat, t_qcSatSum& qcSatSum) {
+void t_reqcAnalyze::updateQcSat(const t_qcSat& qcSat, t_qcSatSum& qcSatSum) const {
 
   for (int ii = 0; ii < qcSat._qcFrq.size(); ii++) {
     const t_qcFrq& qcFrq    = qcSat._qcFrq[ii];
@@ -337,18 +495,14 @@ void t_reqcAnalyze::updateQcSat(const t_qcSat& qcSat, t_qcSatSum& qcSatSum) {
 
 //
 ////////////////////////////////////////////////////////////////////////////
-void t_reqcAnalyze::setQcObs(const bncTime& epoTime, const ColumnVector& xyzSta,
+void t_reqcAnalyze::setQcObs(const t_qcFile* qcFile, const bncTime& epoTime,
                              const t_satObs& satObs, QMap<QString, bncTime>& lastObsTime,
-                             t_qcSat& qcSat) {
+                             t_qcSat& qcSat) const {
 
-  t_eph* eph = 0;
-  for (int ie = 0; ie < _ephs.size(); ie++) {
-    if (_ephs[ie]->prn().system() == satObs._prn.system() &&
-        _ephs[ie]->prn().number() == satObs._prn.number()) {
-      eph = _ephs[ie];
-      break;
-    }
-  }
+  const ColumnVector& xyzSta = qcFile->_xyzSta;
+
+  int          iPrn = ephIndex(satObs._prn);
+  const t_eph* eph  = (iPrn < 0) ? 0 : qcFile->_ephIndex[iPrn];
   if (eph) {
     ColumnVector xc(4);
     ColumnVector vv(3);
@@ -384,7 +538,7 @@ void t_reqcAnalyze::setQcObs(const bncTime& epoTime, const ColumnVector& xyzSta,
     QString key = QString(satObs._prn.toString().c_str()) + qcFrq._rnxType2ch;
     if (lastObsTime[key].valid()) {
       double dt = epoTime - lastObsTime[key];
-      if (dt > 1.5 * _qcFile._interval) {
+      if (dt > 1.5 * qcFile->_interval) {
         qcFrq._gap = true;
       }
     }
@@ -397,11 +551,13 @@ void t_reqcAnalyze::setQcObs(const bncTime& epoTime, const ColumnVector& xyzSta,
       t_frequency::type fB = t_frequency::dummy;
       char sys             = satObs._prn.system();
       std::string frqType1, frqType2;
-      if (_signalTypes.find(sys) != _signalTypes.end()) {
+      QMap<char, QVector<QString> >::const_iterator itSig = _signalTypes.constFind(sys);
+      if (itSig != _signalTypes.constEnd()) {
+        const QVector<QString>& sigTypes = itSig.value();
         frqType1.push_back(sys);
-        frqType1.push_back(_signalTypes[sys][0][0].toLatin1());
+        frqType1.push_back(sigTypes[0][0].toLatin1());
         frqType2.push_back(sys);
-        frqType2.push_back(_signalTypes[sys][1][0].toLatin1());
+        frqType2.push_back(sigTypes[1][0].toLatin1());
         if      (frqObs->_rnxType2ch[0] == frqType1[1]) {
           fA = t_frequency::toInt(frqType1);
           fB = t_frequency::toInt(frqType2);
@@ -442,109 +598,337 @@ void t_reqcAnalyze::setQcObs(const bncTime& epoTime, const ColumnVector& xyzSta,
   } // satObs loop
 }
 
-//
+// Multipath and Slips of all Satellites in the current Chunk
 ////////////////////////////////////////////////////////////////////////////
-void t_reqcAnalyze::analyzeMultipath() {
+void t_reqcAnalyze::analyzeMultipath(t_qcFile* qcFile) const {
 
   const double SLIPTRESH = 10.0;  // cycle-slip threshold (meters)
-  const double chunkStep = 600.0; // 10 minutes
 
-  // Loop over all satellites available
-  // ----------------------------------
-  QMutableMapIterator<t_prn, t_qcSatSum> itSat(_qcFile._qcSatSum);
+  // Sort the Observations of the Chunk by Satellite and Signal
+  // ----------------------------------------------------------
+  QMap<t_prn, QMap<QString, QVector<t_qcFrq*> > > frqVecs;
+  QMap<t_prn, QMap<QString, QVector<double> > >   MPs;
+  for (int iEpo = 0; iEpo < qcFile->_qcEpo.size(); iEpo++) {
+    t_qcEpo& qcEpo = qcFile->_qcEpo[iEpo];
+    QMutableMapIterator<t_prn, t_qcSat> itSat(qcEpo._qcSat);
+    while (itSat.hasNext()) {
+      itSat.next();
+      const t_prn& prn   = itSat.key();
+      t_qcSat&     qcSat = itSat.value();
+      for (int iFrq = 0; iFrq < qcSat._qcFrq.size(); iFrq++) {
+        t_qcFrq& qcFrq = qcSat._qcFrq[iFrq];
+        frqVecs[prn][qcFrq._rnxType2ch] << &qcFrq;
+        if (qcFrq._setMP) {
+          MPs[prn][qcFrq._rnxType2ch] << qcFrq._rawMP;
+        }
+      }
+    }
+  }
+
+  // Loop over all satellites and signals
+  // ------------------------------------
+  QMapIterator<t_prn, QMap<QString, QVector<double> > > itSat(MPs);
   while (itSat.hasNext()) {
     itSat.next();
     const t_prn& prn      = itSat.key();
-    t_qcSatSum&  qcSatSum = itSat.value();
-
-    // Loop over all frequencies available
-    // -----------------------------------
-    QMutableMapIterator<QString, t_qcFrqSum> itFrq(qcSatSum._qcFrqSum);
+    t_qcSatSum&  qcSatSum = qcFile->_qcSatSum[prn];
+    QMapIterator<QString, QVector<double> > itFrq(itSat.value());
     while (itFrq.hasNext()) {
       itFrq.next();
-      const QString& frqType  = itFrq.key();
-      t_qcFrqSum&    qcFrqSum = itFrq.value();
-
-      // Loop over all Chunks of Data
-      // ----------------------------
-      for (bncTime chunkStart = _qcFile._startTime;
-           chunkStart < _qcFile._endTime; chunkStart += chunkStep) {
-
-        bncTime chunkEnd = chunkStart + chunkStep;
-
-        QVector<t_qcFrq*> frqVec;
-        QVector<double>   MP;
-
-        // Loop over all Epochs within one Chunk of Data
-        // ---------------------------------------------
-        for (int iEpo = 0; iEpo < _qcFile._qcEpo.size(); iEpo++) {
-          t_qcEpo& qcEpo = _qcFile._qcEpo[iEpo];
-          if (chunkStart <= qcEpo._epoTime && qcEpo._epoTime < chunkEnd) {
-            if (qcEpo._qcSat.contains(prn)) {
-              t_qcSat& qcSat = qcEpo._qcSat[prn];
-              for (int iFrq = 0; iFrq < qcSat._qcFrq.size(); iFrq++) {
-                t_qcFrq& qcFrq = qcSat._qcFrq[iFrq];
-                if (qcFrq._rnxType2ch == frqType) {
-                  frqVec << &qcFrq;
-                  if (qcFrq._setMP) {
-                    MP << qcFrq._rawMP;
-                  }
-                }
-              }
-            }
-          }
+      const QString&           frqType  = itFrq.key();
+      const QVector<double>&   MP       = itFrq.value();
+      const QVector<t_qcFrq*>& frqVec   = frqVecs[prn][frqType];
+      t_qcFrqSum&              qcFrqSum = qcSatSum._qcFrqSum[frqType];
+
+      // Compute the multipath mean and standard deviation
+      // -------------------------------------------------
+      if (MP.size() > 1) {
+        double meanMP = 0.0;
+        for (int ii = 0; ii < MP.size(); ii++) {
+          meanMP += MP[ii];
         }
+        meanMP /= MP.size();
 
-        // Compute the multipath mean and standard deviation
-        // -------------------------------------------------
-        if (MP.size() > 1) {
-          double meanMP = 0.0;
-          for (int ii = 0; ii < MP.size(); ii++) {
-            meanMP += MP[ii];
-          }
-          meanMP /= MP.size();
-
-          bool slipMP = false;
+        bool slipMP = false;
 
-          double stdMP = 0.0;
-          for (int ii = 0; ii < MP.size(); ii++) {
-            double diff = MP[ii] - meanMP;
-            if (fabs(diff) > SLIPTRESH) {
-              slipMP = true;
-              break;
-            }
-            stdMP += diff * diff;
+        double stdMP = 0.0;
+        for (int ii = 0; ii < MP.size(); ii++) {
+          double diff = MP[ii] - meanMP;
+          if (fabs(diff) > SLIPTRESH) {
+            slipMP = true;
+            break;
           }
+          stdMP += diff * diff;
+        }
 
+        if (slipMP) {
+          stdMP = 0.0;
+          qcFrqSum._numSlipsFound += 1;
+        }
+        else {
+          stdMP = sqrt(stdMP / (MP.size()-1));
+          qcFrqSum._numMP += 1;
+          qcFrqSum._sumMP += stdMP;
+        }
+
+        for (int ii = 0; ii < frqVec.size(); ii++) {
+          t_qcFrq* qcFrq = frqVec[ii];
           if (slipMP) {
-            stdMP = 0.0;
-            stdMP = 0.0;
-            qcFrqSum._numSlipsFound += 1;
+            qcFrq->_slip = true;
           }
           else {
-            stdMP = sqrt(stdMP / (MP.size()-1));
-            qcFrqSum._numMP += 1;
-            qcFrqSum._sumMP += stdMP;
+            qcFrq->_stdMP = stdMP;
           }
+        }
+      }
+    } // frq loop
+  } // sat loop
+}
 
-          for (int ii = 0; ii < frqVec.size(); ii++) {
-            t_qcFrq* qcFrq = frqVec[ii];
-            if (slipMP) {
-              qcFrq->_slip = true;
-            }
-            else {
-              qcFrq->_stdMP = stdMP;
+// Add a Sky Plot Value
+////////////////////////////////////////////////////////////////////////////
+void t_reqcAnalyze::t_skyGrid::add(double azDeg, double zenDeg, double value) {
+
+  if (zenDeg < 0.0 || zenDeg >= 91.0) {
+    return;
+  }
+  if (_num.isEmpty()) {
+    _sum.fill(0.0, 91 * 360);
+    _num.fill(0,   91 * 360);
+  }
+  int iAz = int(floor(azDeg)) % 360;
+  if (iAz < 0) {
+    iAz += 360;
+  }
+  int ii = int(zenDeg) * 360 + iAz;
+  _sum[ii] += value;
+  _num[ii] += 1;
+}
+
+// Sky Plot Points (cell centers with mean values)
+////////////////////////////////////////////////////////////////////////////
+QVector<t_polarPoint*>* t_reqcAnalyze::t_skyGrid::points() const {
+
+  QVector<t_polarPoint*>* data = new QVector<t_polarPoint*>;
+  for (int ii = 0; ii < _num.size(); ii++) {
+    if (_num[ii] > 0) {
+      (*data) << (new t_polarPoint(ii % 360 + 0.5, ii / 360 + 0.5, _sum[ii] / _num[ii]));
+    }
+  }
+  return data;
+}
+
+// Is an Epoch on the Sampling Grid of the time series Plots
+////////////////////////////////////////////////////////////////////////////
+static bool plotSample(double dt, double step, double tol) {
+  double nn = floor(dt / step + 0.5);
+  return fabs(dt - nn * step) < tol;
+}
+
+// Keep the Values of the sampled Epochs only
+////////////////////////////////////////////////////////////////////////////
+static void thinValues(const QVector<bool>& keep, QVector<double>& values) {
+  int nn = 0;
+  for (int ii = 0; ii < values.size(); ii++) {
+    if (keep[ii]) {
+      values[nn++] = values[ii];
+    }
+  }
+  values.resize(nn);
+}
+
+// Add a Slip or Gap Marker (at most one per Sampling Interval)
+////////////////////////////////////////////////////////////////////////////
+static void addMarker(QVector<double>& markers, double mjdX24, double stepX24) {
+  if (markers.isEmpty() || mjdX24 - markers.last() >= stepX24) {
+    markers << mjdX24;
+  }
+}
+
+// Keep at most one Slip or Gap Marker per Sampling Interval
+////////////////////////////////////////////////////////////////////////////
+static void thinMarkers(QVector<double>& markers, double stepX24) {
+  int nn = 0;
+  for (int ii = 0; ii < markers.size(); ii++) {
+    if (nn == 0 || markers[ii] - markers[nn-1] >= stepX24) {
+      markers[nn++] = markers[ii];
+    }
+  }
+  markers.resize(nn);
+}
+
+// Sampling Flags of a Vector of Epochs
+////////////////////////////////////////////////////////////////////////////
+static QVector<bool> plotSamples(const QVector<double>& mjdX24, double mjdX24Start,
+                                 double step, double tol) {
+  QVector<bool> keep(mjdX24.size());
+  for (int ii = 0; ii < mjdX24.size(); ii++) {
+    keep[ii] = plotSample((mjdX24[ii] - mjdX24Start) * 3600.0, step, tol);
+  }
+  return keep;
+}
+
+// Add one Epoch to the Plot Data (at most one slip/gap marker per step)
+////////////////////////////////////////////////////////////////////////////
+void t_reqcAnalyze::addPlotData(t_qcFile* qcFile, const t_qcEpo& qcEpo) const {
+
+  t_plotData&              plotData    = qcFile->_availData._plotData;
+  QMap<t_prn, t_plotData>& plotDataMap = qcFile->_availData._plotDataMap;
+
+  if (qcFile->_plotStep == 0.0) {
+    qcFile->_plotStep = (qcFile->_interval > 0.0) ? qcFile->_interval : 1.0;
+  }
+  double tol     = 0.25 * ((qcFile->_interval > 0.0) ? qcFile->_interval : 1.0);
+  double mjdX24  = qcEpo._epoTime.mjddec() * 24.0;
+  double stepX24 = (qcFile->_plotStep - tol) / 3600.0;
+  bool   sample  = plotSample(qcEpo._epoTime - qcFile->_startTime, qcFile->_plotStep, tol);
+
+  if (sample) {
+    plotData._mjdX24 << mjdX24;
+    plotData._PDOP   << qcEpo._PDOP;
+    plotData._numSat << qcEpo._qcSat.size();
+  }
+
+  QMapIterator<t_prn, t_qcSat> it(qcEpo._qcSat);
+  while (it.hasNext()) {
+    it.next();
+    const t_prn&            prn      = it.key();
+    const t_qcSat&          qcSat    = it.value();
+    const QVector<QString>& sigTypes = _signalTypes.constFind(prn.system()).value();
+
+    // Sky Plots
+    // ---------
+    if (qcSat._eleSet) {
+
+      QString frqType[2];
+
+      for (int iFrq = 0; iFrq < qcSat._qcFrq.size(); iFrq++) {
+        const t_qcFrq& qcFrq = qcSat._qcFrq[iFrq];
+
+        for (int ii = 0; ii < 2; ii++) {
+          if (frqType[ii].isEmpty()) {
+            if (sigTypes[ii] == qcFrq._rnxType2ch || sigTypes[ii] == qcFrq._rnxType2ch.left(1)) {
+              frqType[ii] = qcFrq._rnxType2ch;
             }
           }
         }
-      } // chunk loop
-    } // frq loop
-  } // sat loop
+        if      (qcFrq._rnxType2ch == frqType[0]) {
+          qcFile->_skySNR1.add(qcSat._azDeg, 90.0 - qcSat._eleDeg, qcFrq._SNR);
+          qcFile->_skyMP1.add(qcSat._azDeg, 90.0 - qcSat._eleDeg, qcFrq._stdMP);
+        }
+        else if (qcFrq._rnxType2ch == frqType[1]) {
+          qcFile->_skySNR2.add(qcSat._azDeg, 90.0 - qcSat._eleDeg, qcFrq._SNR);
+          qcFile->_skyMP2.add(qcSat._azDeg, 90.0 - qcSat._eleDeg, qcFrq._stdMP);
+        }
+      }
+    }
+
+    // Availability, Elevation and DOP Plots
+    // -------------------------------------
+    t_plotData& data = plotDataMap[prn];
+
+    if (qcSat._eleSet && sample) {
+      data._mjdX24 << mjdX24;
+      data._eleDeg << qcSat._eleDeg;
+    }
+
+    char frqChar1 = sigTypes[0][0].toLatin1();
+    char frqChar2 = sigTypes[1][0].toLatin1();
+
+    QString frqType1;
+    QString frqType2;
+    for (int iFrq = 0; iFrq < qcSat._qcFrq.size(); iFrq++) {
+      const t_qcFrq& qcFrq = qcSat._qcFrq[iFrq];
+      if (qcFrq._rnxType2ch[0] == frqChar1 && frqType1.isEmpty()) {
+        frqType1 = qcFrq._rnxType2ch;
+      }
+      if (qcFrq._rnxType2ch[0] == frqChar2 && frqType2.isEmpty()) {
+        frqType2 = qcFrq._rnxType2ch;
+      }
+      if      (qcFrq._rnxType2ch == frqType1) {
+        if      (qcFrq._slip) {
+          addMarker(data._L1slip, mjdX24, stepX24);
+        }
+        else if (qcFrq._gap) {
+          addMarker(data._L1gap, mjdX24, stepX24);
+        }
+        else if (sample) {
+          data._L1ok << mjdX24;
+        }
+      }
+      else if (qcFrq._rnxType2ch == frqType2) {
+        if      (qcFrq._slip) {
+          addMarker(data._L2slip, mjdX24, stepX24);
+        }
+        else if (qcFrq._gap) {
+          addMarker(data._L2gap, mjdX24, stepX24);
+        }
+        else if (sample) {
+          data._L2ok << mjdX24;
+        }
+      }
+    }
+  }
+
+  if (plotData._mjdX24.size() > _maxPlotEpochs) {
+    thinPlotData(qcFile);
+  }
 }
 
-//
+// Double the Sampling Interval of the time series Plots
 ////////////////////////////////////////////////////////////////////////////
-void t_reqcAnalyze::preparePlotData(const t_rnxObsFile* obsFile) {
+void t_reqcAnalyze::thinPlotData(t_qcFile* qcFile) const {
+
+  qcFile->_plotStep *= 2.0;
+
+  double step        = qcFile->_plotStep;
+  double tol         = 0.25 * ((qcFile->_interval > 0.0) ? qcFile->_interval : 1.0);
+  double mjdX24Start = qcFile->_startTime.mjddec() * 24.0;
+  double stepX24     = (step - tol) / 3600.0;
+
+  t_plotData&   plotData = qcFile->_availData._plotData;
+  QVector<bool> keep     = plotSamples(plotData._mjdX24, mjdX24Start, step, tol);
+  thinValues(keep, plotData._PDOP);
+  thinValues(keep, plotData._numSat);
+  thinValues(keep, plotData._mjdX24);
+
+  QMutableMapIterator<t_prn, t_plotData> it(qcFile->_availData._plotDataMap);
+  while (it.hasNext()) {
+    it.next();
+    t_plotData& data = it.value();
+    keep = plotSamples(data._mjdX24, mjdX24Start, step, tol);
+    thinValues(keep, data._eleDeg);
+    thinValues(keep, data._mjdX24);
+    thinValues(plotSamples(data._L1ok, mjdX24Start, step, tol), data._L1ok);
+    thinValues(plotSamples(data._L2ok, mjdX24Start, step, tol), data._L2ok);
+    thinMarkers(data._L1slip, stepX24);
+    thinMarkers(data._L1gap,  stepX24);
+    thinMarkers(data._L2slip, stepX24);
+    thinMarkers(data._L2gap,  stepX24);
+  }
+}
+
+// Sky Plot Data of one File
+////////////////////////////////////////////////////////////////////////////
+void t_reqcAnalyze::preparePlotData(t_qcFile* qcFile) const {
+
+  if (!BNC_CORE->GUIenabled()) {
+    return;
+  }
+
+  qcFile->_dataMP1  = qcFile->_skyMP1.points();
+  qcFile->_dataMP2  = qcFile->_skyMP2.points();
+  qcFile->_dataSNR1 = qcFile->_skySNR1.points();
+  qcFile->_dataSNR2 = qcFile->_skySNR2.points();
+}
+
+// Show the plots of one File
+////////////////////////////////////////////////////////////////////////////
+void t_reqcAnalyze::dspPlots(t_qcFile* qcFile) {
+
+  if (!qcFile->_dataMP1) {
+    return;
+  }
 
   QString mp1Title = "Multipath\n";
   QString mp2Title = "Multipath\n";
@@ -559,81 +943,18 @@ void t_reqcAnalyze::preparePlotData(const t_rnxObsFile* obsFile) {
       sn2Title += QString(it.key()) + ":" + it.value()[1] + " ";
   }
 
-  QVector<t_polarPoint*>* dataMP1  = new QVector<t_polarPoint*>;
-  QVector<t_polarPoint*>* dataMP2  = new QVector<t_polarPoint*>;
-  QVector<t_polarPoint*>* dataSNR1 = new QVector<t_polarPoint*>;
-  QVector<t_polarPoint*>* dataSNR2 = new QVector<t_polarPoint*>;
-
-  // Loop over all observations
-  // --------------------------
-  for (int iEpo = 0; iEpo < _qcFile._qcEpo.size(); iEpo++) {
-    t_qcEpo& qcEpo = _qcFile._qcEpo[iEpo];
-    QMapIterator<t_prn, t_qcSat> it(qcEpo._qcSat);
-    while (it.hasNext()) {
-      it.next();
-      const t_prn&   prn   = it.key();
-      const t_qcSat& qcSat = it.value();
-      if (qcSat._eleSet) {
-
-        QString frqType[2];
-
-        for (int iFrq = 0; iFrq < qcSat._qcFrq.size(); iFrq++) {
-          const t_qcFrq& qcFrq = qcSat._qcFrq[iFrq];
-
-          for (int ii = 0; ii < 2; ii++) {
-            if (frqType[ii].isEmpty()) {
-              QMapIterator<char, QVector<QString> > it(_signalTypes);
-              while (it.hasNext()) {
-                it.next();
-                if (it.key() == prn.system()) {
-                  if (it.value()[ii] == qcFrq._rnxType2ch || it.value()[ii] == qcFrq._rnxType2ch.left(1)) {
-                    frqType[ii] = qcFrq._rnxType2ch;
-                    break;
-                  }
-                }
-              }
-            }
-          }
-          if      (qcFrq._rnxType2ch == frqType[0]) {
-            (*dataSNR1) << (new t_polarPoint(qcSat._azDeg, 90.0 - qcSat._eleDeg, qcFrq._SNR));
-            (*dataMP1)  << (new t_polarPoint(qcSat._azDeg, 90.0 - qcSat._eleDeg, qcFrq._stdMP));
-          }
-          else if (qcFrq._rnxType2ch == frqType[1]) {
-            (*dataSNR2) << (new t_polarPoint(qcSat._azDeg, 90.0 - qcSat._eleDeg, qcFrq._SNR));
-            (*dataMP2)  << (new t_polarPoint(qcSat._azDeg, 90.0 - qcSat._eleDeg, qcFrq._stdMP));
-          }
-        }
-      }
-    }
-  }
+  const QString& fileName = qcFile->_obsFile->fileName();
+  QFileInfo  fileInfo(fileName);
+  QByteArray title = fileInfo.fileName().toLatin1();
 
-  // Show the plots
-  // --------------
-  if (BNC_CORE->GUIenabled()) {
-    QFileInfo  fileInfo(obsFile->fileName());
-    QByteArray title = fileInfo.fileName().toLatin1();
-    emit dspSkyPlot(obsFile->fileName(), mp1Title,  dataMP1,  mp2Title,  dataMP2,  "Meters",  2.0);
-    emit dspSkyPlot(obsFile->fileName(), sn1Title, dataSNR1, sn2Title, dataSNR2, "dbHz",   54.0);
-    emit dspAvailPlot(obsFile->fileName(), title);
-  }
-  else {
-    for (int ii = 0; ii < dataMP1->size(); ii++) {
-      delete dataMP1->at(ii);
-    }
-    delete dataMP1;
-    for (int ii = 0; ii < dataMP2->size(); ii++) {
-      delete dataMP2->at(ii);
-    }
-    delete dataMP2;
-    for (int ii = 0; ii < dataSNR1->size(); ii++) {
-      delete dataSNR1->at(ii);
-    }
-    delete dataSNR1;
-    for (int ii = 0; ii < dataSNR2->size(); ii++) {
-      delete dataSNR2->at(ii);
-    }
-    delete dataSNR2;
+  {
+    QMutexLocker locker(&_mutex);
+    _availData[fileName] = qcFile->_availData;
   }
+
+  emit dspSkyPlot(fileName, mp1Title, qcFile->_dataMP1,  mp2Title, qcFile->_dataMP2,  "Meters",  2.0);
+  emit dspSkyPlot(fileName, sn1Title, qcFile->_dataSNR1, sn2Title, qcFile->_dataSNR2, "dbHz",   54.0);
+  emit dspAvailPlot(fileName, title);
 }
 
 //
@@ -700,68 +1021,13 @@ void t_reqcAnalyze::slotDspSkyPlot(const QString& fileName, const QString& title
 ////////////////////////////////////////////////////////////////////////////
 void t_reqcAnalyze::slotDspAvailPlot(const QString& fileName, const QByteArray& title) {
 
-  t_plotData              plotData;
-  QMap<t_prn, t_plotData> plotDataMap;
-
-  for (int ii = 0; ii < _qcFile._qcEpo.size(); ii++) {
-    const t_qcEpo& qcEpo = _qcFile._qcEpo[ii];
-    double mjdX24 = qcEpo._epoTime.mjddec() * 24.0;
-
-    plotData._mjdX24 << mjdX24;
-    plotData._PDOP   << qcEpo._PDOP;
-    plotData._numSat << qcEpo._qcSat.size();
-
-    QMapIterator<t_prn, t_qcSat> it(qcEpo._qcSat);
-    while (it.hasNext()) {
-      it.next();
-      const t_prn&   prn   = it.key();
-      const t_qcSat& qcSat = it.value();
-
-      t_plotData&    data  = plotDataMap[prn];
-
-      if (qcSat._eleSet) {
-        data._mjdX24 << mjdX24;
-        data._eleDeg << qcSat._eleDeg;
-      }
-
-      char frqChar1 = _signalTypes[prn.system()][0][0].toLatin1();
-      char frqChar2 = _signalTypes[prn.system()][1][0].toLatin1();
-
-      QString frqType1;
-      QString frqType2;
-      for (int iFrq = 0; iFrq < qcSat._qcFrq.size(); iFrq++) {
-        const t_qcFrq& qcFrq = qcSat._qcFrq[iFrq];
-        if (qcFrq._rnxType2ch[0] == frqChar1 && frqType1.isEmpty()) {
-          frqType1 = qcFrq._rnxType2ch;
-        }
-        if (qcFrq._rnxType2ch[0] == frqChar2 && frqType2.isEmpty()) {
-          frqType2 = qcFrq._rnxType2ch;
-        }
-        if      (qcFrq._rnxType2ch == frqType1) {
-          if      (qcFrq._slip) {
-            data._L1slip << mjdX24;
-          }
-          else if (qcFrq._gap) {
-            data._L1gap << mjdX24;
-          }
-          else {
-            data._L1ok << mjdX24;
-          }
-        }
-        else if (qcFrq._rnxType2ch == frqType2) {
-          if      (qcFrq._slip) {
-            data._L2slip << mjdX24;
-          }
-          else if (qcFrq._gap) {
-            data._L2gap << mjdX24;
-          }
-          else {
-            data._L2ok << mjdX24;
-          }
-        }
-      }
-    }
+  t_availData availData;
+  {
+    QMutexLocker locker(&_mutex);
+    availData = _availData.take(fileName);
   }
+  const t_plotData&              plotData    = availData._plotData;
+  const QMap<t_prn, t_plotData>& plotDataMap = availData._plotDataMap;
 
   if (BNC_CORE->GUIenabled()) {
     t_availPlot* plotA = new t_availPlot(0, plotDataMap);
@@ -791,65 +1057,63 @@ void t_reqcAnalyze::slotDspAvailPlot(const QString& fileName, const QByteArray&
 
 // Finish the report
 ////////////////////////////////////////////////////////////////////////////
-void t_reqcAnalyze::printReport(const t_rnxObsFile* obsFile) {
+void t_reqcAnalyze::printReport(const t_qcFile* qcFile, QTextStream& out) const {
 
-  if (!_log) {
-    return;
-  }
+  const t_rnxObsFile* obsFile = qcFile->_obsFile;
 
   QFileInfo obsFi(obsFile->fileName());
   QString obsFileName = obsFi.fileName();
 
   // Summary
   // -------
-  *_log << "Observation File   : " << obsFileName                                   << endl
+  out << "Observation File   : " << obsFileName                                   << endl
         << "RINEX Version      : " << QString("%1").arg(obsFile->version(),4,'f',2) << endl
-        << "Marker Name        : " << _qcFile._markerName                           << endl
+        << "Marker Name        : " << qcFile->_markerName                           << endl
         << "Marker Number      : " << obsFile->markerNumber()                       << endl
-        << "Receiver           : " << _qcFile._receiverType                         << endl
-        << "Antenna            : " << _qcFile._antennaName                          << endl
+        << "Receiver           : " << qcFile->_receiverType                         << endl
+        << "Antenna            : " << qcFile->_antennaName                          << endl
         << "Position XYZ       : " << QString("%1 %2 %3").arg(obsFile->xyz()(1), 14, 'f', 4)
                                                         .arg(obsFile->xyz()(2), 14, 'f', 4)
                                                         .arg(obsFile->xyz()(3), 14, 'f', 4) << endl
         << "Antenna dH/dE/dN   : " << QString("%1 %2 %3").arg(obsFile->antNEU()(3), 8, 'f', 4)
                                                         .arg(obsFile->antNEU()(2), 8, 'f', 4)
                                                         .arg(obsFile->antNEU()(1), 8, 'f', 4) << endl
-        << "Start Time         : " << _qcFile._startTime.datestr().c_str()         << ' '
-                                   << _qcFile._startTime.timestr(1,'.').c_str()    << endl
-        << "End Time           : " << _qcFile._endTime.datestr().c_str()           << ' '
-                                   << _qcFile._endTime.timestr(1,'.').c_str()      << endl
-        << "Interval           : " << _qcFile._interval                            << endl;
+        << "Start Time         : " << qcFile->_startTime.datestr().c_str()         << ' '
+                                   << qcFile->_startTime.timestr(1,'.').c_str()    << endl
+        << "End Time           : " << qcFile->_endTime.datestr().c_str()           << ' '
+                                   << qcFile->_endTime.timestr(1,'.').c_str()      << endl
+        << "Interval           : " << qcFile->_interval                            << endl;
 
   // Number of systems
   // -----------------
   QMap<QChar, QVector<const t_qcSatSum*> > systemMap;
-  QMapIterator<t_prn, t_qcSatSum> itSat(_qcFile._qcSatSum);
+  QMapIterator<t_prn, t_qcSatSum> itSat(qcFile->_qcSatSum);
   while (itSat.hasNext()) {
     itSat.next();
     const t_prn&      prn      = itSat.key();
     const t_qcSatSum& qcSatSum = itSat.value();
     systemMap[prn.system()].push_back(&qcSatSum);
   }
-  *_log << "Navigation Systems : " << systemMap.size() << "   ";
+  out << "Navigation Systems : " << systemMap.size() << "   ";
 
   QMapIterator<QChar, QVector<const t_qcSatSum*> > itSys(systemMap);
   while (itSys.hasNext()) {
     itSys.next();
-    *_log << ' ' << itSys.key();
+    out << ' ' << itSys.key();
   }
-  *_log << endl;
+  out << endl;
 
   // Observation types per system
   // -----------------------------
   for (int iSys = 0; iSys < obsFile->numSys(); iSys++) {
     char sys = obsFile->system(iSys);
     if (sys != ' ') {
-      *_log << "Observation Types " << sys << ":";
+      out << "Observation Types " << sys << ":";
       for (int iType = 0; iType < obsFile->nTypes(sys); iType++) {
         QString type = obsFile->obsType(sys, iType);
-        *_log << " " << type;
+        out << " " << type;
       }
-      *_log << endl;
+      out << endl;
     }
   }
 
@@ -861,8 +1125,8 @@ void t_reqcAnalyze::printReport(const t_rnxObsFile* obsFile) {
     const QChar&                      sys      = itSys.key();
     const QVector<const t_qcSatSum*>& qcSatVec = itSys.value();
     int numExpectedObs = 0;
-    for(QMap<t_prn, int>::iterator it = _numExpObs.begin();
-        it != _numExpObs.end(); it++) {
+    for(QMap<t_prn, int>::const_iterator it = qcFile->_numExpObs.begin();
+        it != qcFile->_numExpObs.end(); it++) {
       if (sys == it.key().system()) {
         numExpectedObs += it.value();
       }
@@ -879,16 +1143,16 @@ void t_reqcAnalyze::printReport(const t_rnxObsFile* obsFile) {
         frqMap[frqType].push_back(&qcFrqSum);
       }
     }
-    *_log << endl
+    out << endl
           << prefixSys << "Satellites: " << qcSatVec.size() << endl
           << prefixSys << "Signals   : " << frqMap.size() << "   ";
     QMapIterator<QString, QVector<const t_qcFrqSum*> > itFrq(frqMap);
     while (itFrq.hasNext()) {
       itFrq.next();
       QString frqType = itFrq.key(); if (frqType.length() < 2) frqType += '?';
-      *_log << ' ' << frqType;
+      out << ' ' << frqType;
     }
-    *_log << endl;
+    out << endl;
     QString prefixSys2 = "    " + prefixSys;
     itFrq.toFront();
     while (itFrq.hasNext()) {
@@ -924,15 +1188,15 @@ void t_reqcAnalyze::printReport(const t_rnxObsFile* obsFile) {
 
       double ratio = (double(numObs) / double(numExpectedObs)) * 100.0;
 
-      *_log << endl
+      out << endl
             << prefixSys2 << prefixFrq << "Observations      : ";
-      if(_navFileNames.isEmpty() || _navFileIncomplete.contains(sys.toLatin1())) {
-        *_log << QString("%1\n").arg(numObs,           6);
+      if(_navFileNames.isEmpty() || qcFile->_navFileIncomplete.contains(sys.toLatin1())) {
+        out << QString("%1\n").arg(numObs,           6);
       }
       else {
-        *_log << QString("%1 (%2) %3 \%\n").arg(numObs,           6).arg(numExpectedObs,           8).arg(ratio, 8, 'f', 2);
+        out << QString("%1 (%2) %3 \%\n").arg(numObs,           6).arg(numExpectedObs,           8).arg(ratio, 8, 'f', 2);
       }
-      *_log << prefixSys2 << prefixFrq << "Slips (file+found): " << QString("%1 +").arg(numSlipsFlagged,  8)
+      out << prefixSys2 << prefixFrq << "Slips (file+found): " << QString("%1 +").arg(numSlipsFlagged,  8)
                                                                  << QString("%1\n").arg(numSlipsFound,    8)
             << prefixSys2 << prefixFrq << "Gaps              : " << QString("%1\n").arg(numGaps,          8)
             << prefixSys2 << prefixFrq << "Mean SNR          : " << QString("%1\n").arg(sumSNR,   8, 'f', 1)
@@ -940,88 +1204,87 @@ void t_reqcAnalyze::printReport(const t_rnxObsFile* obsFile) {
     }
   }
 
-  // Epoch-Specific Output
-  // ---------------------
-  bncSettings settings;
-  if (Qt::CheckState(settings.value("reqcLogSummaryOnly").toInt()) == Qt::Checked) {
-    return;
+  // Epoch-Specific Output follows
+  // ------------------------------
+  if (qcFile->_epoFile) {
+    out << endl;
   }
-  *_log << endl;
-  for (int iEpo = 0; iEpo < _qcFile._qcEpo.size(); iEpo++) {
-    const t_qcEpo& qcEpo = _qcFile._qcEpo[iEpo];
-
-    unsigned year, month, day, hour, min;
-    double sec;
-    qcEpo._epoTime.civil_date(year, month, day);
-    qcEpo._epoTime.civil_time(hour, min, sec);
-
-    QString dateStr;
-    QTextStream(&dateStr) << QString("> %1 %2 %3 %4 %5%6")
-      .arg(year,  4)
-      .arg(month, 2, 10, QChar('0'))
-      .arg(day,   2, 10, QChar('0'))
-      .arg(hour,  2, 10, QChar('0'))
-      .arg(min,   2, 10, QChar('0'))
-      .arg(sec,  11, 'f', 7);
-
-    *_log << dateStr << QString(" %1").arg(qcEpo._qcSat.size(), 2)
-          << QString(" %1").arg(qcEpo._PDOP, 4, 'f', 1)
-          << endl;
-
-    QMapIterator<t_prn, t_qcSat> itSat(qcEpo._qcSat);
-    while (itSat.hasNext()) {
-      itSat.next();
-      const t_prn&   prn   = itSat.key();
-      const t_qcSat& qcSat = itSat.value();
+}
+
+// Epoch-Specific Output
+////////////////////////////////////////////////////////////////////////////
+void t_reqcAnalyze::printEpoch(const t_qcEpo& qcEpo, QTextStream& out) const {
+
+  unsigned year, month, day, hour, min;
+  double sec;
+  qcEpo._epoTime.civil_date(year, month, day);
+  qcEpo._epoTime.civil_time(hour, min, sec);
+
+  QString dateStr;
+  QTextStream(&dateStr) << QString("> %1 %2 %3 %4 %5%6")
+    .arg(year,  4)
+    .arg(month, 2, 10, QChar('0'))
+    .arg(day,   2, 10, QChar('0'))
+    .arg(hour,  2, 10, QChar('0'))
+    .arg(min,   2, 10, QChar('0'))
+    .arg(sec,  11, 'f', 7);
+
+  out << dateStr << QString(" %1").arg(qcEpo._qcSat.size(), 2)
+        << QString(" %1").arg(qcEpo._PDOP, 4, 'f', 1)
+        << endl;
+
+  QMapIterator<t_prn, t_qcSat> itSat(qcEpo._qcSat);
+  while (itSat.hasNext()) {
+    itSat.next();
+    const t_prn&   prn   = itSat.key();
+    const t_qcSat& qcSat = itSat.value();
 
-      *_log << prn.toString().c_str()
-            << QString(" %1 %2").arg(qcSat._eleDeg, 6, 'f', 2).arg(qcSat._azDeg, 7, 'f', 2);
+    out << prn.toString().c_str()
+          << QString(" %1 %2").arg(qcSat._eleDeg, 6, 'f', 2).arg(qcSat._azDeg, 7, 'f', 2);
 
-      int numObsTypes = 0;
-      for (int iFrq = 0; iFrq < qcSat._qcFrq.size(); iFrq++) {
-        const t_qcFrq& qcFrq = qcSat._qcFrq[iFrq];
-        if (qcFrq._phaseValid) {
-          numObsTypes += 1;
+    int numObsTypes = 0;
+    for (int iFrq = 0; iFrq < qcSat._qcFrq.size(); iFrq++) {
+      const t_qcFrq& qcFrq = qcSat._qcFrq[iFrq];
+      if (qcFrq._phaseValid) {
+        numObsTypes += 1;
+      }
+      if (qcFrq._codeValid) {
+        numObsTypes += 1;
+      }
+    }
+    out << QString("  %1").arg(numObsTypes, 2);
+
+    for (int iFrq = 0; iFrq < qcSat._qcFrq.size(); iFrq++) {
+      const t_qcFrq& qcFrq = qcSat._qcFrq[iFrq];
+      if (qcFrq._phaseValid) {
+        out << "  L" << qcFrq._rnxType2ch << ' ';
+        if (qcFrq._slip) {
+          out << 's';
         }
-        if (qcFrq._codeValid) {
-          numObsTypes += 1;
+        else {
+          out << '.';
         }
+        if (qcFrq._gap) {
+          out << 'g';
+        }
+        else {
+          out << '.';
+        }
+        out << QString(" %1").arg(qcFrq._SNR,   4, 'f', 1);
       }
-      *_log << QString("  %1").arg(numObsTypes, 2);
-
-      for (int iFrq = 0; iFrq < qcSat._qcFrq.size(); iFrq++) {
-        const t_qcFrq& qcFrq = qcSat._qcFrq[iFrq];
-        if (qcFrq._phaseValid) {
-          *_log << "  L" << qcFrq._rnxType2ch << ' ';
-          if (qcFrq._slip) {
-            *_log << 's';
-          }
-          else {
-            *_log << '.';
-          }
-          if (qcFrq._gap) {
-            *_log << 'g';
-          }
-          else {
-            *_log << '.';
-          }
-          *_log << QString(" %1").arg(qcFrq._SNR,   4, 'f', 1);
+      if (qcFrq._codeValid) {
+        out << "  C" << qcFrq._rnxType2ch << ' ';
+        if (qcFrq._gap) {
+          out << " g";
         }
-        if (qcFrq._codeValid) {
-          *_log << "  C" << qcFrq._rnxType2ch << ' ';
-          if (qcFrq._gap) {
-            *_log << " g";
-          }
-          else {
-            *_log << " .";
-          }
-          *_log << QString(" %1").arg(qcFrq._stdMP, 3, 'f', 2);
+        else {
+          out << " .";
         }
+        out << QString(" %1").arg(qcFrq._stdMP, 3, 'f', 2);
       }
-      *_log << endl;
     }
+    out << endl;
   }
-  _log->flush();
 }
 
 //
@@ -1082,41 +1345,32 @@ void t_reqcAnalyze::checkEphemerides() {
   }
 }
 
-void t_reqcAnalyze::setExpectedObs(const bncTime& startTime, const bncTime& endTime,
-                                   double interval, const ColumnVector& xyzSta) {
-
-  for(QMap<t_prn, int>::iterator it = _numExpObs.begin();
-      it != _numExpObs.end(); it++) {
-    t_eph* eph = 0;
-    for (int ie = 0; ie < _ephs.size(); ie++) {
-      if (_ephs[ie]->prn().system() == it.key().system() &&
-          _ephs[ie]->prn().number() == it.key().number()) {
-        eph = _ephs[ie];
-        break;
-      }
-    }
-    if (eph) {
-      int numExpObs = 0;
-      bncTime epoTime;
-      for (epoTime = startTime - interval; epoTime < endTime;
-           epoTime = epoTime + interval) {
-        ColumnVector xc(4);
-        ColumnVector vv(3);
-        if ( xyzSta.size() == 3 && (xyzSta[0] != 0.0 || xyzSta[1] != 0.0 || xyzSta[2] != 0.0) &&
-             eph->getCrd(epoTime, xc, vv, false) == success) {
-          double rho, eleSat, azSat;
-          topos(xyzSta(1), xyzSta(2), xyzSta(3), xc(1), xc(2), xc(3), rho, eleSat, azSat);
-          if ((eleSat * 180.0/M_PI) > 0.0) {
-            numExpObs++;
-          }
-        }
-      }
-      it.value() = numExpObs;
-    }
-    else {
-      if (!_navFileIncomplete.contains(it.key().system())) {
-        _navFileIncomplete.append(it.key().system());
+// Number of expected Observations of a Satellite (-1 if no ephemeris)
+////////////////////////////////////////////////////////////////////////////
+int t_reqcAnalyze::expectedObs(const t_qcFile* qcFile, const t_prn& prn) const {
+
+  const ColumnVector& xyzSta = qcFile->_xyzSta;
+
+  int          iPrn = ephIndex(prn);
+  const t_eph* eph  = (iPrn < 0) ? 0 : qcFile->_ephIndex[iPrn];
+  if (!eph) {
+    return -1;
+  }
+
+  int numExpObs = 0;
+  bncTime epoTime;
+  for (epoTime = qcFile->_startTime - qcFile->_interval; epoTime < qcFile->_endTime;
+       epoTime = epoTime + qcFile->_interval) {
+    ColumnVector xc(4);
+    ColumnVector vv(3);
+    if ( xyzSta.size() == 3 && (xyzSta[0] != 0.0 || xyzSta[1] != 0.0 || xyzSta[2] != 0.0) &&
+         eph->getCrd(epoTime, xc, vv, false) == success) {
+      double rho, eleSat, azSat;
+      topos(xyzSta(1), xyzSta(2), xyzSta(3), xc(1), xc(2), xc(3), rho, eleSat, azSat);
+      if ((eleSat * 180.0/M_PI) > 0.0) {
+        numExpObs++;
       }
     }
   }
+  return numExpObs;
 }
@@ -139,13 +139,48 @@ Q_OBJECT
     QMap<QString, t_qcFrqSum> _qcFrqSum;
   };
 
+  class t_availData {
+   public:
+    t_plotData              _plotData;
+    QMap<t_prn, t_plotData> _plotDataMap;
+  };
+
+  // Sky plot values averaged on a grid of 1x1 degree cells
+  class t_skyGrid {
+   public:
+    void add(double azDeg, double zenDeg, double value);
+    QVector<t_polarPoint*>* points() const;
+   private:
+    QVector<double> _sum;
+    QVector<int>    _num;
+  };
+
+  // Everything produced while analyzing one observation file; each file is
+  // processed by its own task, the results are reported in input order.
+  // Epochs are kept only until their multipath chunk is complete.
   class t_qcFile {
    public:
-    t_qcFile() {
+    t_qcFile(t_rnxObsFile* obsFile) {
       clear();
+      _obsFile  = obsFile;
       _interval = 1.0;
+      _chunk    = 0;
+      _plotStep = 0.0;
+      _epoFile  = 0;
+      _dataMP1  = 0;
+      _dataMP2  = 0;
+      _dataSNR1 = 0;
+      _dataSNR2 = 0;
+    }
+    ~t_qcFile() {
+      for (int ii = 0; ii < _ownEphs.size(); ii++) {
+        delete _ownEphs[ii];
+      }
+      delete _epoFile;
     }
     void clear() {_qcSatSum.clear(); _qcEpo.clear();}
+    t_rnxObsFile*           _obsFile;
+    ColumnVector            _xyzSta;
     bncTime                 _startTime;
     bncTime                 _endTime;
     QString                 _antennaName;
@@ -153,7 +188,56 @@ Q_OBJECT
     QString                 _receiverType;
     double                  _interval;
     QMap<t_prn, t_qcSatSum> _qcSatSum;
-    QVector<t_qcEpo>        _qcEpo;
+    QVector<t_qcEpo>        _qcEpo;     // epochs of the current chunk
+    int                     _chunk;     // index of the current chunk
+    QMap<t_prn, int>        _numExpObs;
+    QVector<char>           _navFileIncomplete;
+    QVector<const t_eph*>   _ephIndex;  // first ephemeris, indexed by t_prn::toInt()
+    QVector<t_eph*>         _ownEphs;   // private copies (GLONASS orbits are integrated in place)
+    QString                 _report;
+    QTemporaryFile*         _epoFile;   // epoch-specific output
+    double                  _plotStep;  // [s] sampling of the time series plots
+    t_skyGrid               _skyMP1;
+    t_skyGrid               _skyMP2;
+    t_skyGrid               _skySNR1;
+    t_skyGrid               _skySNR2;
+    QVector<t_polarPoint*>* _dataMP1;
+    QVector<t_polarPoint*>* _dataMP2;
+    QVector<t_polarPoint*>* _dataSNR1;
+    QVector<t_polarPoint*>* _dataSNR2;
+    t_availData             _availData;
+    QSemaphore              _done;
+  };
+
+  class t_fileTask : public QRunnable {
+   public:
+    t_fileTask(const t_reqcAnalyze* reqcAnalyze, t_qcFile* qcFile) {
+      _reqcAnalyze = reqcAnalyze;
+      _qcFile      = qcFile;
+    }
+    virtual void run();
+   private:
+    const t_reqcAnalyze* _reqcAnalyze;
+    t_qcFile*            _qcFile;
+  };
+
+  class t_satTask : public QRunnable {
+   public:
+    t_satTask(const t_reqcAnalyze* reqcAnalyze, t_qcFile* qcFile,
+              const t_prn& prn, int* result, QSemaphore* done) {
+      _reqcAnalyze = reqcAnalyze;
+      _qcFile      = qcFile;
+      _prn         = prn;
+      _result      = result;
+      _done        = done;
+    }
+    virtual void run();
+   private:
+    const t_reqcAnalyze* _reqcAnalyze;
+    t_qcFile*            _qcFile;
+    t_prn                _prn;
+    int*                 _result;
+    QSemaphore*          _done;
   };
 
  private slots:
@@ -168,38 +252,53 @@ Q_OBJECT
 
   void   analyzePlotSignals(QMap<char, QVector<QString> >& signalTypes);
 
-  void   analyzeFile(t_rnxObsFile* obsFile);
+  void   analyzeFile(t_qcFile* qcFile) const;
+
+  void   initEphIndex(t_qcFile* qcFile) const;
+
+  void   runSatTasks(t_qcFile* qcFile) const;
+
+  void   updateQcSat(const t_qcSat& qcSat, t_qcSatSum& qcSatSum) const;
+
+  void   setQcObs(const t_qcFile* qcFile, const bncTime& epoTime, const t_satObs& satObs,
+                  QMap<QString, bncTime>& lastObsTime, t_qcSat& qcSat) const;
+
+  int    expectedObs(const t_qcFile* qcFile, const t_prn& prn) const;
+
+  void   closeChunk(t_qcFile* qcFile) const;
+
+  void   analyzeMultipath(t_qcFile* qcFile) const;
+
+  void   addPlotData(t_qcFile* qcFile, const t_qcEpo& qcEpo) const;
 
-  void   updateQcSat(const t_qcSat& qcSat, t_qcSatSum& qcSatSum);
+  void   thinPlotData(t_qcFile* qcFile) const;
 
-  void   setQcObs(const bncTime& epoTime, const ColumnVector& xyzSta,
-                  const t_satObs& satObs, QMap<QString, bncTime>& lastObsTime, t_qcSat& qcSat);
+  void   preparePlotData(t_qcFile* qcFile) const;
 
-  void   setExpectedObs(const bncTime& startTime, const bncTime& endTime,
-                        double interval, const ColumnVector& xyzSta);
+  double cmpDOP(const t_qcFile* qcFile, const t_rnxObsFile::t_rnxEpo* epo) const;
 
-  void   analyzeMultipath();
+  void   printReport(const t_qcFile* qcFile, QTextStream& out) const;
 
-  void   preparePlotData(const t_rnxObsFile* obsFile);
+  void   printEpoch(const t_qcEpo& qcEpo, QTextStream& out) const;
 
-  double cmpDOP(const ColumnVector& xyzSta) const;
+  void   dspPlots(t_qcFile* qcFile);
 
-  void   printReport(const t_rnxObsFile* obsFile);
+  static const int _maxPlotEpochs = 2880; // per file, time series plots are thinned beyond
 
   QString                       _logFileName;
   QFile*                        _logFile;
   QTextStream*                  _log;
+  bool                          _logSummaryOnly;
   QStringList                   _obsFileNames;
   QVector<t_rnxObsFile*>        _rnxObsFiles;
   QStringList                   _navFileNames;
   QString                       _reqcPlotSignals;
   QMap<char, QVector<QString> > _signalTypes;
-  QMap<t_prn, int>              _numExpObs;
-  QVector<char>                 _navFileIncomplete;
   QStringList                   _defaultSignalTypes;
   QVector<t_eph*>               _ephs;
-  t_rnxObsFile::t_rnxEpo*       _currEpo;
-  t_qcFile                      _qcFile;
+  QThreadPool*                  _satPool;
+  QMutex                        _mutex;
+  QMap<QString, t_availData>    _availData;
 };
 
 #endif
@@ -292,6 +292,14 @@ void t_reqcEdit::editObservations() {
     gloSlots.removeDuplicates();
   }
 
+  // Epochs are read and edited in this thread, formatted in blocks by the
+  // pool and written in input order (a limited number of blocks ahead)
+  // ---------------------------------------------------------------------
+  QThreadPool         formatPool;
+  const int           maxAhead = 2 * formatPool.maxThreadCount();
+  QQueue<t_epoBlock*> blocks;
+  t_epoBlock*         block    = 0;
+
   // Loop over all input observation files
   // -------------------------------------
   for (int ii = 0; ii < _rnxObsFiles.size(); ii++) {
@@ -326,7 +334,8 @@ void t_reqcEdit::editObservations() {
       }
       outObsFile.header().write(outObsFile.stream(), &txtMap);
     }
-    t_rnxObsFile::t_rnxEpo* epo = 0;
+    t_rnxObsFile::t_rnxEpo* epo    = 0;
+    bool                    failed = false;
     try {
       while ( (epo = obsFile->nextEpoch()) != 0) {
         if (_begTime.valid() && epo->tt < _begTime) {
@@ -339,7 +348,17 @@ void t_reqcEdit::editObservations() {
         if (_samplingRate == 0 ||
             fmod(round(epo->tt.gpssec()), _samplingRate) == 0) {
           applyLLI(obsFile, epo);
-          outObsFile.writeEpoch(epo);
+          if (!block) {
+            block = new t_epoBlock;
+            block->_epochs.reserve(_blockSize);
+          }
+          block->_epochs.append(*epo);
+          if (block->_epochs.size() == _blockSize) {
+            blocks.enqueue(block);
+            formatPool.start(new t_formatTask(&outObsFile.header(), block));
+            block = 0;
+            writeBlocks(outObsFile, blocks, maxAhead);
+          }
         }
         else {
           rememberLLI(obsFile, epo);
@@ -353,7 +372,7 @@ void t_reqcEdit::editObservations() {
       else {
         qDebug() << str;
       }
-      return;
+      failed = true;
     }
     catch (...) {
       if (_log) {
@@ -362,9 +381,44 @@ void t_reqcEdit::editObservations() {
       else {
         qDebug() << "Exception unknown";
       }
-      return;
+      failed = true;
+    }
+    if (failed) {
+      break;
     }
   }
+
+  // Write the remaining Epochs
+  // --------------------------
+  if (block) {
+    blocks.enqueue(block);
+    formatPool.start(new t_formatTask(&outObsFile.header(), block));
+  }
+  writeBlocks(outObsFile, blocks, 0);
+}
+
+// Format a Block of Epochs (runs in the format thread pool)
+////////////////////////////////////////////////////////////////////////////
+void t_reqcEdit::t_formatTask::run() {
+  QTextStream out(&_block->_text, QIODevice::WriteOnly);
+  for (int ii = 0; ii < _block->_epochs.size(); ii++) {
+    t_rnxObsFile::formatEpoch(&out, *_header, &_block->_epochs[ii]);
+  }
+  out.flush();
+  _block->_epochs.clear();
+  _block->_done.release();
+}
+
+// Write formatted Blocks until no more than maxBlocks are pending
+////////////////////////////////////////////////////////////////////////////
+void t_reqcEdit::writeBlocks(t_rnxObsFile& outObsFile, QQueue<t_epoBlock*>& blocks,
+                             int maxBlocks) {
+  while (blocks.size() > maxBlocks) {
+    t_epoBlock* block = blocks.dequeue();
+    block->_done.acquire();
+    *outObsFile.stream() << block->_text;
+    delete block;
+  }
 }
 
 // Change RINEX Header Content
@@ -619,19 +673,27 @@ void t_reqcEdit::editEphemerides() {
 void t_reqcEdit::appendEphemerides(const QString& fileName,
                                    QVector<t_eph*>& ephs) {
 
+  // Times of the ephemerides already present, per satellite
+  // -------------------------------------------------------
+  QHash<QString, QVector<bncTime> > tocs;
+  for (int iOld = 0; iOld < ephs.size(); iOld++) {
+    const t_eph* ephOld = ephs[iOld];
+    tocs[QString(ephOld->prn().toInternalString().c_str())].append(ephOld->TOC());
+  }
+
   t_rnxNavFile rnxNavFile(fileName, t_rnxNavFile::input);
   for (unsigned ii = 0; ii < rnxNavFile.ephs().size(); ii++) {
     t_eph* eph   = rnxNavFile.ephs()[ii];
     bool   isNew = true;
-    for (int iOld = 0; iOld < ephs.size(); iOld++) {
-      const t_eph* ephOld = ephs[iOld];
-      if (ephOld->prn() == eph->prn() &&
-          ephOld->TOC() == eph->TOC()) {
+    QVector<bncTime>& prnTocs = tocs[QString(eph->prn().toInternalString().c_str())];
+    for (int iOld = 0; iOld < prnTocs.size(); iOld++) {
+      if (prnTocs[iOld] == eph->TOC()) {
         isNew = false;
         break;
       }
     }
     if (isNew) {
+      prnTocs.append(eph->TOC());
       if      (eph->type() == t_eph::GPS) {
         ephs.append(new t_ephGPS(*dynamic_cast<t_ephGPS*>(eph)));
       }
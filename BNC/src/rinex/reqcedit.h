@@ -54,7 +54,30 @@ Q_OBJECT
   static void appendEphemerides(const QString& fileName, QVector<t_eph*>& ephs);
 
  private:
+  // Epochs formatted by one task; blocks are written in input order
+  class t_epoBlock {
+   public:
+    QVector<t_rnxObsFile::t_rnxEpo> _epochs;
+    QString                         _text;
+    QSemaphore                      _done;
+  };
+
+  class t_formatTask : public QRunnable {
+   public:
+    t_formatTask(const t_rnxObsHeader* header, t_epoBlock* block) {
+      _header = header;
+      _block  = block;
+    }
+    virtual void run();
+   private:
+    const t_rnxObsHeader* _header;
+    t_epoBlock*           _block;
+  };
+
+  static const int _blockSize = 100; // epochs per format task
+
   void editObservations();
+  void writeBlocks(t_rnxObsFile& outObsFile, QQueue<t_epoBlock*>& blocks, int maxBlocks);
   void editEphemerides();
   void editRnxObsHeader(t_rnxObsFile& obsFile);
   void rememberLLI(const t_rnxObsFile* obsFile, const t_rnxObsFile::t_rnxEpo* epo);
@@ -38,6 +38,7 @@
  *
  * -----------------------------------------------------------------------*/
 
+#include <algorithm>
 #include <iostream>
 #include <newmatio.h>
 #include "rnxnavfile.h"
@@ -47,6 +48,10 @@
 
 using namespace std;
 
+QMutex                                  t_rnxNavFile::_cacheMutex;
+QMap<QString, t_rnxNavFile::t_cached*>  t_rnxNavFile::_cache;
+QStringList                             t_rnxNavFile::_cacheOrder;
+
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
 t_rnxNavFile::t_rnxNavHeader::t_rnxNavHeader() {
@@ -90,9 +95,10 @@ t_irc t_rnxNavFile::t_rnxNavHeader::read(QTextStream* stream) {
 // Constructor
 ////////////////////////////////////////////////////////////////////////////
 t_rnxNavFile::t_rnxNavFile(const QString& fileName, e_inpOut inpOut) {
-  _inpOut = inpOut;
-  _stream = 0;
-  _file   = 0;
+  _inpOut  = inpOut;
+  _stream  = 0;
+  _file    = 0;
+  _indexed = false;
   if (_inpOut == input) {
     openRead(fileName);
   }
@@ -106,6 +112,10 @@ t_rnxNavFile::t_rnxNavFile(const QString& fileName, e_inpOut inpOut) {
 void t_rnxNavFile::openRead(const QString& fileName) {
 
   _fileName = fileName; expandEnvVar(_fileName);
+  if (readCached()) {
+    return;
+  }
+
   _file     = new QFile(_fileName);
   _file->open(QIODevice::ReadOnly | QIODevice::Text);
   _stream = new QTextStream();
@@ -113,6 +123,100 @@ void t_rnxNavFile::openRead(const QString& fileName) {
 
   _header.read(_stream);
   this->read(_stream);
+  putCached();
+}
+
+// Copy of the File Content if it has been read before (and not changed)
+////////////////////////////////////////////////////////////////////////////
+bool t_rnxNavFile::readCached() {
+
+  QFileInfo info(_fileName);
+  QString   key = info.canonicalFilePath();
+  if (key.isEmpty()) {
+    return false;
+  }
+
+  QMutexLocker locker(&_cacheMutex);
+
+  const t_cached* cached = _cache.value(key, 0);
+  if (!cached || cached->_modified != info.lastModified() ||
+      cached->_size != info.size()) {
+    return false;
+  }
+  _header = cached->_header;
+  _ephs.reserve(cached->_ephs.size());
+  for (unsigned ii = 0; ii < cached->_ephs.size(); ii++) {
+    _ephs.push_back(copyEph(cached->_ephs[ii]));
+  }
+  return true;
+}
+
+// Keep a Copy of the File Content for later Instances
+////////////////////////////////////////////////////////////////////////////
+void t_rnxNavFile::putCached() {
+
+  QFileInfo info(_fileName);
+  QString   key = info.canonicalFilePath();
+  if (key.isEmpty()) {
+    return;
+  }
+
+  t_cached* cached  = new t_cached;
+  cached->_modified = info.lastModified();
+  cached->_size     = info.size();
+  cached->_header   = _header;
+  cached->_ephs.reserve(_ephs.size());
+  for (unsigned ii = 0; ii < _ephs.size(); ii++) {
+    cached->_ephs.push_back(copyEph(_ephs[ii]));
+  }
+
+  QMutexLocker locker(&_cacheMutex);
+
+  if (_cache.contains(key)) {
+    delete _cache.take(key);
+    _cacheOrder.removeAll(key);
+  }
+  _cache[key] = cached;
+  _cacheOrder.append(key);
+  while (_cacheOrder.size() > _maxCached) {
+    delete _cache.take(_cacheOrder.takeFirst());
+  }
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+t_rnxNavFile::t_cached::~t_cached() {
+  for (unsigned ii = 0; ii < _ephs.size(); ii++) {
+    delete _ephs[ii];
+  }
+}
+
+// Copy of an Ephemeris
+////////////////////////////////////////////////////////////////////////////
+t_eph* t_rnxNavFile::copyEph(const t_eph* eph) {
+
+  const t_ephGPS*  ephGPS  = dynamic_cast<const t_ephGPS*>(eph);
+  const t_ephGlo*  ephGlo  = dynamic_cast<const t_ephGlo*>(eph);
+  const t_ephGal*  ephGal  = dynamic_cast<const t_ephGal*>(eph);
+  const t_ephSBAS* ephSBAS = dynamic_cast<const t_ephSBAS*>(eph);
+  const t_ephBDS*  ephBDS  = dynamic_cast<const t_ephBDS*>(eph);
+
+  if      (ephGPS) {
+    return new t_ephGPS(*ephGPS);
+  }
+  else if (ephGlo) {
+    return new t_ephGlo(*ephGlo);
+  }
+  else if (ephGal) {
+    return new t_ephGal(*ephGal);
+  }
+  else if (ephSBAS) {
+    return new t_ephSBAS(*ephSBAS);
+  }
+  else if (ephBDS) {
+    return new t_ephBDS(*ephBDS);
+  }
+  return 0;
 }
 
 // Open for output
@@ -133,6 +237,13 @@ t_rnxNavFile::~t_rnxNavFile() {
   for (unsigned ii = 0; ii < _ephs.size(); ii++) {
     delete _ephs[ii];
   }
+  QMapIterator<QString, vector<t_eph*> > it(_ephsPrn);
+  while (it.hasNext()) {
+    it.next();
+    for (unsigned ii = 0; ii < it.value().size(); ii++) {
+      delete it.value()[ii];
+    }
+  }
 }
 
 // Close
@@ -220,28 +331,66 @@ void t_rnxNavFile::read(QTextStream* stream) {
   }
 }
 
+// Ephemerides per Satellite, sorted by time
+////////////////////////////////////////////////////////////////////////////
+void t_rnxNavFile::indexEphs() {
+  for (unsigned ii = 0; ii < _ephs.size(); ii++) {
+    t_eph* eph = _ephs[ii];
+    _ephsPrn[QString(eph->prn().toInternalString().c_str())].push_back(eph);
+  }
+  QMutableMapIterator<QString, vector<t_eph*> > it(_ephsPrn);
+  while (it.hasNext()) {
+    it.next();
+    stable_sort(it.value().begin(), it.value().end(), t_eph::earlierTime);
+  }
+  _ephs.clear();
+  _indexed = true;
+}
+
+// Number of Ephemerides with TOC - tt < maxDt (binary search)
+////////////////////////////////////////////////////////////////////////////
+static unsigned numBefore(const vector<t_eph*>& ephs, const bncTime& tt, double maxDt) {
+  unsigned iMin = 0;
+  unsigned iMax = ephs.size();
+  while (iMin < iMax) {
+    unsigned iMid = (iMin + iMax) / 2;
+    if (ephs[iMid]->TOC() - tt < maxDt) {
+      iMin = iMid + 1;
+    }
+    else {
+      iMax = iMid;
+    }
+  }
+  return iMin;
+}
+
 // Read Next Ephemeris
 ////////////////////////////////////////////////////////////////////////////
 t_eph* t_rnxNavFile::getNextEph(const bncTime& tt,
                                 const QMap<QString, unsigned int>* corrIODs) {
 
+  if (!_indexed) {
+    indexEphs();
+  }
+
   // Get Ephemeris according to IOD
   // ------------------------------
   if (corrIODs) {
     QMapIterator<QString, unsigned int> itIOD(*corrIODs);
     while (itIOD.hasNext()) {
       itIOD.next();
-      QString prn = itIOD.key();
-      unsigned int iod = itIOD.value();
-      vector<t_eph*>::iterator it = _ephs.begin();
-      while (it != _ephs.end()) {
-        t_eph* eph = *it;
-        double dt = eph->TOC() - tt;
-        if (dt < 8*3600.0 && QString(eph->prn().toInternalString().c_str()) == prn && eph->IOD() == iod) {
-          it = _ephs.erase(it);
+      QMap<QString, vector<t_eph*> >::iterator itPrn = _ephsPrn.find(itIOD.key());
+      if (itPrn == _ephsPrn.end()) {
+        continue;
+      }
+      vector<t_eph*>& ephs = itPrn.value();
+      unsigned num = numBefore(ephs, tt, 8*3600.0);
+      for (unsigned ii = 0; ii < num; ii++) {
+        t_eph* eph = ephs[ii];
+        if (eph->IOD() == itIOD.value()) {
+          ephs.erase(ephs.begin() + ii);
           return eph;
         }
-        ++it;
       }
     }
   }
@@ -249,15 +398,15 @@ t_eph* t_rnxNavFile::getNextEph(const bncTime& tt,
   // Get Ephemeris according to time
   // -------------------------------
   else {
-    vector<t_eph*>::iterator it = _ephs.begin();
-    while (it != _ephs.end()) {
-      t_eph* eph = *it;
-      double dt = eph->TOC() - tt;
-      if (dt < 2*3600.0) {
-        it = _ephs.erase(it);
+    QMutableMapIterator<QString, vector<t_eph*> > itPrn(_ephsPrn);
+    while (itPrn.hasNext()) {
+      itPrn.next();
+      vector<t_eph*>& ephs = itPrn.value();
+      if (!ephs.empty() && ephs.front()->TOC() - tt < 2*3600.0) {
+        t_eph* eph = ephs.front();
+        ephs.erase(ephs.begin());
         return eph;
       }
-      ++it;
     }
   }
 
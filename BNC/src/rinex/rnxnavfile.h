@@ -56,7 +56,7 @@ class t_rnxNavFile {
   t_rnxNavFile(const QString& fileName, e_inpOut inpOut);
   ~t_rnxNavFile();
   t_eph* getNextEph(const bncTime& tt, const QMap<QString, unsigned int>* corrIODs);
-  const std::vector<t_eph*> ephs() const {return _ephs;}
+  const std::vector<t_eph*>& ephs() const {return _ephs;}
   double version() const {return _header._version;}
   void   setVersion(double version) {_header._version = version;}
   bool   glonass() const {return _header._glonass;}
@@ -66,13 +66,33 @@ class t_rnxNavFile {
   void   writeEph(const t_eph* eph);
 
  protected:
-  t_rnxNavFile() {};
+  t_rnxNavFile() {_indexed = false;};
   void openRead(const QString& fileName);
   void openWrite(const QString& fileName);
   void close();
 
  private:
-  void read(QTextStream* stream);
+  // Content of a file read before, shared by all instances
+  class t_cached {
+   public:
+    ~t_cached();
+    QDateTime           _modified;
+    qint64              _size;
+    t_rnxNavHeader      _header;
+    std::vector<t_eph*> _ephs;
+  };
+
+  void          read(QTextStream* stream);
+  bool          readCached();
+  void          putCached();
+  void          indexEphs();
+  static t_eph* copyEph(const t_eph* eph);
+
+  static const int _maxCached = 4; // files
+
+  static QMutex                    _cacheMutex;
+  static QMap<QString, t_cached*>  _cache;
+  static QStringList               _cacheOrder;
 
   e_inpOut            _inpOut;
   QFile*              _file;
@@ -80,6 +100,8 @@ class t_rnxNavFile {
   QTextStream*        _stream;
   std::vector<t_eph*> _ephs;
   t_rnxNavHeader      _header;
+  bool                _indexed;  // _ephs moved to _ephsPrn by getNextEph
+  QMap<QString, std::vector<t_eph*> > _ephsPrn; // sorted by TOC
 };
 
 #endif
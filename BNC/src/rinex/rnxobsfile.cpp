@@ -1284,6 +1284,13 @@ t_rnxObsFile::t_rnxEpo* t_rnxObsFile::nextEpochV2() {
 // Write Data Epoch
 ////////////////////////////////////////////////////////////////////////////
 void t_rnxObsFile::writeEpoch(const t_rnxEpo* epo) {
+  formatEpoch(_stream, _header, epo);
+}
+
+// Format Data Epoch (may be called for a copy of the header in any thread)
+////////////////////////////////////////////////////////////////////////////
+void t_rnxObsFile::formatEpoch(QTextStream* stream, const t_rnxObsHeader& header,
+                               const t_rnxEpo* epo) {
   if (epo == 0) {
     return;
   }
@@ -1291,16 +1298,16 @@ void t_rnxObsFile::writeEpoch(const t_rnxEpo* epo) {
   epoLocal.tt = epo->tt;
   for (unsigned ii = 0; ii < epo->rnxSat.size(); ii++) {
     const t_rnxSat& rnxSat = epo->rnxSat[ii];
-    if (_header._obsTypes[rnxSat.prn.system()].size() > 0) {
+    if (header._obsTypes.value(rnxSat.prn.system()).size() > 0) {
       epoLocal.rnxSat.push_back(rnxSat);
     }
   }
 
-  if (version() < 3.0) {
-    return writeEpochV2(_stream, _header, &epoLocal);
+  if (header.version() < 3.0) {
+    return writeEpochV2(stream, header, &epoLocal);
   }
   else {
-    return writeEpochV3(_stream, _header, &epoLocal);
+    return writeEpochV3(stream, header, &epoLocal);
   }
 }
 
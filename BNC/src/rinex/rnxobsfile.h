@@ -200,6 +200,8 @@ class t_rnxObsFile {
 
   void writeEpoch(const t_rnxEpo* epo);
 
+  static void formatEpoch(QTextStream* stream, const t_rnxObsHeader& header, const t_rnxEpo* epo);
+
   QTextStream* stream() {return _stream;}
 
   static void setObsFromRnx(const t_rnxObsFile* rnxObsFile, const t_rnxObsFile::t_rnxEpo* epo,
@@ -0,0 +1,473 @@
+// Part of BNC, a utility for retrieving decoding and
+// converting GNSS data streams from NTRIP broadcasters.
+//
+// Copyright (C) 2007
+// German Federal Agency for Cartography and Geodesy (BKG)
+// http://www.bkg.bund.de
+// Czech Technical University Prague, Department of Geodesy
+// http://www.fsv.cvut.cz
+//
+// Email: euref-ip@bkg.bund.de
+//
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation, version 2.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+/* -------------------------------------------------------------------------
+ * BKG NTRIP Client
+ * -------------------------------------------------------------------------
+ *
+ * Class:      t_rnxObsFormatter
+ *
+ * Purpose:    Direct output of RINEX observation epochs
+ *
+ * Author:     BKG
+ *
+ * Created:    18-Oct-2026
+ *
+ * Changes:
+ *
+ * -----------------------------------------------------------------------*/
+
+#include <math.h>
+#include <stdio.h>
+
+#include "rnxobsformatter.h"
+
+using namespace std;
+
+// Are the first two Characters of a Key equal to a Type
+////////////////////////////////////////////////////////////////////////////
+static bool isTypeLeft2(const string& key, const string& type) {
+  if (key.size() < 2) {
+    return key == type;
+  }
+  return type.size() == 2 && key.compare(0, 2, type) == 0;
+}
+
+// Does a (version 3) Key belong to a Version 2 Type (see type3to2)
+////////////////////////////////////////////////////////////////////////////
+static bool isTypeV2(const string& key, const string& typeV2) {
+  if (key.size() == 3 && key[0] == 'C' && (key[1] == '1' || key[1] == '2') &&
+      (key[2] == 'P' || key[2] == 'W')) {
+    return typeV2.size() == 2 && typeV2[0] == 'P' && typeV2[1] == key[1];
+  }
+  return isTypeLeft2(key, typeV2);
+}
+
+// Integer, right-justified
+////////////////////////////////////////////////////////////////////////////
+static void appendInt(string& buffer, long value, int width, char fill) {
+  char hlp[24];
+  int  pos = sizeof(hlp);
+  bool neg = value < 0;
+  unsigned long uu = neg ? -(unsigned long)(value) : value;
+  do {
+    hlp[--pos] = char('0' + uu % 10);
+    uu /= 10;
+  } while (uu > 0);
+  if (neg) {
+    hlp[--pos] = '-';
+  }
+  for (int ii = sizeof(hlp) - pos; ii < width; ii++) {
+    buffer += fill;
+  }
+  buffer.append(hlp + pos, sizeof(hlp) - pos);
+}
+
+// Fixed-point Number, right-justified (as "%*.*f")
+////////////////////////////////////////////////////////////////////////////
+static void appendFixed(string& buffer, double value, int width, int prec) {
+
+  static const double scales[] = {1.0, 1.e1, 1.e2, 1.e3, 1.e4, 1.e5, 1.e6, 1.e7, 1.e8};
+
+  if (prec > 8 || !(fabs(value) < 1.e9)) {
+    char hlp[64];
+    int  len = snprintf(hlp, sizeof(hlp), "%*.*f", width, prec, value);
+    buffer.append(hlp, len);
+    return;
+  }
+
+  // Rounded as printf does: the residual of the product is exact with fma,
+  // ties go to the even number
+  // ----------------------------------------------------------------------
+  long long scale = (long long)(scales[prec]);
+  long long num   = llround(fabs(value) * scales[prec]);
+  double    res   = fma(fabs(value), scales[prec], -double(num));
+  if      (res < -0.5 || (res == -0.5 && num % 2 == 1)) {
+    --num;
+  }
+  else if (res > 0.5 || (res == 0.5 && num % 2 == 1)) {
+    ++num;
+  }
+  long long whole = num / scale;
+  long long frac  = num % scale;
+
+  char hlp[40];
+  int  pos = sizeof(hlp);
+  for (int ii = 0; ii < prec; ii++) {
+    hlp[--pos] = char('0' + frac % 10);
+    frac /= 10;
+  }
+  if (prec > 0) {
+    hlp[--pos] = '.';
+  }
+  do {
+    hlp[--pos] = char('0' + whole % 10);
+    whole /= 10;
+  } while (whole > 0);
+  if (value < 0.0) {
+    hlp[--pos] = '-';
+  }
+  for (int ii = sizeof(hlp) - pos; ii < width; ii++) {
+    buffer += ' ';
+  }
+  buffer.append(hlp + pos, sizeof(hlp) - pos);
+}
+
+// Constructor
+////////////////////////////////////////////////////////////////////////////
+t_rnxObsFormatter::t_rnxObsFormatter() {
+  _version = 0.0;
+}
+
+// Destructor
+////////////////////////////////////////////////////////////////////////////
+t_rnxObsFormatter::~t_rnxObsFormatter() {
+}
+
+// Column Layout of all Systems of the Header
+////////////////////////////////////////////////////////////////////////////
+void t_rnxObsFormatter::init(const t_rnxObsHeader& header,
+                             const t_rnxObsHeader& sklHeader) {
+
+  _version = header.version();
+  _columns.clear();
+
+  for (int iSys = 0; iSys < header.numSys(); iSys++) {
+    char sys = header.system(iSys);
+    if (header.nTypes(sys) == 0) {
+      continue;
+    }
+    if (_version < 3.0) { // exclude new GNSS such as BDS, QZSS, IRNSS, etc.
+      if (sys != 'G' && sys != 'R' && sys != 'E' && sys != 'S') {
+        continue;
+      }
+    }
+
+    // Types of the skeleton (blank columns unless observed)
+    // ----------------------------------------------------
+    QStringList sklKeys;
+    for (int iType = 0; iType < sklHeader.nTypes(sys); iType++) {
+      sklKeys << sklHeader.obsType(sys, iType);
+    }
+
+    QVector<t_column>& columns = _columns[sys];
+    for (int iType = 0; iType < header.nTypes(sys); iType++) {
+      t_column column;
+      column._type = header.obsType(sys, iType).toLatin1().data();
+      if (_version < 3.0) {
+        initColumnV2(sys, column, sklKeys);
+      }
+      columns.append(column);
+    }
+  }
+}
+
+// Version 2 Column: observations to look for in the order of priority
+////////////////////////////////////////////////////////////////////////////
+void t_rnxObsFormatter::initColumnV2(char sys, t_column& column,
+                                     const QStringList& sklKeys) const {
+
+  const string& typeV2 = column._type;
+
+  QStringList preferredAttribList = t_rnxObsFile::signalPriorities(sys);
+  QString preferredAttrib;
+  for (int ii = 0; ii < preferredAttribList.size(); ii++) {
+    if (preferredAttribList[ii].indexOf("&") != -1) {
+      QStringList hlp = preferredAttribList[ii].split("&", QString::SkipEmptyParts);
+      if (hlp.size() == 2 && typeV2.size() > 1 && hlp[0].contains(QChar(typeV2[1]))) {
+        preferredAttrib = hlp[1];
+      }
+    }
+    else {
+      preferredAttrib = preferredAttribList[ii];
+    }
+  }
+
+  for (int iPref = 0; iPref < preferredAttrib.size(); iPref++) {
+    char    attrib = preferredAttrib[iPref].toLatin1();
+    t_probe probe;
+    if      (attrib == '?') {
+      probe._key = "?";
+      for (int ii = 0; ii < sklKeys.size(); ii++) {
+        string sklKey = sklKeys[ii].toLatin1().data();
+        if (isTypeV2(sklKey, typeV2) && (probe._sklKey.empty() || sklKey < probe._sklKey)) {
+          probe._sklKey = sklKey;
+        }
+      }
+      probe._inSkl = !probe._sklKey.empty();
+    }
+    else {
+      if (attrib == '_') {
+        probe._key = typeV2;
+      }
+      else if (typeV2.size() == 2) {
+        probe._key = typeV2;
+        if (typeV2[0] == 'P') {
+          probe._key[0] = 'C';
+        }
+        probe._key += attrib;
+      }
+      if (probe._key.empty() || !isTypeV2(probe._key, typeV2)) {
+        continue;
+      }
+      probe._inSkl = sklKeys.contains(probe._key.c_str());
+    }
+    column._probes.push_back(probe);
+  }
+}
+
+// Epoch in RINEX Format (valid until the next call)
+////////////////////////////////////////////////////////////////////////////
+const string& t_rnxObsFormatter::format(const bncTime& tt,
+                                        const QList<t_satObs>& obsList) {
+
+  _buffer.clear();
+
+  int numSat = 0;
+  for (int iSat = 0; iSat < obsList.size(); iSat++) {
+    if (_columns.contains(obsList[iSat]._prn.system())) {
+      ++numSat;
+    }
+  }
+
+  unsigned year, month, day, hour, min;
+  double sec;
+  tt.civil_date(year, month, day);
+  tt.civil_time(hour, min, sec);
+
+  // Epoch Line(s)
+  // -------------
+  if (_version >= 3.0) {
+    _buffer += "> ";
+    appendInt(_buffer, year, 4, ' ');
+  }
+  else {
+    _buffer += ' ';
+    appendInt(_buffer, year % 100, 2, '0');
+  }
+  _buffer += ' ';
+  appendInt(_buffer, month, 2, '0');
+  _buffer += ' ';
+  appendInt(_buffer, day, 2, '0');
+  _buffer += ' ';
+  appendInt(_buffer, hour, 2, '0');
+  _buffer += ' ';
+  appendInt(_buffer, min, 2, '0');
+  appendFixed(_buffer, sec, 11, 7);
+  appendInt(_buffer, 0, 3, ' ');
+  appendInt(_buffer, numSat, 3, ' ');
+
+  if (_version < 3.0) {
+    int iSatOut = 0;
+    for (int iSat = 0; iSat < obsList.size(); iSat++) {
+      const t_prn& prn = obsList[iSat]._prn;
+      if (!_columns.contains(prn.system())) {
+        continue;
+      }
+      if (iSatOut > 0 && iSatOut % 12 == 0) {
+        _buffer += '\n';
+        _buffer.append(32, ' ');
+      }
+      _buffer += prn.system();
+      appendInt(_buffer, prn.number(), 2, '0');
+      ++iSatOut;
+    }
+  }
+  _buffer += '\n';
+
+  // Observations
+  // ------------
+  for (int iSat = 0; iSat < obsList.size(); iSat++) {
+    const t_satObs& obs = obsList[iSat];
+    QMap<char, QVector<t_column> >::const_iterator it = _columns.constFind(obs._prn.system());
+    if (it == _columns.constEnd()) {
+      continue;
+    }
+    const QVector<t_column>& columns = it.value();
+    if (_version >= 3.0) {
+      _buffer += obs._prn.system();
+      appendInt(_buffer, obs._prn.number(), 2, '0');
+      for (int iCol = 0; iCol < columns.size(); iCol++) {
+        writeColumnV3(obs, columns[iCol]);
+      }
+    }
+    else {
+      for (int iCol = 0; iCol < columns.size(); iCol++) {
+        if (iCol > 0 && iCol % 5 == 0) {
+          _buffer += '\n';
+        }
+        writeColumnV2(obs, columns[iCol]);
+      }
+    }
+    _buffer += '\n';
+  }
+
+  return _buffer;
+}
+
+// Last valid Observation of a Key (as the last one overrides the others)
+////////////////////////////////////////////////////////////////////////////
+bool t_rnxObsFormatter::findObs(const t_satObs& obs, const string& key,
+                                double& value, bool& slip) const {
+  if (key.empty()) {
+    return false;
+  }
+  for (int ii = int(obs._obs.size()) - 1; ii >= 0; ii--) {
+    const t_frqObs* frqObs = obs._obs[ii];
+    if (key.compare(1, string::npos, frqObs->_rnxType2ch) != 0) {
+      continue;
+    }
+    slip = false;
+    switch (key[0]) {
+    case 'C':
+      if (frqObs->_codeValid) {
+        value = frqObs->_code;
+        return true;
+      }
+      break;
+    case 'L':
+      if (frqObs->_phaseValid) {
+        value = frqObs->_phase;
+        slip  = frqObs->_slip;
+        return true;
+      }
+      break;
+    case 'D':
+      if (frqObs->_dopplerValid) {
+        value = frqObs->_doppler;
+        return true;
+      }
+      break;
+    case 'S':
+      if (frqObs->_snrValid) {
+        value = frqObs->_snr;
+        return true;
+      }
+      break;
+    }
+  }
+  return false;
+}
+
+// First (sorted) Key of the Observations belonging to a Type; version 2:
+// type3to2(key) == type, version 3: key.left(2) == type and value != 0
+////////////////////////////////////////////////////////////////////////////
+bool t_rnxObsFormatter::firstKey(const t_satObs& obs, const string& type,
+                                 string& key) {
+  static const char kinds[] = "CLDS";
+  key.clear();
+  for (unsigned ii = 0; ii < obs._obs.size(); ii++) {
+    const t_frqObs* frqObs = obs._obs[ii];
+    for (int iKind = 0; iKind < 4; iKind++) {
+      char kind = kinds[iKind];
+      if ((kind == 'C' && !frqObs->_codeValid)    ||
+          (kind == 'L' && !frqObs->_phaseValid)   ||
+          (kind == 'D' && !frqObs->_dopplerValid) ||
+          (kind == 'S' && !frqObs->_snrValid)) {
+        continue;
+      }
+      _key  = kind;
+      _key += frqObs->_rnxType2ch;
+      if (!key.empty() && _key >= key) {
+        continue;
+      }
+      if (_version < 3.0) {
+        if (!isTypeV2(_key, type)) {
+          continue;
+        }
+      }
+      else {
+        double value;
+        bool   slip;
+        if (!isTypeLeft2(_key, type) || !findObs(obs, _key, value, slip) || value == 0.0) {
+          continue;
+        }
+      }
+      key = _key;
+    }
+  }
+  return !key.empty();
+}
+
+// Version 2 Column: first observation (or skeleton type) in priority order
+////////////////////////////////////////////////////////////////////////////
+void t_rnxObsFormatter::writeColumnV2(const t_satObs& obs, const t_column& column) {
+  double value;
+  bool   slip;
+  for (unsigned iProbe = 0; iProbe < column._probes.size(); iProbe++) {
+    const t_probe& probe = column._probes[iProbe];
+    if (probe._key == "?") {
+      if (firstKey(obs, column._type, _bestKey) &&
+          (probe._sklKey.empty() || _bestKey <= probe._sklKey) &&
+          findObs(obs, _bestKey, value, slip)) {
+        writeObs(value, slip);
+        return;
+      }
+    }
+    else if (findObs(obs, probe._key, value, slip)) {
+      writeObs(value, slip);
+      return;
+    }
+    if (probe._inSkl) {
+      writeBlank();
+      return;
+    }
+  }
+  writeBlank();
+}
+
+// Version 3 Column: exact type, else first one with the same two characters
+////////////////////////////////////////////////////////////////////////////
+void t_rnxObsFormatter::writeColumnV3(const t_satObs& obs, const t_column& column) {
+  double value;
+  bool   slip;
+  if (findObs(obs, column._type, value, slip) && value != 0.0) {
+    writeObs(value, slip);
+  }
+  else if (column._type.size() <= 2 && firstKey(obs, column._type, _bestKey) &&
+           findObs(obs, _bestKey, value, slip)) {
+    writeObs(value, slip);
+  }
+  else {
+    writeBlank();
+  }
+}
+
+// Observation with LLI and (empty) signal strength
+////////////////////////////////////////////////////////////////////////////
+void t_rnxObsFormatter::writeObs(double value, bool slip) {
+  if (value == 0.0) {
+    writeBlank();
+    return;
+  }
+  appendFixed(_buffer, value, 14, 3);
+  _buffer += slip ? '1' : ' ';
+  _buffer += ' ';
+}
+
+// Empty Observation
+////////////////////////////////////////////////////////////////////////////
+void t_rnxObsFormatter::writeBlank() {
+  _buffer.append(16, ' ');
+}
@@ -0,0 +1,58 @@
+#ifndef RNXOBSFORMATTER_H
+#define RNXOBSFORMATTER_H
+
+#include <string>
+#include <vector>
+#include <QList>
+#include <QMap>
+#include <QStringList>
+#include <QVector>
+
+#include "bnctime.h"
+#include "satObs.h"
+#include "rnxobsfile.h"
+
+// RINEX 2/3 observation epochs written straight from t_satObs. The columns
+// of each system (and, for version 2, the signal priorities) are resolved
+// from the header once; the output has the layout of
+// t_rnxObsFile::writeEpoch.
+class t_rnxObsFormatter {
+ public:
+  t_rnxObsFormatter();
+  ~t_rnxObsFormatter();
+
+  void init(const t_rnxObsHeader& header, const t_rnxObsHeader& sklHeader);
+  const std::string& format(const bncTime& tt, const QList<t_satObs>& obsList);
+
+ private:
+  // Candidate observation of a version 2 column ("?": any attribute)
+  class t_probe {
+   public:
+    std::string _key;    // e.g. "C1W"
+    bool        _inSkl;  // listed in the skeleton (blank if not observed)
+    std::string _sklKey; // "?": first matching key of the skeleton
+  };
+
+  class t_column {
+   public:
+    std::string          _type;
+    std::vector<t_probe> _probes;
+  };
+
+  void initColumnV2(char sys, t_column& column, const QStringList& sklKeys) const;
+  bool findObs(const t_satObs& obs, const std::string& key,
+               double& value, bool& slip) const;
+  bool firstKey(const t_satObs& obs, const std::string& type, std::string& key);
+  void writeColumnV2(const t_satObs& obs, const t_column& column);
+  void writeColumnV3(const t_satObs& obs, const t_column& column);
+  void writeObs(double value, bool slip);
+  void writeBlank();
+
+  double                         _version;
+  QMap<char, QVector<t_column> > _columns;
+  std::string                    _buffer;
+  std::string                    _key;     // reused by firstKey
+  std::string                    _bestKey;
+};
+
+#endif
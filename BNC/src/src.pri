@@ -52,6 +52,10 @@ HEADERS = bnchelp.html bncgetthread.h    bncwindow.h   bnctabledlg.h  \
           bncmap.h bncantex.h bncephuser.h                            \
           bncoutf.h bncclockrinex.h bncsp3.h bncsinextro.h            \
           bncbytescounter.h bncsslconfig.h reqcdlg.h                  \
+          bncnettransport.h bncrtpbuffer.h bncstreamstats.h           \
+          bncalertservice.h bncrawbuffer.h bncrawwriter.h             \
+          bncsklcache.h                                               \
+          bncrotationservice.h                                        \
           upload/bncrtnetdecoder.h upload/bncuploadcaster.h           \
           ephemeris.h t_prn.h satObs.h                                \
           upload/bncrtnetuploadcaster.h upload/bnccustomtrafo.h       \
@@ -63,8 +67,9 @@ HEADERS = bnchelp.html bncgetthread.h    bncwindow.h   bnctabledlg.h  \
           RTCM3/RTCM3Decoder.h RTCM3/bits.h RTCM3/gnss.h              \
           RTCM3/RTCM3coDecoder.h RTCM3/ephEncoder.h                   \
           RTCM3/clock_and_orbit/clock_orbit_rtcm.h                    \
-          rinex/rnxobsfile.h                                          \
+          rinex/rnxobsfile.h       rinex/rnxobsformatter.h            \
           rinex/rnxnavfile.h       rinex/corrfile.h                   \
+          rinex/corrbinary.h                                          \
           rinex/reqcedit.h         rinex/reqcanalyze.h                \
           rinex/graphwin.h         rinex/polarplot.h                  \
           rinex/availplot.h        rinex/eleplot.h                    \
@@ -88,6 +93,10 @@ SOURCES = bncgetthread.cpp  bncwindow.cpp bnctabledlg.cpp             \
           bncmap_svg.cpp bncantex.cpp bncephuser.cpp                  \
           bncoutf.cpp bncclockrinex.cpp bncsp3.cpp bncsinextro.cpp    \
           bncbytescounter.cpp bncsslconfig.cpp reqcdlg.cpp            \
+          bncnettransport.cpp bncrtpbuffer.cpp bncstreamstats.cpp     \
+          bncalertservice.cpp bncrawbuffer.cpp bncrawwriter.cpp       \
+          bncsklcache.cpp                                             \
+          bncrotationservice.cpp                                      \
           ephemeris.cpp t_prn.cpp satObs.cpp                          \
           upload/bncrtnetdecoder.cpp upload/bncuploadcaster.cpp       \
           upload/bncrtnetuploadcaster.cpp upload/bnccustomtrafo.cpp   \
@@ -100,8 +109,9 @@ SOURCES = bncgetthread.cpp  bncwindow.cpp bnctabledlg.cpp             \
           RTCM3/RTCM3Decoder.cpp                                      \
           RTCM3/RTCM3coDecoder.cpp RTCM3/ephEncoder.cpp               \
           RTCM3/clock_and_orbit/clock_orbit_rtcm.c                    \
-          rinex/rnxobsfile.cpp                                        \
+          rinex/rnxobsfile.cpp     rinex/rnxobsformatter.cpp          \
           rinex/rnxnavfile.cpp     rinex/corrfile.cpp                 \
+          rinex/corrbinary.cpp                                        \
           rinex/reqcedit.cpp       rinex/reqcanalyze.cpp              \
           rinex/graphwin.cpp       rinex/polarplot.cpp                \
           rinex/availplot.cpp      rinex/eleplot.cpp                  \
@@ -129,8 +139,10 @@ exists(PPP) {
 else {
   INCLUDEPATH += PPP_SSR_I
   DEFINES += USE_PPP_SSR_I
-  HEADERS += PPP_SSR_I/pppClient.h   PPP_SSR_I/pppFilter.h   PPP_SSR_I/pppUtils.h
-  SOURCES += PPP_SSR_I/pppClient.cpp PPP_SSR_I/pppFilter.cpp PPP_SSR_I/pppUtils.cpp
+  HEADERS += PPP_SSR_I/pppClient.h   PPP_SSR_I/pppFilter.h   PPP_SSR_I/pppUtils.h   \
+             PPP_SSR_I/pppSatCache.h
+  SOURCES += PPP_SSR_I/pppClient.cpp PPP_SSR_I/pppFilter.cpp PPP_SSR_I/pppUtils.cpp \
+             PPP_SSR_I/pppSatCache.cpp
 }
 
 # Check QtWebKit Library Existence
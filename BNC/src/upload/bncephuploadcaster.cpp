@@ -41,9 +41,6 @@ bncEphUploadCaster::bncEphUploadCaster() : bncEphUser(true) {
                                                        hlp[3], hlp[4],
                                                        hlp[5], iRow, sampl);
 
-      connect(newCaster, SIGNAL(newBytes(QByteArray,double)),
-              this, SIGNAL(newBytes(QByteArray,double)));
-
       newCaster->start();
       _casters.push_back(newCaster);
     }
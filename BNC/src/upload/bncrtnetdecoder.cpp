@@ -49,9 +49,11 @@ using namespace std;
 bncRtnetDecoder::bncRtnetDecoder() {
   bncSettings settings;
 
-  // List of upload casters
-  // ----------------------
+  // List of upload casters; rows differing only in the target caster share
+  // one encoder, which publishes each encoded epoch to the other casters
+  // -----------------------------------------------------------------------
   int iRow = -1;
+  QMap<QString, bncRtnetUploadCaster*> encoders;
   QListIterator<QString> it(settings.value("uploadMountpointsOut").toStringList());
   while (it.hasNext()) {
     QStringList hlp = it.next().split(",");
@@ -71,6 +73,18 @@ bncRtnetDecoder::bncRtnetDecoder() {
       if (hlp.size() > 12) {
         IOD = hlp[12].toInt();
       }
+      QString encoding = QString("%1,%2,%3,%4,%5").arg(hlp[6]).arg(CoM)
+                                                  .arg(PID).arg(SID).arg(IOD);
+      bool ownFiles = !hlp[8].isEmpty() || !hlp[9].isEmpty();
+      if (!ownFiles && encoders.contains(encoding)) {
+        bncUploadCaster* newCaster = new bncUploadCaster(hlp[2], hlp[0], outPort,
+                                                         hlp[3], hlp[4],
+                                                         hlp[5], iRow, 0);
+        newCaster->start();
+        encoders[encoding]->addPublisher(newCaster);
+        _publishers.push_back(newCaster);
+        continue;
+      }
       bncRtnetUploadCaster* newCaster = new bncRtnetUploadCaster(
                                                        hlp[2], hlp[0], outPort,
                                                        hlp[3], hlp[4],
@@ -79,6 +93,9 @@ bncRtnetDecoder::bncRtnetDecoder() {
                                                        PID, SID, IOD, iRow);
       newCaster->start();
       _casters.push_back(newCaster);
+      if (!encoders.contains(encoding)) {
+        encoders[encoding] = newCaster;
+      }
     }
   }
 }
@@ -89,6 +106,9 @@ bncRtnetDecoder::~bncRtnetDecoder() {
   for (int ic = 0; ic < _casters.size(); ic++) {
     _casters[ic]->deleteSafely();
   }
+  for (int ic = 0; ic < _publishers.size(); ic++) {
+    _publishers[ic]->deleteSafely();
+  }
 }
 
 // Decode Method
@@ -38,6 +38,7 @@ class bncRtnetDecoder: public GPSDecoder {
                        std::vector<std::string>& errmsg);
  private:
   QVector<bncRtnetUploadCaster*> _casters;
+  QVector<bncUploadCaster*>      _publishers; // casters fed by one of _casters
 };
 
 #endif  // include blocker
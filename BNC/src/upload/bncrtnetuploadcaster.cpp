@@ -239,10 +239,22 @@ bncRtnetUploadCaster::~bncRtnetUploadCaster() {
   delete _usedEph;
 }
 
+// Caster receiving the Epochs encoded here (same encoding, other target)
+////////////////////////////////////////////////////////////////////////////
+void bncRtnetUploadCaster::addPublisher(bncUploadCaster* caster) {
+  QMutexLocker locker(&_mutex);
+  _publishers.push_back(caster);
+}
+
 //
 ////////////////////////////////////////////////////////////////////////////
 void bncRtnetUploadCaster::decodeRtnetStream(char* buffer, int bufLen) {
 
+  // Stage times from the input of the epoch end (EOE) to the encoded epoch
+  // ----------------------------------------------------------------------
+  QElapsedTimer stageTimer;
+  stageTimer.start();
+
   QMutexLocker locker(&_mutex);
 
   // Append to internal buffer
@@ -2091,6 +2103,8 @@ void bncRtnetUploadCaster::decodeRtnetStream(char* buffer, int bufLen) {
     }
   }
 
+  qint64 decodeTime = stageTimer.nsecsElapsed() / 1000;
+
   QByteArray hlpBufferCo;
 
   // Orbit and Clock Corrections together
@@ -2266,8 +2280,29 @@ void bncRtnetUploadCaster::decodeRtnetStream(char* buffer, int bufLen) {
     }
   }
 
-  _outBuffer += hlpBufferCo + hlpBufferBias + hlpBufferPhaseBias
+  // The encoded epoch is shared (not copied) by all casters of the group
+  // --------------------------------------------------------------------
+  QByteArray epochBuffer = hlpBufferCo + hlpBufferBias + hlpBufferPhaseBias
       + hlpBufferVtec;
+  _outBuffer += epochBuffer;
+  queueOutBuffer(decodeTime, stageTimer.nsecsElapsed() / 1000 - decodeTime);
+  for (int ic = 0; ic < _publishers.size(); ic++) {
+    _publishers[ic]->setOutBuffer(epochBuffer, decodeTime,
+                                  stageTimer.nsecsElapsed() / 1000 - decodeTime);
+  }
+
+  // File output is not on the way to the casters
+  // --------------------------------------------
+  for (int ii = 0; ii < _fileRecords.size(); ii++) {
+    const t_fileRecord& rec = _fileRecords[ii];
+    if (_rnx) {
+      _rnx->write(rec._GPSweek, rec._GPSweeks, rec._prn, rec._clk);
+    }
+    if (_sp3) {
+      _sp3->write(rec._GPSweek, rec._GPSweeks, rec._prn, rec._crd, rec._clk);
+    }
+  }
+  _fileRecords.clear();
 }
 
 //
@@ -2348,11 +2383,14 @@ void bncRtnetUploadCaster::processSatellite(const t_eph* eph, int GPSweek,
   double relativity = -2.0 * DotProduct(xP, rtnVel) / t_CST::c;
   double sp3Clk = (rtnClk - relativity) / t_CST::c;  // in seconds
 
-  if (_rnx) {
-    _rnx->write(GPSweek, GPSweeks, prn, sp3Clk);
-  }
-  if (_sp3) {
-    _sp3->write(GPSweek, GPSweeks, prn, rtnCoM, sp3Clk);
+  if (_rnx || _sp3) {
+    t_fileRecord rec;
+    rec._GPSweek  = GPSweek;
+    rec._GPSweeks = GPSweeks;
+    rec._prn      = prn;
+    rec._crd      = rtnCoM;
+    rec._clk      = sp3Clk;
+    _fileRecords.append(rec);
   }
 }
 
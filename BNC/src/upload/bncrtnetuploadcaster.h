@@ -26,9 +26,20 @@ class bncRtnetUploadCaster : public bncUploadCaster {
                   const QString& rnxFileName,
                   int PID, int SID, int IOD, int iRow);
   void decodeRtnetStream(char* buffer, int bufLen);
+  void addPublisher(bncUploadCaster* caster);
  protected:
   virtual ~bncRtnetUploadCaster();
  private:
+  // Clock RINEX and SP3 records, written after the epoch has been queued
+  class t_fileRecord {
+   public:
+    int          _GPSweek;
+    double       _GPSweeks;
+    QString      _prn;
+    ColumnVector _crd;
+    double       _clk;
+  };
+
   void processSatellite(const t_eph* eph, int GPSweek,
                         double GPSweeks, const QString& prn,
                         const ColumnVector& rtnAPC,
@@ -72,6 +83,8 @@ class bncRtnetUploadCaster : public bncUploadCaster {
   bncClockRinex* _rnx;
   bncSP3*        _sp3;
   QMap<QString, const t_eph*>* _usedEph;
+  QVector<bncUploadCaster*>    _publishers;
+  QList<t_fileRecord>          _fileRecords;
   // TODO: the following lines can be deleted if all parameters are updated regarding ITRF2014
   double         _dx8;
   double         _dy8;
@@ -18,6 +18,7 @@
 #include "bncuploadcaster.h"
 #include "bncversion.h"
 #include "bnccore.h"
+#include "bncstreamstats.h"
 #include "bnctableitem.h"
 
 using namespace std;
@@ -38,6 +39,7 @@ bncUploadCaster::bncUploadCaster(const QString& mountpoint,
   _password      = password;
   _outSocket     = 0;
   _sOpenTrial    = 0;
+  _nextOpen      = 0;
   _iRow          = iRow;
   _rate          = rate;
   if      (_rate < 0) {
@@ -47,21 +49,39 @@ bncUploadCaster::bncUploadCaster(const QString& mountpoint,
     _rate = 60;
   }
   _isToBeDeleted = false;
+  _state         = disconnected;
+  _stateTime     = 0;
+  _numDropped    = 0;
+  _numSent       = 0;
+  _sumLatency    = 0;
+  _maxLatency    = 0;
+  for (int ii = 0; ii < 4; ii++) {
+    _sumStage[ii] = 0;
+  }
+  _lastReport    = 0;
+  _clock.start();
+
+  // Send latency, kept apart from the incoming streams
+  // --------------------------------------------------
+  _counters = bncStreamStats::instance()->counters(
+        (_outHost + ":" + QString::number(_outPort) + "/" + _mountpoint).toLatin1());
 
   connect(this, SIGNAL(newMessage(QByteArray,bool)),
           BNC_CORE, SLOT(slotMessage(const QByteArray,bool)));
 
   if (BNC_CORE->_uploadTableItems.find(_iRow) != BNC_CORE->_uploadTableItems.end()){
-    connect(this, SIGNAL(newBytes(QByteArray,double)),
-            BNC_CORE->_uploadTableItems.value(iRow),
-            SLOT(slotNewBytes(const QByteArray,double)));
+    BNC_CORE->_uploadTableItems.value(iRow)->setCounters(_counters);
   }
 }
 
 // Safe Desctructor
 ////////////////////////////////////////////////////////////////////////////
 void bncUploadCaster::deleteSafely() {
-  _isToBeDeleted = true;
+  {
+    QMutexLocker locker(&_mutex);
+    _isToBeDeleted = true;
+    _waitCond.wakeAll();
+  }
   if (!isRunning()) {
     delete this;
   }
@@ -78,38 +98,108 @@ bncUploadCaster::~bncUploadCaster() {
   }
 }
 
+// New Contents of the Output Buffer
+////////////////////////////////////////////////////////////////////////////
+void bncUploadCaster::setOutBuffer(const QByteArray& outBuffer,
+                                   qint64 decodeTime, qint64 encodeTime) {
+  QMutexLocker locker(&_mutex);
+  _outBuffer = outBuffer;
+  if (_rate == 0) {
+    queueOutBuffer(decodeTime, encodeTime);
+  }
+}
+
+// Queue the Output Buffer as one Epoch (requires _mutex); decodeTime and
+// encodeTime [us] are the durations of the stages before, if known
+////////////////////////////////////////////////////////////////////////////
+void bncUploadCaster::queueOutBuffer(qint64 decodeTime, qint64 encodeTime) {
+  if (_outBuffer.isEmpty()) {
+    return;
+  }
+  if (_queue.size() >= _maxQueue) {
+    _queue.removeFirst();
+    ++_numDropped;
+  }
+  t_epoch epoch;
+  epoch._data   = _outBuffer;
+  epoch._decode = decodeTime;
+  epoch._encode = encodeTime;
+  epoch._queued = usec();
+  _queue.append(epoch);
+  if (_rate == 0) {
+    _outBuffer.clear();
+  }
+  _waitCond.wakeOne();
+}
+
 // Endless Loop
 ////////////////////////////////////////////////////////////////////////////
 void bncUploadCaster::run() {
+
+  qint64 nextRate = _clock.elapsed() + 1000 * _rate;
+
   while (true) {
-    if (_isToBeDeleted) {
-      QThread::quit();
-      deleteLater();
-      return;
-    }
-    open();
-    if (_outSocket && _outSocket->state() == QAbstractSocket::ConnectedState) {
+    {
       QMutexLocker locker(&_mutex);
-      if (_outBuffer.size() > 0) {
-        _outSocket->write(_outBuffer);
-        _outSocket->flush();
-        emit newBytes(_mountpoint.toLatin1(), _outBuffer.size());
+      if (_isToBeDeleted) {
+        break;
       }
-    }
-    if (_rate == 0) {
-      {
-        QMutexLocker locker(&_mutex);
-        _outBuffer.clear();
+      // A caster with a fixed rate repeats its current buffer
+      // -----------------------------------------------------
+      if (_rate > 0 && _clock.elapsed() >= nextRate) {
+        nextRate = _clock.elapsed() + 1000 * _rate;
+        if (_state == streaming) {
+          queueOutBuffer();
+        }
       }
-      msleep(100); //sleep 0.1 sec
     }
-    else {
-      sleep(_rate);
+    qint64 toRate = (_rate > 0) ? qMax(nextRate - _clock.elapsed(), qint64(0)) : -1;
+
+    switch (_state) {
+    case disconnected:
+      open();
+      if (_state == disconnected) {
+        qint64 toOpen = _mountpoint.isEmpty() ? -1 :
+                        qMax(_nextOpen - _clock.elapsed(), qint64(0));
+        waitForEvent((toRate < 0 || (toOpen >= 0 && toOpen < toRate)) ? toOpen : toRate,
+                     true);
+      }
+      break;
+    case connecting:
+      if (_outSocket->waitForConnected(_waitSlice)) {
+        QByteArray msg = "SOURCE " + _password.toLatin1() + " /" +
+                         _mountpoint.toLatin1() + "\r\n" +
+                         "Source-Agent: NTRIP BNC/" BNCVERSION "\r\n\r\n";
+        _outSocket->write(msg);
+        _outSocket->flush();
+        _state     = requesting;
+        _stateTime = _clock.elapsed();
+      }
+      else if (_outSocket->state() == QAbstractSocket::UnconnectedState ||
+               _clock.elapsed() - _stateTime > _timeOut) {
+        closeSocket("Connect timeout");
+      }
+      break;
+    case requesting:
+      readReply();
+      break;
+    case streaming:
+      if (_outSocket->bytesToWrite() > 0) {
+        writeSocket();
+      }
+      else if (!sendEpoch()) {
+        waitForEvent(toRate, false);
+      }
+      break;
     }
   }
+
+  closeSocket("");
+  QThread::quit();
+  deleteLater();
 }
 
-// Start the Communication with NTRIP Caster
+// Start the Communication with NTRIP Caster (does not wait)
 ////////////////////////////////////////////////////////////////////////////
 void bncUploadCaster::open() {
 
@@ -117,54 +207,161 @@ void bncUploadCaster::open() {
     return;
   }
 
-  if (_outSocket != 0 &&
-      _outSocket->state() == QAbstractSocket::ConnectedState) {
+  if (_clock.elapsed() < _nextOpen) {
     return;
   }
-
-  delete _outSocket; _outSocket = 0;
-
   double minDt = pow(2.0,_sOpenTrial);
   if (++_sOpenTrial > 4) {
     _sOpenTrial = 4;
   }
-  if (_outSocketOpenTime.isValid() &&
-      _outSocketOpenTime.secsTo(QDateTime::currentDateTime()) < minDt) {
-    return;
-  }
-  else {
-    _outSocketOpenTime = QDateTime::currentDateTime();
-  }
+  _nextOpen = _clock.elapsed() + qint64(1000 * minDt);
 
+  delete _outSocket;
   _outSocket = new QTcpSocket();
   _outSocket->connectToHost(_outHost, _outPort);
+  _state     = connecting;
+  _stateTime = _clock.elapsed();
+}
 
-  const int timeOut = 5000;  // 5 seconds
-  if (!_outSocket->waitForConnected(timeOut)) {
-    delete _outSocket;
-    _outSocket = 0;
-    emit(newMessage("Broadcaster: Connect timeout for " + _mountpoint.toLatin1(), true));
-    return;
+// Close the Connection, queued epochs are kept for the next one
+////////////////////////////////////////////////////////////////////////////
+void bncUploadCaster::closeSocket(const QByteArray& reason) {
+  delete _outSocket;
+  _outSocket = 0;
+  _state     = disconnected;
+  _inFlight  = t_epoch();
+  if (!reason.isEmpty()) {
+    emit(newMessage("Broadcaster: " + reason + " for " + _mountpoint.toLatin1(), true));
   }
+}
 
-  QByteArray msg = "SOURCE " + _password.toLatin1() + " /" +
-                   _mountpoint.toLatin1() + "\r\n" +
-                   "Source-Agent: NTRIP BNC/" BNCVERSION "\r\n\r\n";
+// Answer of the NTRIP Caster
+////////////////////////////////////////////////////////////////////////////
+void bncUploadCaster::readReply() {
+  if (!_outSocket->canReadLine()) {
+    _outSocket->waitForReadyRead(_waitSlice);
+  }
+  if (_outSocket->canReadLine()) {
+    QByteArray ans = _outSocket->readLine();
+    if (ans.indexOf("OK") == -1) {
+      closeSocket("Connection broken");
+    }
+    else {
+      emit(newMessage("Broadcaster: Connection opened for " + _mountpoint.toLatin1(), true));
+      _sOpenTrial = 0;
+      _state      = streaming;
+      _stateTime  = _clock.elapsed();
+    }
+  }
+  else if (_outSocket->state() != QAbstractSocket::ConnectedState ||
+           _clock.elapsed() - _stateTime > _timeOut) {
+    closeSocket("Connection broken");
+  }
+}
 
-  _outSocket->write(msg);
-  _outSocket->waitForBytesWritten();
+// Wait until the Socket has taken the Epoch
+////////////////////////////////////////////////////////////////////////////
+void bncUploadCaster::writeSocket() {
+  _outSocket->waitForBytesWritten(_waitSlice);
+  if (_outSocket->state() != QAbstractSocket::ConnectedState) {
+    closeSocket("Connection broken");
+  }
+  else if (_outSocket->bytesToWrite() == 0) {
+    epochSent();
+  }
+}
 
-  _outSocket->waitForReadyRead();
-  QByteArray ans = _outSocket->readLine();
+// Hand the oldest queued Epoch to the Socket
+////////////////////////////////////////////////////////////////////////////
+bool bncUploadCaster::sendEpoch() {
+  t_epoch epoch;
+  int     numDropped;
+  {
+    QMutexLocker locker(&_mutex);
+    if (_queue.isEmpty()) {
+      return false;
+    }
+    epoch       = _queue.takeFirst();
+    numDropped  = _numDropped;
+    _numDropped = 0;
+  }
+  if (numDropped > 0) {
+    emit(newMessage("Broadcaster: " + QByteArray::number(numDropped) +
+                    " epoch(s) dropped for " + _mountpoint.toLatin1() +
+                    ", caster too slow", true));
+  }
+  epoch._written = usec();
+  _outSocket->write(epoch._data);
+  _outSocket->flush();
+  _counters->addChunk(epoch._data.size());
+  _inFlight = epoch;
+  if (_outSocket->state() != QAbstractSocket::ConnectedState) {
+    closeSocket("Connection broken");
+  }
+  else if (_outSocket->bytesToWrite() == 0) {
+    epochSent();
+  }
+  return true;
+}
 
-  if (ans.indexOf("OK") == -1) {
-    delete _outSocket;
-    _outSocket = 0;
-    emit(newMessage("Broadcaster: Connection broken for " + _mountpoint.toLatin1(), true));
+// Send Latency (input until written to the socket)
+////////////////////////////////////////////////////////////////////////////
+void bncUploadCaster::epochSent() {
+  if (_inFlight._queued < 0) {
+    return;
   }
-  else {
-    emit(newMessage("Broadcaster: Connection opened for " + _mountpoint.toLatin1(), true));
-    _sOpenTrial = 0;
+  const t_epoch& ep = _inFlight;
+  qint64 sent    = usec();
+  qint64 latency = sent - ep._queued + ep._decode + ep._encode;
+  _counters->setLatency(latency / 1.e6);
+  ++_numSent;
+  _sumLatency += latency;
+  _maxLatency  = qMax(_maxLatency, latency);
+  _sumStage[0] += ep._decode;
+  _sumStage[1] += ep._encode;
+  _sumStage[2] += ep._written - ep._queued;
+  _sumStage[3] += sent - ep._written;
+  _inFlight = t_epoch();
+
+  qint64 now = _clock.elapsed();
+  if (now - _lastReport >= _reportInterval) {
+    emit(newMessage("Broadcaster: " + _mountpoint.toLatin1() + " send latency mean "
+                    + QByteArray::number(_sumLatency / _numSent / 1000.0, 'f', 1) + " ms, max "
+                    + QByteArray::number(_maxLatency / 1000.0, 'f', 1) + " ms, "
+                    + QByteArray::number(_numSent) + " epoch(s)", false));
+
+    // Mean stages of the epochs of an epoch-driven caster
+    // ---------------------------------------------------
+    if (_rate == 0) {
+      emit(newMessage("Broadcaster: " + _mountpoint.toLatin1() + " mean epoch stages [ms]"
+                      + " decode " + QByteArray::number(_sumStage[0] / _numSent / 1000.0, 'f', 2)
+                      + " encode " + QByteArray::number(_sumStage[1] / _numSent / 1000.0, 'f', 2)
+                      + " queue "  + QByteArray::number(_sumStage[2] / _numSent / 1000.0, 'f', 2)
+                      + " write "  + QByteArray::number(_sumStage[3] / _numSent / 1000.0, 'f', 2),
+                      false));
+    }
+    _lastReport = now;
+    _numSent    = 0;
+    _sumLatency = 0;
+    _maxLatency = 0;
+    for (int ii = 0; ii < 4; ii++) {
+      _sumStage[ii] = 0;
+    }
   }
 }
 
+// Sleep until a new Epoch is queued (if anyEpoch, also when epochs are
+// waiting already), the thread is to be deleted, or msec have passed
+////////////////////////////////////////////////////////////////////////////
+void bncUploadCaster::waitForEvent(qint64 msec, bool anyEpoch) {
+  QMutexLocker locker(&_mutex);
+  if (_isToBeDeleted || (!anyEpoch && !_queue.isEmpty())) {
+    return;
+  }
+  if (msec < 0) {
+    _waitCond.wait(&_mutex);
+  }
+  else {
+    _waitCond.wait(&_mutex, (unsigned long)(msec));
+  }
+}
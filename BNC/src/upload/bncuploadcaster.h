@@ -2,9 +2,14 @@
 #define BNCUPLOADCASTER_H
 
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QList>
 #include <QMutex>
 #include <QTcpSocket>
 #include <QThread>
+#include <QWaitCondition>
+
+class bncStreamCounters;
 
 class bncUploadCaster : public QThread {
  Q_OBJECT
@@ -15,36 +20,73 @@ class bncUploadCaster : public QThread {
       const QString& userName, const QString& password,
       int iRow, int rate);
   virtual void deleteSafely();
-  void setOutBuffer(const QByteArray& outBuffer) {
-    QMutexLocker locker(&_mutex);
-    _outBuffer = outBuffer;
-  }
+  void setOutBuffer(const QByteArray& outBuffer,
+                    qint64 decodeTime = 0, qint64 encodeTime = 0);
 
  protected:
   virtual    ~bncUploadCaster();
+  void       queueOutBuffer(qint64 decodeTime = 0, qint64 encodeTime = 0);
   QMutex     _mutex;
   QByteArray _outBuffer;
 
  signals:
   void newMessage(const QByteArray msg, bool showOnScreen);
-  void newBytes(QByteArray staID, double nbyte);
 
  private:
+  enum t_state {disconnected, connecting, requesting, streaming};
+
+  // Stage timestamps of an epoch [us] (input = queued - encode - decode)
+  class t_epoch {
+   public:
+    t_epoch() {_decode = 0; _encode = 0; _queued = -1; _written = -1;}
+    QByteArray _data;
+    qint64     _decode;  // duration
+    qint64     _encode;  // duration
+    qint64     _queued;
+    qint64     _written; // handed to the socket
+  };
+
   void         open();
+  void         closeSocket(const QByteArray& reason);
+  void         readReply();
+  void         writeSocket();
+  bool         sendEpoch();
+  void         epochSent();
+  void         waitForEvent(qint64 msec, bool anyEpoch);
+  qint64       usec() const {return _clock.nsecsElapsed() / 1000;}
   virtual void run();
-  bool        _isToBeDeleted;
-  QString     _mountpoint;
-  QString     _outHost;
-  int         _outPort;
-  QString     _userName;
-  QString     _password;
-  QString     _ntripVersion;
-  bool        _secure;
-  QTcpSocket* _outSocket;
-  int         _sOpenTrial;
-  QDateTime   _outSocketOpenTime;
-  int         _iRow;
-  int         _rate;
+
+  static const int _maxQueue       = 10;    // epochs waiting for the caster
+  static const int _waitSlice      = 100;   // [ms] socket waits between checks
+  static const int _timeOut        = 5000;  // [ms] connect and reply
+  static const int _reportInterval = 60000; // [ms]
+
+  bool               _isToBeDeleted;
+  QString            _mountpoint;
+  QString            _outHost;
+  int                _outPort;
+  QString            _userName;
+  QString            _password;
+  QString            _ntripVersion;
+  bool               _secure;
+  QTcpSocket*        _outSocket;
+  int                _sOpenTrial;
+  qint64             _nextOpen;   // [ms] earliest time of the next connect
+  int                _iRow;
+  int                _rate;
+  t_state            _state;
+  qint64             _stateTime;  // [ms] begin of the current state
+  QElapsedTimer      _clock;
+  QWaitCondition     _waitCond;
+  QList<t_epoch>     _queue;
+  int                _numDropped;
+  t_epoch            _inFlight;   // epoch being written
+  bncStreamCounters* _counters;
+  int                _numSent;    // since the last report
+  qint64             _sumLatency; // [us] input to socket
+  qint64             _maxLatency; // [us]
+  qint64             _sumStage[4]; // [us] decode, encode, queue, write
+  qint64             _lastReport;
 };
 
 #endif
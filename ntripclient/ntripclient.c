@@ -47,6 +47,9 @@
   #include <sys/socket.h>
   #include <netinet/in.h>
   #include <netdb.h>
+  #ifdef __linux__
+  #include <sys/epoll.h>
+  #endif
 
   #define closesocket(sock)       close(sock)
   #define ALARMTIME   (2*60)
@@ -91,6 +94,9 @@ struct Args
   enum SerialProtocol protocol;
   const char *serdevice;
   const char *serlogfile;
+  const char *mountlist;
+  const char *outfile;
+  int         interval;
 };
 
 /* option parsing */
@@ -119,10 +125,13 @@ static struct option opts[] = {
 { "parity",     required_argument, 0, 'Y'},
 { "databits",   required_argument, 0, 'A'},
 { "serlogfile", required_argument, 0, 'l'},
+{ "mountlist",  required_argument, 0, 'L'},
+{ "outfile",    required_argument, 0, 'o'},
+{ "interval",   required_argument, 0, 'i'},
 { "help",       no_argument,       0, 'h'},
 {0,0,0,0}};
 #endif
-#define ARGOPT "-d:m:bhp:r:s:u:n:S:R:M:IP:D:B:T:C:Y:A:l:"
+#define ARGOPT "-d:m:bhp:r:s:u:n:S:R:M:IP:D:B:T:C:Y:A:l:L:o:i:"
 
 int stop = 0;
 #ifndef WINDOWSVERSION
@@ -333,6 +342,9 @@ static int getargs(int argc, char **argv, struct Args *args)
   args->baud = SPABAUD_9600;
   args->serdevice = 0;
   args->serlogfile = 0;
+  args->mountlist = 0;
+  args->outfile = "%N_%Y%m%d.raw";
+  args->interval = 60;
   help = 0;
 
   do
@@ -423,6 +435,15 @@ static int getargs(int argc, char **argv, struct Args *args)
       break;
     case 'D': args->serdevice = optarg; break;
     case 'l': args->serlogfile = optarg; break;
+    case 'L': args->mountlist = optarg; break;
+    case 'o': args->outfile = optarg; break;
+    case 'i':
+      if((args->interval = strtol(optarg, 0, 10)) < 1)
+      {
+        fprintf(stderr, "Interval '%s' invalid\n", optarg);
+        res = 0;
+      }
+      break;
     case 'I': args->initudp = 1; break;
     case 'P': args->udpport = strtol(optarg, 0, 10); break;
     case 'n': args->nmea = optarg; break;
@@ -464,6 +485,20 @@ static int getargs(int argc, char **argv, struct Args *args)
     }
   } while(getoptr != -1 && res);
 
+  if(res && args->mountlist)
+  {
+#ifdef __linux__
+    if(args->mode == RTSP || args->mode == UDP || args->serdevice)
+    {
+      fprintf(stderr, "Option -L needs TCP mode and file output\n");
+      res = 0;
+    }
+#else
+    fprintf(stderr, "Option -L is only available on Linux\n");
+    res = 0;
+#endif
+  }
+
   for(a = revisionstr+11; *a && *a != ' '; ++a)
     revisionstr[i++] = *a;
   revisionstr[i] = 0;
@@ -509,6 +544,11 @@ static int getargs(int argc, char **argv, struct Args *args)
     " -Y " LONG_OPT("--parity     ") "parity for serial device\n"
     " -A " LONG_OPT("--databits   ") "databits for serial device\n"
     " -l " LONG_OPT("--serlogfile ") "logfile for serial data\n"
+    "\nMultiple streams (one file each):\n"
+    " -L " LONG_OPT("--mountlist  ") "comma separated mountpoints or sourcetable filter\n"
+    " -o " LONG_OPT("--outfile    ") "output file name, %%N = mountpoint, strftime fields (UTC)\n"
+    "     for rotation (default %%N_%%Y%%m%%d.raw)\n"
+    " -i " LONG_OPT("--interval   ") "seconds between status lines (default 60)\n"
     , revisionstr, datestr, argv[0], argv[0]);
     exit(1);
   }
@@ -564,6 +604,614 @@ static int encode(char *buf, int size, const char *user, const char *pwd)
   return bytes;
 }
 
+#ifdef __linux__
+/* multi stream mode: many mountpoints of one caster in a single epoll
+   loop, each stream with its own output file and reconnect delay */
+#define MULTI_MAXEVENTS 64
+#define MULTI_MAXNAME   128
+
+enum MULTISTATE { MS_IDLE = 0, MS_CONNECTING, MS_REQUESTING, MS_STREAMING };
+
+struct multistream
+{
+  char            mount[MULTI_MAXNAME];
+  sockettype      fd;
+  enum MULTISTATE state;
+  time_t          retry;      /* time of the next connection attempt */
+  time_t          activity;   /* time of the last state change or data */
+  int             delay;      /* reconnect delay in seconds */
+  char            head[MAXDATASIZE];
+  int             headlen;
+  int             chunkymode;
+  int             chunksize;
+  FILE           *file;
+  char            filename[1024];
+  time_t          checked;    /* time of the last file name check */
+  long            bytes;      /* bytes received since the last status line */
+  int             reconnects; /* since the last status line */
+};
+
+static struct multistream *multi = 0;
+static int                 nmulti = 0;
+static int                 multi_epoll = -1;
+static struct sockaddr_in  multi_addr;
+static char                multi_proxy[300]; /* URL prefix for proxy requests */
+
+static void multi_close(struct multistream *c, const char *reason);
+
+/* resolve the caster (or proxy) address, returns 0 on error */
+static int multi_resolve(struct Args *args)
+{
+  const char *server = args->proxyhost ? args->proxyhost : args->server;
+  const char *port = args->proxyhost ? args->proxyport : args->port;
+  struct hostent *he;
+  struct servent *se;
+  char *b;
+  long i;
+
+  memset(&multi_addr, 0, sizeof(multi_addr));
+  multi_addr.sin_family = AF_INET;
+  if((i = strtol(port, &b, 10)) && (!b || !*b))
+    multi_addr.sin_port = htons(i);
+  else if(!(se = getservbyname(port, 0)))
+  {
+    fprintf(stderr, "Can't resolve port %s.\n", port);
+    return 0;
+  }
+  else
+    multi_addr.sin_port = se->s_port;
+  if(!(he = gethostbyname(server)))
+  {
+    fprintf(stderr, "Server name lookup failed for '%s'.\n", server);
+    return 0;
+  }
+  multi_addr.sin_addr = *((struct in_addr *)he->h_addr);
+
+  multi_proxy[0] = 0;
+  if(args->proxyhost)
+  {
+    int p = strtol(args->port, &b, 10);
+    if(!p || (b && *b))
+    {
+      if(!(se = getservbyname(args->port, 0)))
+      {
+        fprintf(stderr, "Can't resolve port %s.\n", args->port);
+        return 0;
+      }
+      p = ntohs(se->s_port);
+    }
+    snprintf(multi_proxy, sizeof(multi_proxy), "http://%s:%d", args->server, p);
+  }
+  return 1;
+}
+
+static int multi_add(const char *mount)
+{
+  struct multistream *c;
+  int i;
+
+  for(i = 0; i < nmulti; ++i)
+  {
+    if(!strcmp(multi[i].mount, mount))
+      return 1;
+  }
+  if(!*mount || strlen(mount) >= MULTI_MAXNAME)
+  {
+    fprintf(stderr, "Invalid mountpoint '%s'\n", mount);
+    return 0;
+  }
+  if(!(c = realloc(multi, (nmulti+1)*sizeof(*multi))))
+  {
+    fprintf(stderr, "Out of memory\n");
+    return 0;
+  }
+  multi = c;
+  c = multi + nmulti++;
+  memset(c, 0, sizeof(*c));
+  strcpy(c->mount, mount);
+  c->fd = -1;
+  c->delay = 1;
+  return 1;
+}
+
+/* read the mountpoints of the STR records from a (filtered) sourcetable,
+   returns 0 on error */
+static int multi_sourcetable(struct Args *args, const char *filter)
+{
+  char buf[MAXDATASIZE];
+  char line[MAXDATASIZE];
+  int linelen = 0, ok = 1, i, n;
+  sockettype sockfd;
+
+  if((sockfd = socket(AF_INET, SOCK_STREAM, 0)) == -1
+  || connect(sockfd, (struct sockaddr *)&multi_addr, sizeof(multi_addr)) == -1)
+  {
+    myperror("sourcetable");
+    if(sockfd != -1)
+      closesocket(sockfd);
+    return 0;
+  }
+  i = snprintf(buf, sizeof(buf),
+  "GET %s/%s HTTP/1.1\r\n"
+  "Host: %s\r\n%s"
+  "User-Agent: %s/%s\r\n"
+  "Connection: close\r\n"
+  "\r\n", multi_proxy, filter[1] ? encodeurl(filter) : "", args->server,
+  args->mode == NTRIP1 ? "" : "Ntrip-Version: Ntrip/2.0\r\n",
+  AGENTSTRING, revisionstr);
+  if(i >= (int)sizeof(buf) || i < 0 || send(sockfd, buf, (size_t)i, 0) != i)
+  {
+    fprintf(stderr, "Could not request the sourcetable\n");
+    closesocket(sockfd);
+    return 0;
+  }
+  /* line based, so chunked transfer lines are skipped like other noise */
+  while(ok && (n = recv(sockfd, buf, sizeof(buf), 0)) > 0)
+  {
+    for(i = 0; ok && i < n; ++i)
+    {
+      if(buf[i] != '\n')
+      {
+        if(linelen < (int)sizeof(line)-1)
+          line[linelen++] = buf[i];
+        continue;
+      }
+      line[linelen] = 0;
+      linelen = 0;
+      if(!strncmp(line, "STR;", 4))
+      {
+        char *e = strchr(line+4, ';');
+        if(e)
+        {
+          *e = 0;
+          ok = multi_add(line+4);
+        }
+      }
+    }
+  }
+  closesocket(sockfd);
+  return ok;
+}
+
+/* expand the output file pattern: %N is the mountpoint, the other
+   fields are those of strftime() in UTC */
+static void multi_filename(const char *pattern, const char *mount,
+time_t t, char *name, size_t size)
+{
+  char format[1024];
+  size_t i = 0;
+  struct tm *tm;
+
+  while(*pattern && i < sizeof(format)-1)
+  {
+    if(pattern[0] == '%' && pattern[1] == 'N')
+    {
+      const char *m;
+      for(m = mount; *m && i < sizeof(format)-1; ++m)
+      {
+        if(*m != '%') format[i++] = *m;
+      }
+      pattern += 2;
+    }
+    else if(pattern[0] == '%' && pattern[1])
+    {
+      if(i < sizeof(format)-2)
+      {
+        format[i++] = *pattern++;
+        format[i++] = *pattern++;
+      }
+      else
+        break;
+    }
+    else
+      format[i++] = *pattern++;
+  }
+  format[i] = 0;
+  tm = gmtime(&t);
+  if(!strftime(name, size, format, tm))
+    *name = 0;
+}
+
+/* write stream data, the output file is rotated when its name changes */
+static void multi_write(struct multistream *c, struct Args *args,
+const char *data, int size)
+{
+  time_t t = time(0);
+
+  if(t != c->checked || !c->file)
+  {
+    char name[sizeof(c->filename)];
+
+    c->checked = t;
+    multi_filename(args->outfile, c->mount, t, name, sizeof(name));
+    if(!c->file || strcmp(name, c->filename))
+    {
+      if(c->file)
+        fclose(c->file);
+      strcpy(c->filename, name);
+      if(!(c->file = fopen(c->filename, "ab")))
+      {
+        fprintf(stderr, "%s: Could not open output file '%s'\n", c->mount,
+        c->filename);
+        multi_close(c, "output failed");
+        return;
+      }
+    }
+  }
+  fwrite(data, (size_t)size, 1, c->file);
+  c->bytes += size;
+}
+
+static void multi_watch(struct multistream *c, int op)
+{
+  struct epoll_event ev;
+
+  memset(&ev, 0, sizeof(ev));
+  ev.events = c->state == MS_CONNECTING ? EPOLLOUT : EPOLLIN;
+  ev.data.u32 = (uint32_t)(c - multi);
+  if(epoll_ctl(multi_epoll, op, c->fd, &ev) == -1)
+    multi_close(c, strerror(errno));
+}
+
+static void multi_close(struct multistream *c, const char *reason)
+{
+  if(c->fd != -1)
+  {
+    epoll_ctl(multi_epoll, EPOLL_CTL_DEL, c->fd, 0);
+    closesocket(c->fd);
+    c->fd = -1;
+  }
+  if(c->file)
+    fflush(c->file);
+  c->state = MS_IDLE;
+  c->retry = time(0) + c->delay;
+  ++c->reconnects;
+  fprintf(stderr, "%s: %s, reconnect in %d seconds\n", c->mount, reason,
+  c->delay);
+  /* same backoff as the single stream mode, but limited */
+  c->delay += 2;
+  if(c->delay > ALARMTIME) c->delay = ALARMTIME;
+}
+
+static void multi_connect(struct multistream *c)
+{
+  c->activity = time(0);
+  c->headlen = 0;
+  c->chunkymode = 0;
+  if((c->fd = socket(AF_INET, SOCK_STREAM, 0)) == -1)
+  {
+    multi_close(c, "socket failed");
+    return;
+  }
+  fcntl(c->fd, F_SETFL, O_NONBLOCK);
+  if(connect(c->fd, (struct sockaddr *)&multi_addr, sizeof(multi_addr)) == -1
+  && errno != EINPROGRESS)
+  {
+    multi_close(c, strerror(errno));
+    return;
+  }
+  c->state = MS_CONNECTING;
+  multi_watch(c, EPOLL_CTL_ADD);
+}
+
+static void multi_request(struct multistream *c, struct Args *args)
+{
+  const char *nmeahead = (args->nmea && args->mode == HTTP) ? args->nmea : 0;
+  char buf[MAXDATASIZE];
+  int err = 0, i;
+  socklen_t len = sizeof(err);
+
+  if(getsockopt(c->fd, SOL_SOCKET, SO_ERROR, &err, &len) == -1)
+    err = errno;
+  if(err)
+  {
+    multi_close(c, strerror(err));
+    return;
+  }
+  i = snprintf(buf, MAXDATASIZE-40, /* leave some space for login */
+  "GET %s/%s HTTP/1.1\r\n"
+  "Host: %s\r\n%s"
+  "User-Agent: %s/%s\r\n"
+  "%s%s%s"
+  "Connection: close%s"
+  , multi_proxy, c->mount, args->server,
+  args->mode == NTRIP1 ? "" : "Ntrip-Version: Ntrip/2.0\r\n",
+  AGENTSTRING, revisionstr,
+  nmeahead ? "Ntrip-GGA: " : "", nmeahead ? nmeahead : "",
+  nmeahead ? "\r\n" : "",
+  (*args->user || *args->password) ? "\r\nAuthorization: Basic " : "");
+  if(i > MAXDATASIZE-40 || i < 0)
+    i = -1;
+  else
+  {
+    i += encode(buf+i, MAXDATASIZE-i-4, args->user, args->password);
+    if(i > MAXDATASIZE-4)
+      i = -1;
+    else
+    {
+      buf[i++] = '\r';
+      buf[i++] = '\n';
+      buf[i++] = '\r';
+      buf[i++] = '\n';
+      if(args->nmea && !nmeahead)
+      {
+        int j = snprintf(buf+i, MAXDATASIZE-i, "%s\r\n", args->nmea);
+        i = (j >= 0 && j < MAXDATASIZE-i) ? i+j : -1;
+      }
+    }
+  }
+  /* the request fits into the empty send buffer of the new socket */
+  if(i < 0 || send(c->fd, buf, (size_t)i, MSG_NOSIGNAL) != i)
+  {
+    multi_close(c, "Could not send request");
+    return;
+  }
+  c->state = MS_REQUESTING;
+  c->activity = time(0);
+  multi_watch(c, EPOLL_CTL_MOD);
+}
+
+/* stream data, dechunked like in the single stream mode */
+static void multi_data(struct multistream *c, struct Args *args,
+const char *buf, int numbytes)
+{
+  int pos = 0, i;
+
+  c->activity = time(0);
+  c->delay = 1;
+  if(!c->chunkymode)
+  {
+    multi_write(c, args, buf, numbytes);
+    return;
+  }
+  while(c->state == MS_STREAMING && pos < numbytes)
+  {
+    switch(c->chunkymode)
+    {
+    case 1: /* reading number starts */
+      c->chunksize = 0;
+      ++c->chunkymode; /* fall through */
+    case 2: /* during reading number */
+      i = buf[pos++];
+      if(i >= '0' && i <= '9') c->chunksize = c->chunksize*16+i-'0';
+      else if(i >= 'a' && i <= 'f') c->chunksize = c->chunksize*16+i-'a'+10;
+      else if(i >= 'A' && i <= 'F') c->chunksize = c->chunksize*16+i-'A'+10;
+      else if(i == '\r') ++c->chunkymode;
+      else if(i == ';') c->chunkymode = 5;
+      else multi_close(c, "Error in chunky transfer encoding");
+      break;
+    case 3: /* scanning for return */
+      if(buf[pos++] == '\n') c->chunkymode = c->chunksize ? 4 : 1;
+      else multi_close(c, "Error in chunky transfer encoding");
+      break;
+    case 4: /* output data */
+      i = numbytes-pos;
+      if(i > c->chunksize) i = c->chunksize;
+      multi_write(c, args, buf+pos, i);
+      c->chunksize -= i;
+      pos += i;
+      if(!c->chunksize)
+        c->chunkymode = 1;
+      break;
+    case 5: /* chunk extension */
+      if(buf[pos++] == '\r') c->chunkymode = 3;
+      break;
+    }
+  }
+}
+
+/* check the caster's reply header */
+static void multi_reply(struct multistream *c, struct Args *args)
+{
+  char *ep;
+  int n;
+
+  n = recv(c->fd, c->head+c->headlen, sizeof(c->head)-1-c->headlen, 0);
+  if(n < 0 && (errno == EAGAIN || errno == EINTR))
+    return;
+  if(n <= 0)
+  {
+    multi_close(c, "Connection closed by caster");
+    return;
+  }
+  c->headlen += n;
+  c->head[c->headlen] = 0;
+
+  if(!strncmp(c->head, "ICY 200 OK", 10))
+  {
+    if(!(ep = strstr(c->head, "\r\n")))
+      return;
+    ep += 2;
+  }
+  else if(!strncmp(c->head, "HTTP/1.1 200 OK\r\n", 17)
+  || !strncmp(c->head, "HTTP/1.0 200 OK\r\n", 17))
+  {
+    if(!(ep = strstr(c->head, "\r\n\r\n")))
+    {
+      if(c->headlen == (int)sizeof(c->head)-1)
+        multi_close(c, "Reply header too long");
+      return;
+    }
+    ep[2] = 0; /* end of the header for strstr */
+    if(!strstr(c->head, "Content-Type: gnss/data\r\n"))
+    {
+      multi_close(c, "No 'Content-Type: gnss/data' found");
+      return;
+    }
+    c->chunkymode = strstr(c->head, "Transfer-Encoding: chunked\r\n") ? 1 : 0;
+    ep += 4;
+  }
+  else if(c->headlen >= 17 || strchr(c->head, '\n'))
+  {
+    char *a;
+    fprintf(stderr, "%s: Could not get the requested data: ", c->mount);
+    for(a = c->head; *a && *a != '\n' && *a != '\r'; ++a)
+      fprintf(stderr, "%c", isprint(*a) ? *a : '.');
+    fprintf(stderr, "\n");
+    multi_close(c, "request rejected");
+    return;
+  }
+  else
+    return; /* wait for more of the reply */
+  c->state = MS_STREAMING;
+  fprintf(stderr, "%s: connected\n", c->mount);
+  if(ep < c->head+c->headlen)
+    multi_data(c, args, ep, c->head+c->headlen-ep);
+}
+
+static void multi_status(time_t t, int interval)
+{
+  char line[300];
+  char date[40];
+  long bytes = 0;
+  int i, up = 0, reconnects = 0, len;
+
+  strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", gmtime(&t));
+  len = snprintf(line, sizeof(line), " down:");
+  for(i = 0; i < nmulti; ++i)
+  {
+    struct multistream *c = multi+i;
+    bytes += c->bytes;
+    reconnects += c->reconnects;
+    c->bytes = 0;
+    c->reconnects = 0;
+    if(c->file)
+      fflush(c->file);
+    if(c->state == MS_STREAMING)
+      ++up;
+    else if(len < (int)sizeof(line))
+      len += snprintf(line+len, sizeof(line)-len, " %s", c->mount);
+  }
+  if(len >= (int)sizeof(line))
+    strcpy(line+sizeof(line)-5, " ...");
+  fprintf(stderr, "%s: %d/%d streams up, %ld byte/s, %d reconnects%s\n",
+  date, up, nmulti, bytes/interval, reconnects, up < nmulti ? line : "");
+}
+
+static int multi_client(struct Args *args)
+{
+  struct epoll_event events[MULTI_MAXEVENTS];
+  time_t laststatus;
+  int i, n;
+
+  if(!multi_resolve(args))
+    return 20;
+  if(*args->mountlist == '?')
+  {
+    if(!multi_sourcetable(args, args->mountlist))
+      return 20;
+  }
+  else
+  {
+    char list[MAXDATASIZE];
+    char *m;
+    if(strlen(args->mountlist) >= sizeof(list))
+    {
+      fprintf(stderr, "Mountpoint list too long\n");
+      return 20;
+    }
+    strcpy(list, args->mountlist);
+    for(m = strtok(list, ", "); m; m = strtok(0, ", "))
+    {
+      if(!multi_add(m))
+        return 20;
+    }
+  }
+  if(!nmulti)
+  {
+    fprintf(stderr, "No mountpoints to request\n");
+    return 20;
+  }
+  if((multi_epoll = epoll_create(nmulti)) == -1)
+  {
+    myperror("epoll_create");
+    return 20;
+  }
+  /* every stream has its own timeout */
+  alarm(0);
+  fprintf(stderr, "Requesting %d streams\n", nmulti);
+
+  laststatus = time(0);
+  while(!stop)
+  {
+    time_t t = time(0);
+    long timeout;
+
+    if(t >= laststatus + args->interval)
+    {
+      multi_status(t, t-laststatus);
+      laststatus = t;
+      /* the caster address may have changed */
+      for(i = 0; i < nmulti && multi[i].state == MS_STREAMING; ++i)
+        ;
+      if(i < nmulti)
+        multi_resolve(args);
+    }
+    timeout = laststatus + args->interval - t;
+    for(i = 0; i < nmulti; ++i)
+    {
+      struct multistream *c = multi+i;
+      time_t due;
+
+      if(c->state == MS_IDLE && c->retry <= t)
+        multi_connect(c);
+      else if(c->state != MS_IDLE && t - c->activity >= ALARMTIME)
+        multi_close(c, c->state == MS_STREAMING ? "no data" : "timeout");
+      due = c->state == MS_IDLE ? c->retry : c->activity + ALARMTIME;
+      if(due - t < timeout)
+        timeout = due > t ? due - t : 0;
+    }
+
+    n = epoll_wait(multi_epoll, events, MULTI_MAXEVENTS, (int)timeout*1000);
+    if(n == -1 && errno != EINTR)
+    {
+      myperror("epoll_wait");
+      break;
+    }
+    for(i = 0; i < n; ++i)
+    {
+      struct multistream *c = multi+events[i].data.u32;
+      char buf[MAXDATASIZE];
+      int numbytes;
+
+      if(c->fd == -1) /* closed while handling this event batch */
+        continue;
+      switch(c->state)
+      {
+      case MS_CONNECTING:
+        multi_request(c, args);
+        break;
+      case MS_REQUESTING:
+        multi_reply(c, args);
+        break;
+      case MS_STREAMING:
+        numbytes = recv(c->fd, buf, sizeof(buf), 0);
+        if(numbytes > 0)
+          multi_data(c, args, buf, numbytes);
+        else if(!numbytes)
+          multi_close(c, "Connection closed by caster");
+        else if(errno != EAGAIN && errno != EINTR)
+          multi_close(c, strerror(errno));
+        break;
+      case MS_IDLE:
+        break;
+      }
+    }
+  }
+
+  for(i = 0; i < nmulti; ++i)
+  {
+    if(multi[i].fd != -1)
+      closesocket(multi[i].fd);
+    if(multi[i].file)
+      fclose(multi[i].file);
+  }
+  free(multi);
+  close(multi_epoll);
+  return 0;
+}
+#endif /* __linux__ */
+
 int main(int argc, char **argv)
 {
   struct Args args;
@@ -592,6 +1240,10 @@ int main(int argc, char **argv)
     size_t nmeabufpos = 0;
     size_t nmeastarpos = 0;
     int sleeptime = 0;
+#ifdef __linux__
+    if(args.mountlist)
+      return multi_client(&args);
+#endif
     if(args.serdevice)
     {
       const char *e = SerialInit(&sx, args.serdevice, args.baud,
@@ -68,6 +68,9 @@ static char datestr[]     = "$Date: 2010/01/21 09:00:49 $";
   #include <netinet/in.h>
   #include <netdb.h>
   #include <sys/termios.h>
+  #ifdef __linux__
+  #include <sys/epoll.h>
+  #endif
   #define closesocket(sock) close(sock)
   #define INVALID_HANDLE_VALUE -1
   #define INVALID_SOCKET -1
@@ -155,6 +158,9 @@ static void handle_alarm(int sig);
 #else
 static HANDLE openserial(const char * tty, int baud);
 #endif
+#ifdef __linux__
+static int  multi_server(const char *configfile, int reconnect_max);
+#endif
 
 
 /*
@@ -234,6 +240,7 @@ int main(int argc, char **argv)
   char *             tok_buf[BUFSZ];
 
   int                reconnect_sec_max = 0;
+  const char *       configfile = 0;
 
   setbuf(stdout, 0);
   setbuf(stdin, 0);
@@ -282,7 +289,7 @@ int main(int argc, char **argv)
     exit(1);
   }
   while((c = getopt(argc, argv,
-  "M:i:h:b:p:s:a:m:c:H:P:f:x:y:l:u:V:D:U:W:O:E:F:R:N:n:B")) != EOF)
+  "M:i:h:b:p:s:a:m:c:H:P:f:x:y:l:u:V:D:U:W:O:E:F:R:N:n:BC:")) != EOF)
   {
     switch (c)
     {
@@ -392,6 +399,9 @@ int main(int argc, char **argv)
     case 'R':  /* maximum delay between reconnect attempts in seconds */
        reconnect_sec_max = atoi(optarg);
        break;
+    case 'C': /* configuration file of the multi stream mode */
+      configfile = optarg;
+      break;
     case 'O': /* OutputMode */
       outputmode = 0;
       if (!strcmp(optarg,"n") || !strcmp(optarg,"ntrip1"))
@@ -449,6 +459,16 @@ int main(int argc, char **argv)
     reconnect_sec_max = 256;
   }
 
+  if(configfile)
+  {
+#ifdef __linux__
+    return multi_server(configfile, reconnect_sec_max);
+#else
+    fprintf(stderr, "ERROR: option -C is only available on Linux\n");
+    exit(1);
+#endif
+  }
+
   if(!mountpoint)
   {
     fprintf(stderr, "ERROR: Missing mountpoint argument for stream upload\n");
@@ -1724,6 +1744,671 @@ socklen_t length, unsigned int rtpssrc)
 }
 
 
+#ifdef __linux__
+/********************************************************************
+ * multi stream mode                                                *
+ *                                                                  *
+ * One process serves all source/destination pairs of a             *
+ * configuration file. The connections are non-blocking and served  *
+ * by a single epoll loop, each with its own state and reconnect    *
+ * delay, so a failing pair never holds up the others. The data of  *
+ * a source are fanned out to all its destinations; a destination   *
+ * which can't keep up loses data instead of delaying the source.   *
+*********************************************************************/
+#define MULTI_READSZ    4096
+#define MULTI_OUTBUFSZ  (64*1024)
+#define MULTI_MAXEVENTS 64
+
+enum MULTISTATE { MS_IDLE = 0, MS_CONNECTING, MS_REQUESTING, MS_STREAMING };
+
+struct multiconn
+{
+  int             isdest;
+  int             mode;       /* source: enum MODE, destination: enum OUTMODE */
+  int             src;        /* destination: index of its source */
+  char            name[4*SZ];
+  char            host[SZ];   /* host name or serial device */
+  unsigned int    port;       /* port or baud rate */
+  char            mount[SZ];
+  char            auth[SZ];   /* base64 login, NTRIP 1.0 destination: password */
+  sockettype      fd;
+  enum MULTISTATE state;
+  time_t          retry;      /* time of the next connection attempt */
+  time_t          activity;   /* time of the last state change or input */
+  int             delay;      /* current reconnect delay in seconds */
+  int             watchout;   /* EPOLLOUT registered */
+  char            reply[BUFSZ];
+  int             replylen;
+  char *          out;        /* destination: data not yet sent */
+  int             outlen;
+  long            dropped;
+};
+
+static struct multiconn * multi = 0;
+static int                nmulti = 0;
+static int                multi_epoll = -1;
+static int                multi_delay_max = 256;
+
+static void multi_close(struct multiconn *c, const char *reason);
+
+
+/********************************************************************
+ * multi_copy: copy a configuration value, returns 0 if too long    *
+*********************************************************************/
+static int multi_copy(char *dst, const char *src, size_t size)
+{
+  if(strlen(src) >= size)
+    return 0;
+  strcpy(dst, src);
+  return 1;
+} /* multi_copy */
+
+
+/*
+* multi_config
+*
+* Reads the configuration file of the multi stream mode. Each line
+* defines a source or one destination of a previously defined source:
+*
+*   source <Name> tcpsocket <Host> <Port>
+*   source <Name> udpsocket <Port>
+*   source <Name> serial <Device> <BaudRate>
+*   source <Name> caster <Host> <Port> <Mountpoint> [<User> <Password>]
+*   dest <Name> ntrip1 <Host> <Port> <Mountpoint> <Password>
+*   dest <Name> http <Host> <Port> <Mountpoint> <User> <Password>
+*
+* Empty lines and lines starting with '#' are ignored.
+*
+* Parameters:
+*     file : pointer to char : Name of the configuration file.
+*
+* Return Value:
+*     The function returns 1 if successful and 0 in the event of an error.
+*/
+static int multi_config(const char *file)
+{
+  FILE *fh;
+  char  line[BUFSZ];
+  int   lineno = 0;
+  int   i, ok = 1;
+
+  if(!(fh = fopen(file, "r")))
+  {
+    fprintf(stderr, "ERROR: can't open configuration file %s\n", file);
+    return 0;
+  }
+  while(ok && fgets(line, sizeof(line), fh))
+  {
+    struct multiconn *c;
+    char  name[4*SZ];
+    char *tok[9];
+    char *a;
+    int   ntok = 0;
+
+    ++lineno;
+    for(a = strtok(line, " \t\r\n"); a && ntok < 9; a = strtok(0, " \t\r\n"))
+      tok[ntok++] = a;
+    if(!ntok || tok[0][0] == '#')
+      continue;
+
+    if(!(c = realloc(multi, (nmulti+1)*sizeof(*multi))))
+    {
+      fprintf(stderr, "ERROR: out of memory\n");
+      ok = 0;
+      break;
+    }
+    multi = c;
+    c = multi + nmulti;
+    memset(c, 0, sizeof(*c));
+    c->fd = INVALID_SOCKET;
+    c->src = -1;
+    c->delay = 1;
+
+    ok = 0;
+    if(ntok >= 3 && !strcmp(tok[0], "source"))
+    {
+      for(i = 0; i < nmulti; ++i)
+      {
+        if(!multi[i].isdest && !strcmp(multi[i].name, tok[1]))
+          break;
+      }
+      if(i < nmulti)
+        fprintf(stderr, "ERROR: %s:%d: source %s defined twice\n", file,
+        lineno, tok[1]);
+      else if(!multi_copy(c->name, tok[1], SZ))
+        ;
+      else if(!strcmp(tok[2], "tcpsocket") && ntok == 5)
+      {
+        c->mode = TCPSOCKET;
+        ok = multi_copy(c->host, tok[3], sizeof(c->host));
+        c->port = atoi(tok[4]);
+      }
+      else if(!strcmp(tok[2], "udpsocket") && ntok == 4)
+      {
+        c->mode = UDPSOCKET;
+        c->port = atoi(tok[3]);
+        ok = 1;
+      }
+      else if(!strcmp(tok[2], "serial") && ntok == 5)
+      {
+        c->mode = SERIAL;
+        ok = multi_copy(c->host, tok[3], sizeof(c->host));
+        c->port = atoi(tok[4]);
+      }
+      else if(!strcmp(tok[2], "caster") && (ntok == 6 || ntok == 8))
+      {
+        c->mode = CASTER;
+        ok = multi_copy(c->host, tok[3], sizeof(c->host))
+          && multi_copy(c->mount, tok[5], sizeof(c->mount))
+          && (ntok == 6
+          || encode(c->auth, sizeof(c->auth), tok[6], tok[7]) < (int)sizeof(c->auth));
+        c->port = atoi(tok[4]);
+      }
+    }
+    else if(ntok >= 3 && !strcmp(tok[0], "dest"))
+    {
+      c->isdest = 1;
+      for(i = 0; i < nmulti; ++i)
+      {
+        if(!multi[i].isdest && !strcmp(multi[i].name, tok[1]))
+          break;
+      }
+      if(i == nmulti)
+        fprintf(stderr, "ERROR: %s:%d: source %s not defined\n", file,
+        lineno, tok[1]);
+      else if(!strcmp(tok[2], "ntrip1") && ntok == 7)
+      {
+        c->mode = NTRIP1;
+        ok = multi_copy(c->auth, tok[6], sizeof(c->auth));
+      }
+      else if(!strcmp(tok[2], "http") && ntok == 8)
+      {
+        c->mode = HTTP;
+        ok = encode(c->auth, sizeof(c->auth), tok[6], tok[7]) < (int)sizeof(c->auth);
+      }
+      if(c->mode)
+      {
+        c->src = i;
+        c->port = atoi(tok[4]);
+        ok = ok && multi_copy(c->host, tok[3], sizeof(c->host))
+          && multi_copy(c->mount, tok[5], sizeof(c->mount));
+        snprintf(name, sizeof(name), "%.63s -> %.63s:%u/%.63s", multi[i].name,
+        c->host, c->port, c->mount);
+        strcpy(c->name, name);
+        if(ok && !(c->out = malloc(MULTI_OUTBUFSZ)))
+        {
+          fprintf(stderr, "ERROR: out of memory\n");
+          ok = 0;
+        }
+      }
+    }
+    if(!ok)
+      fprintf(stderr, "ERROR: %s:%d: invalid or too long entry\n", file, lineno);
+    else
+      ++nmulti;
+  }
+  fclose(fh);
+
+  for(i = 0; ok && i < nmulti; ++i)
+  {
+    int j;
+    if(multi[i].isdest)
+      continue;
+    for(j = i+1; j < nmulti && multi[j].src != i; ++j)
+      ;
+    if(j == nmulti)
+      fprintf(stderr, "WARNING: source %s has no destination\n", multi[i].name);
+  }
+  if(ok && !nmulti)
+  {
+    fprintf(stderr, "ERROR: %s defines no streams\n", file);
+    ok = 0;
+  }
+  return ok;
+} /* multi_config */
+
+
+/********************************************************************
+ * multi_watch: register the events of interest of a connection     *
+*********************************************************************/
+static void multi_watch(struct multiconn *c, int op)
+{
+  struct epoll_event ev;
+
+  memset(&ev, 0, sizeof(ev));
+  c->watchout = c->state == MS_CONNECTING || c->outlen > 0;
+  ev.events = c->state == MS_CONNECTING ? EPOLLOUT
+            : EPOLLIN | (c->watchout ? EPOLLOUT : 0);
+  ev.data.u32 = (uint32_t)(c - multi);
+  if(epoll_ctl(multi_epoll, op, c->fd, &ev) < 0)
+    multi_close(c, strerror(errno));
+} /* multi_watch */
+
+
+/********************************************************************
+ * multi_close: close a connection and schedule the next attempt    *
+*********************************************************************/
+static void multi_close(struct multiconn *c, const char *reason)
+{
+  if(c->fd != INVALID_SOCKET)
+  {
+    epoll_ctl(multi_epoll, EPOLL_CTL_DEL, c->fd, 0);
+    closesocket(c->fd);
+    c->fd = INVALID_SOCKET;
+  }
+  c->state = MS_IDLE;
+  c->outlen = 0;
+  c->retry = time(0) + c->delay;
+  fprintf(stderr, "WARNING: %s: %s, reconnect in <%d> seconds\n", c->name,
+  reason, c->delay);
+  c->delay *= 2;
+  if(c->delay > multi_delay_max) c->delay = multi_delay_max;
+} /* multi_close */
+
+
+/********************************************************************
+ * multi_request: send the request of a connected stream            *
+*********************************************************************/
+static void multi_request(struct multiconn *c)
+{
+  char buf[BUFSZ];
+  int  err = 0, n = 0;
+  socklen_t len = sizeof(err);
+
+  if(getsockopt(c->fd, SOL_SOCKET, SO_ERROR, &err, &len) < 0)
+    err = errno;
+  if(err)
+  {
+    multi_close(c, strerror(err));
+    return;
+  }
+
+  c->activity = time(0);
+  c->replylen = 0;
+  if(!c->isdest && c->mode == TCPSOCKET)
+  {
+    c->state = MS_STREAMING;
+    fprintf(stderr, "%s: connected\n", c->name);
+    multi_watch(c, EPOLL_CTL_MOD);
+    return;
+  }
+  else if(!c->isdest)
+    n = snprintf(buf, sizeof(buf),
+      "GET /%s HTTP/1.0\r\n"
+      "User-Agent: %s/%s\r\n"
+      "Connection: close\r\n"
+      "%s%s%s"
+      "\r\n", c->mount, AGENTSTRING, revisionstr,
+      c->auth[0] ? "Authorization: Basic " : "", c->auth,
+      c->auth[0] ? "\r\n" : "");
+  else if(c->mode == NTRIP1)
+    n = snprintf(buf, sizeof(buf),
+      "SOURCE %s /%s\r\n"
+      "Source-Agent: %s/%s\r\n\r\n",
+      c->auth, c->mount, AGENTSTRING, revisionstr);
+  else
+    n = snprintf(buf, sizeof(buf),
+      "POST /%s HTTP/1.1\r\n"
+      "Host: %s\r\n"
+      "Ntrip-Version: Ntrip/2.0\r\n"
+      "User-Agent: %s/%s\r\n"
+      "Authorization: Basic %s\r\n"
+      "Connection: close\r\n"
+      "Transfer-Encoding: chunked\r\n\r\n",
+      c->mount, c->host, AGENTSTRING, revisionstr, c->auth);
+
+  /* the request fits into the empty send buffer of the new socket */
+  if(n >= (int)sizeof(buf) || n < 0
+  || send(c->fd, buf, (size_t)n, MSG_NOSIGNAL) != n)
+  {
+    multi_close(c, "could not send request");
+    return;
+  }
+  c->state = MS_REQUESTING;
+  multi_watch(c, EPOLL_CTL_MOD);
+} /* multi_request */
+
+
+/********************************************************************
+ * multi_connect: start a connection attempt                        *
+*********************************************************************/
+static void multi_connect(struct multiconn *c)
+{
+  struct sockaddr_in addr;
+  struct hostent *   he;
+
+  c->activity = time(0);
+  c->outlen = 0;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(c->port);
+
+  if(!c->isdest && c->mode == SERIAL)
+  {
+    if((c->fd = openserial(c->host, 1, c->port)) == INVALID_HANDLE_VALUE)
+    {
+      if(gps_serial != INVALID_HANDLE_VALUE)
+        close(gps_serial);
+      gps_serial = INVALID_HANDLE_VALUE;
+      multi_close(c, "can't open serial port");
+      return;
+    }
+    gps_serial = INVALID_HANDLE_VALUE;
+    fcntl(c->fd, F_SETFL, O_NONBLOCK);
+    c->state = MS_STREAMING;
+    multi_watch(c, EPOLL_CTL_ADD);
+    return;
+  }
+
+  if((c->fd = socket(AF_INET, !c->isdest && c->mode == UDPSOCKET
+  ? SOCK_DGRAM : SOCK_STREAM, 0)) == INVALID_SOCKET)
+  {
+    multi_close(c, "can't create socket");
+    return;
+  }
+  fcntl(c->fd, F_SETFL, O_NONBLOCK);
+
+  if(!c->isdest && c->mode == UDPSOCKET)
+  {
+    if(bind(c->fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+      multi_close(c, "can't bind input port");
+      return;
+    }
+    c->state = MS_STREAMING;
+    multi_watch(c, EPOLL_CTL_ADD);
+    return;
+  }
+
+  /* name lookup blocks, but only during connection attempts */
+  if(!(he = gethostbyname(c->host)))
+  {
+    multi_close(c, "host unknown");
+    return;
+  }
+  memcpy(&addr.sin_addr, he->h_addr, (size_t)he->h_length);
+  if(!connect(c->fd, (struct sockaddr *)&addr, sizeof(addr)))
+  {
+    c->state = MS_CONNECTING;
+    multi_watch(c, EPOLL_CTL_ADD);
+    if(c->fd != INVALID_SOCKET)
+      multi_request(c);
+  }
+  else if(errno == EINPROGRESS)
+  {
+    c->state = MS_CONNECTING;
+    multi_watch(c, EPOLL_CTL_ADD);
+  }
+  else
+    multi_close(c, strerror(errno));
+} /* multi_connect */
+
+
+/********************************************************************
+ * multi_flush: send pending data of a destination                  *
+*********************************************************************/
+static void multi_flush(struct multiconn *c)
+{
+  int r = 0;
+
+  if(c->outlen)
+  {
+    r = send(c->fd, c->out, (size_t)c->outlen, MSG_NOSIGNAL | MSG_DONTWAIT);
+    if(r < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+    {
+      multi_close(c, "connection to caster lost");
+      return;
+    }
+    if(r > 0)
+    {
+      memmove(c->out, c->out+r, (size_t)(c->outlen-r));
+      c->outlen -= r;
+      c->delay = 1;
+    }
+  }
+  if(!c->outlen && c->dropped)
+  {
+    fprintf(stderr, "WARNING: %s: caster too slow, %ld bytes skipped\n",
+    c->name, c->dropped);
+    c->dropped = 0;
+  }
+  if(c->watchout != (c->outlen > 0))
+    multi_watch(c, EPOLL_CTL_MOD);
+} /* multi_flush */
+
+
+/********************************************************************
+ * multi_send: queue data for a destination                         *
+*********************************************************************/
+static void multi_send(struct multiconn *c, const char *data, int size)
+{
+  char head[16];
+  int  nhead = 0, ntail = 0;
+
+  if(c->mode == HTTP)
+  {
+    nhead = snprintf(head, sizeof(head), "%x\r\n", size);
+    ntail = 2;
+  }
+  /* keep chunks complete, a chunk is either queued or skipped */
+  if(c->outlen + nhead + size + ntail > MULTI_OUTBUFSZ)
+  {
+    c->dropped += size;
+    return;
+  }
+  memcpy(c->out+c->outlen, head, (size_t)nhead);
+  memcpy(c->out+c->outlen+nhead, data, (size_t)size);
+  memcpy(c->out+c->outlen+nhead+size, "\r\n", (size_t)ntail);
+  c->outlen += nhead + size + ntail;
+  if(!c->watchout)
+    multi_flush(c);
+} /* multi_send */
+
+
+/********************************************************************
+ * multi_input: data of a source, fanned out to its destinations    *
+*********************************************************************/
+static void multi_input(struct multiconn *c, const char *data, int size)
+{
+  int src = c - multi;
+  int i;
+
+  c->activity = time(0);
+  c->delay = 1;
+  for(i = src+1; i < nmulti; ++i)
+  {
+    if(multi[i].src == src && multi[i].state == MS_STREAMING)
+      multi_send(multi+i, data, size);
+  }
+} /* multi_input */
+
+
+/********************************************************************
+ * multi_reply: check the caster's reply to the request             *
+*********************************************************************/
+static void multi_reply(struct multiconn *c)
+{
+  const char *end;
+  const char *ok;
+  int r;
+
+  r = recv(c->fd, c->reply+c->replylen, sizeof(c->reply)-1-c->replylen, 0);
+  if(r < 0 && (errno == EAGAIN || errno == EINTR))
+    return;
+  if(r <= 0)
+  {
+    multi_close(c, "connection closed by caster");
+    return;
+  }
+  c->replylen += r;
+  c->reply[c->replylen] = 0;
+
+  end = strstr(c->reply, c->mode == HTTP ? "\r\n\r\n" : "\r\n");
+  if(!end)
+  {
+    if(c->replylen == (int)sizeof(c->reply)-1)
+      multi_close(c, "invalid reply");
+    return;
+  }
+  ok = !c->isdest ? "ICY 200 OK" : c->mode == NTRIP1 ? "OK" : "HTTP/1.1 200 OK";
+  if(!strstr(c->reply, ok))
+  {
+    char *a;
+    fprintf(stderr, "ERROR: %s: reply is not OK: ", c->name);
+    for(a = c->reply; *a && *a != '\n' && *a != '\r'; ++a)
+    {
+      fprintf(stderr, "%.1s", isprint(*a) ? a : ".");
+    }
+    fprintf(stderr, "\n");
+    /* retrying soon does not help against bad logins */
+    if(strstr(c->reply, "ERROR - Bad Password")
+    || strstr(c->reply, "400 Bad Request")
+    || strstr(c->reply, "401 Unauthorized"))
+      c->delay = multi_delay_max;
+    multi_close(c, "request rejected");
+    return;
+  }
+  c->state = MS_STREAMING;
+  c->activity = time(0);
+  fprintf(stderr, "%s: connected\n", c->name);
+  if(!c->isdest)
+  {
+    /* stream data following the reply header */
+    end += 2;
+    if(end < c->reply+c->replylen)
+      multi_input(c, end, c->reply+c->replylen-end);
+  }
+} /* multi_reply */
+
+
+/********************************************************************
+ * multi_event: handle the epoll event of a connection              *
+*********************************************************************/
+static void multi_event(struct multiconn *c, uint32_t events)
+{
+  char buf[MULTI_READSZ];
+  int  r;
+
+  if(c->fd == INVALID_SOCKET) /* closed while handling this event batch */
+    return;
+  switch(c->state)
+  {
+  case MS_CONNECTING:
+    multi_request(c);
+    break;
+  case MS_REQUESTING:
+    multi_reply(c);
+    break;
+  case MS_STREAMING:
+    if(c->isdest && (events & EPOLLOUT))
+      multi_flush(c);
+    if(c->fd == INVALID_SOCKET || !(events & (EPOLLIN | EPOLLERR | EPOLLHUP)))
+      break;
+    /* source data, ignored caster replies of a destination */
+    r = read(c->fd, buf, sizeof(buf));
+    if(r > 0)
+    {
+      if(!c->isdest)
+        multi_input(c, buf, r);
+    }
+    else if(r == 0 && (c->isdest || c->mode != UDPSOCKET))
+      multi_close(c, "connection closed");
+    else if(r < 0 && ((errno != EAGAIN && errno != EINTR)
+    || (events & (EPOLLERR | EPOLLHUP))))
+      multi_close(c, "read error");
+    break;
+  case MS_IDLE:
+    break;
+  }
+} /* multi_event */
+
+
+/*
+* multi_server
+*
+* Main loop of the multi stream mode. Connects all sources and
+* destinations of the configuration file and forwards the data until
+* SIGINT is received.
+*
+* Parameters:
+*     configfile    : pointer to char : Name of the configuration file.
+*     reconnect_max : integer         : Maximum delay between reconnect
+*                                       attempts in seconds, 0 = default.
+*
+* Return Value:
+*     The function returns 0 after SIGINT, 1 in the event of an error.
+*/
+static int multi_server(const char *configfile, int reconnect_max)
+{
+  struct epoll_event events[MULTI_MAXEVENTS];
+  int i, n, rc = 0;
+
+  if(reconnect_max > 0)
+    multi_delay_max = reconnect_max;
+  if(!multi_config(configfile))
+    return 1;
+  if((multi_epoll = epoll_create(nmulti)) < 0)
+  {
+    perror("ERROR: epoll_create");
+    return 1;
+  }
+  /* every connection has its own timeout */
+  alarm(0);
+  fprintf(stderr, "multi stream mode: %d sources and destinations from %s\n",
+  nmulti, configfile);
+
+  while(!sigint_received)
+  {
+    time_t now = time(0);
+    int    timeout = -1;
+
+    /* connection attempts and timeouts */
+    for(i = 0; i < nmulti; ++i)
+    {
+      struct multiconn *c = multi+i;
+      time_t due;
+
+      if(c->state == MS_IDLE && c->retry <= now)
+        multi_connect(c);
+      else if(c->state != MS_IDLE && (!c->isdest || c->state != MS_STREAMING)
+      && now - c->activity >= ALARMTIME)
+        multi_close(c, c->state == MS_STREAMING ? "no data" : "timeout");
+
+      if(c->state == MS_IDLE)
+        due = c->retry;
+      else if(!c->isdest || c->state != MS_STREAMING)
+        due = c->activity + ALARMTIME;
+      else
+        continue;
+      due = due > now ? (due-now)*1000 : 0;
+      if(timeout < 0 || due < timeout)
+        timeout = (int)due;
+    }
+
+    n = epoll_wait(multi_epoll, events, MULTI_MAXEVENTS, timeout);
+    if(n < 0 && errno != EINTR)
+    {
+      perror("ERROR: epoll_wait");
+      rc = 1;
+      break;
+    }
+    for(i = 0; i < n; ++i)
+      multi_event(multi+events[i].data.u32, events[i].events);
+  }
+
+  for(i = 0; i < nmulti; ++i)
+  {
+    if(multi[i].fd != INVALID_SOCKET)
+      closesocket(multi[i].fd);
+    free(multi[i].out);
+  }
+  free(multi);
+  close(multi_epoll);
+  return rc;
+} /* multi_server */
+#endif /* __linux__ */
+
+
 /********************************************************************
  * openserial
  *
@@ -1926,7 +2611,11 @@ void usage(int rc, char *name)
   fprintf(stderr, "                         the program in a proxy server protected LAN, optional\n");
   fprintf(stderr, "    -R <maxDelay>        Reconnect mechanism with maximum delay between reconnect\n");
   fprintf(stderr, "                         attemts in seconds, default: no reconnect activated,\n");
-  fprintf(stderr, "                         optional\n\n");
+  fprintf(stderr, "                         optional\n");
+  fprintf(stderr, "    -C <ConfigFile>      Multi stream mode (Linux only), forward all sources\n");
+  fprintf(stderr, "                         to the destinations defined in the configuration\n");
+  fprintf(stderr, "                         file, input and output options are ignored, see\n");
+  fprintf(stderr, "                         README, optional\n\n");
   fprintf(stderr, "    -M <InputMode> Sets the input mode (1 = Serial Port, 2 = IP server,\n");
   fprintf(stderr, "       3 = File, 4 = SISNeT Data Server, 5 = UDP server, 6 = NTRIP Caster),\n");
   fprintf(stderr, "       mandatory\n\n");